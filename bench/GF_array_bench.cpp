@@ -0,0 +1,80 @@
+// Micro-benchmark: cost per element of the batched gf_array<p> kernels
+// against loops over GF<p>, for the SIMD level the build targets.
+//
+//   g++ -std=c++17 -O2 -mavx2 -I../lib/include/fun GF_array_bench.cpp
+//       -o GF_array_bench
+
+#include <GF_array.hpp>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+template <class _Fn> static double measure(std::size_t n, _Fn &&fn)
+{
+  auto t0 = std::chrono::steady_clock::now();
+  fn();
+  auto t1 = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(t1 - t0).count() / n;
+}
+
+template <std::uint64_t _p>
+static void run(const char *name, std::mt19937_64 &gen)
+{
+  typedef fun::GF<_p> F;
+  typedef typename F::value_type V;
+  const std::size_t n = 1 << 16, rounds = 64;
+  std::vector<F> x, y, z(n);
+  fun::gf_array<_p> a, b, c(n), v[3], w[3], r[3];
+  for (std::size_t k = 0; k != n; ++k) {
+    x.emplace_back(V(gen() % _p));
+    y.emplace_back(V(gen() % _p));
+    a.push_back(x.back());
+    b.push_back(y.back());
+    for (int j = 0; j != 3; ++j) {
+      v[j].push_back(F(V(gen() % _p)));
+      w[j].push_back(F(V(gen() % _p)));
+    }
+  }
+
+  const double t_mul = measure(n * rounds, [&]() {
+    for (std::size_t i = 0; i != rounds; ++i)
+      for (std::size_t k = 0; k != n; ++k)
+        z[k] = x[k] * y[k] + z[k];
+  });
+  const double t_fma = measure(n * rounds, [&]() {
+    for (std::size_t i = 0; i != rounds; ++i)
+      c.fma(a, b);
+  });
+  F s;
+  const double t_dot = measure(n * rounds, [&]() {
+    for (std::size_t i = 0; i != rounds; ++i)
+      for (std::size_t k = 0; k != n; ++k)
+        s += x[k] * y[k];
+  });
+  F u;
+  const double t_adot = measure(n * rounds, [&]() {
+    for (std::size_t i = 0; i != rounds; ++i)
+      u += dot(a, b);
+  });
+  const double t_cross = measure(n * rounds, [&]() {
+    for (std::size_t i = 0; i != rounds; ++i)
+      cross(v, w, r);
+  });
+  const bool ok = s == u && z[n - 1] == c[n - 1];
+  std::printf("%-10s fma %5.2f / %5.2f ns  dot %5.2f / %5.2f ns  "
+              "cross %5.2f ns%s\n",
+              name, t_mul, t_fma, t_dot, t_adot, t_cross,
+              ok ? "" : "  MISMATCH");
+}
+
+int main()
+{
+  std::printf("GF<p> loop / gf_array<p> per element\n");
+  std::mt19937_64 gen(2019);
+  run<1021>("p=1021", gen);
+  run<65521>("p=2^16-15", gen);
+  run<2147483647>("p=2^31-1", gen);
+  return 0;
+}
@@ -0,0 +1,88 @@
+// Micro-benchmark: cost per operation of GF<p> and GF_mont<p> across
+// modulus sizes, against a plain (a * b) % p on 128-bit intermediates.
+//
+//   g++ -std=c++17 -O2 -I../lib/include/fun GF_bench.cpp -o GF_bench
+
+#include <GF.hpp>
+#include <GF_mont.hpp>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+template <class _Fn> static double measure(std::size_t n, _Fn &&fn)
+{
+  auto t0 = std::chrono::steady_clock::now();
+  fn();
+  auto t1 = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(t1 - t0).count() / n;
+}
+
+/// ns per dot-product step (one multiplication and one addition) and
+/// per inversion
+template <class _F>
+static void run_field(const char *name, const std::vector<std::uint64_t> &a,
+                      const std::vector<std::uint64_t> &b, std::uint64_t &check)
+{
+  typedef typename _F::value_type _V;
+  std::vector<_F> x, y;
+  for (std::size_t k = 0; k != a.size(); ++k) {
+    x.emplace_back(_V(a[k]));
+    y.emplace_back(_V(b[k]));
+  }
+  _F s;
+  const double t_dot = measure(x.size(), [&]() {
+    for (std::size_t k = 0; k != x.size(); ++k)
+      s += x[k] * y[k];
+  });
+  const std::size_t m = x.size() / 16;
+  _F u;
+  const double t_inv = measure(m, [&]() {
+    for (std::size_t k = 0; k != m; ++k)
+      if (x[k] != _F())
+        u += inv(x[k]);
+  });
+  check = std::uint64_t(s.value());
+  std::printf("  %-8s dot %5.2f ns  inv %6.1f ns%s", name, t_dot, t_inv,
+              u == _F() ? " " : "");
+}
+
+template <std::uint64_t _p>
+static void run(const char *name, std::mt19937_64 &gen)
+{
+  const std::size_t n = 1 << 20;
+  std::vector<std::uint64_t> a(n), b(n);
+  for (std::size_t k = 0; k != n; ++k) {
+    a[k] = gen() % _p;
+    b[k] = gen() % _p;
+  }
+  std::printf("%-10s", name);
+  std::uint64_t s = 0;
+#ifdef FUN_HAS_INT128
+  const double t_ref = measure(n, [&]() {
+    for (std::size_t k = 0; k != n; ++k)
+      s = std::uint64_t((fun::uint128_t(a[k]) * b[k] + s) % _p);
+  });
+  std::printf("  %%128 dot %5.2f ns", t_ref);
+#endif
+  std::uint64_t c1, c2;
+  run_field<fun::GF<_p>>("GF", a, b, c1);
+  run_field<fun::GF_mont<_p>>("GF_mont", a, b, c2);
+  std::printf("%s\n", c1 == c2 && (s == 0 || s == c1) ? "" : "  MISMATCH");
+}
+
+int main()
+{
+  std::mt19937_64 gen(2019);
+  run<1021>("p=1021", gen);
+  run<65521>("p=2^16-15", gen);
+  run<2147483647>("p=2^31-1", gen);
+  run<4294967291ULL>("p=2^32-5", gen);
+#ifdef FUN_HAS_INT128
+  run<(1ULL << 61) - 1>("p=2^61-1", gen);
+  run<4611686018427387847ULL>("p=2^62-57", gen);
+  run<18446744073709551557ULL>("p=2^64-59", gen);
+#endif
+  return 0;
+}
@@ -0,0 +1,106 @@
+// Micro-benchmark: rank of random square matrices by the blocked
+// elimination engine against a textbook Gauss-Jordan, over GF(p) and over
+// GF(2) (M4RI against XOR of packed rows).
+//
+//   g++ -std=c++17 -O2 -pthread -I../lib/include/fun gauss_bench.cpp
+//       -o gauss_bench
+
+#include <GF.hpp>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <gauss.hpp>
+#include <random>
+#include <thread>
+
+template <class _Fn> static double measure(_Fn &&fn)
+{
+  auto t0 = std::chrono::steady_clock::now();
+  fn();
+  auto t1 = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>(t1 - t0).count();
+}
+
+/// Textbook Gauss-Jordan, one pivot at a time
+template <typename _K> static std::size_t naive_rank(fun::dense_matrix<_K> A)
+{
+  const std::size_t m = A.rows(), n = A.cols();
+  std::size_t r = 0;
+  for (std::size_t c = 0; c != n && r != m; ++c) {
+    std::size_t i = r;
+    while (i != m && A(i, c) == _K(0))
+      ++i;
+    if (i == m)
+      continue;
+    A.swap_rows(i, r);
+    const _K s = _K(1) / A(r, c);
+    for (std::size_t j = c; j != n; ++j)
+      A(r, j) *= s;
+    for (i = 0; i != m; ++i) {
+      const _K f = A(i, c);
+      if (i != r && f != _K(0))
+        for (std::size_t j = c; j != n; ++j)
+          A(i, j) -= f * A(r, j);
+    }
+    ++r;
+  }
+  return r;
+}
+
+static std::size_t naive_rank(fun::gf2_matrix A)
+{
+  const std::size_t m = A.rows(), n = A.cols();
+  std::size_t r = 0;
+  for (std::size_t c = 0; c != n && r != m; ++c) {
+    std::size_t i = r;
+    while (i != m && !A(i, c))
+      ++i;
+    if (i == m)
+      continue;
+    A.swap_rows(i, r);
+    for (i = 0; i != m; ++i)
+      if (i != r && A(i, c))
+        for (std::size_t v = c / 64; v != A.words(); ++v)
+          A.row(i)[v] ^= A.row(r)[v];
+    ++r;
+  }
+  return r;
+}
+
+int main()
+{
+  std::mt19937_64 gen(2019);
+  const unsigned threads = std::thread::hardware_concurrency();
+  {
+    typedef fun::GF<65521> F;
+    const std::size_t n = 800;
+    fun::dense_matrix<F> A(n, n);
+    for (std::size_t i = 0; i != n; ++i)
+      for (std::size_t j = 0; j != n; ++j)
+        A(i, j) = F(unsigned(gen() % 65521));
+    std::size_t r0 = 0, r1 = 0, r2 = 0;
+    const double t0 = measure([&]() { r0 = naive_rank(A); });
+    const double t1 = measure([&]() { r1 = fun::rank(A); });
+    const double t2 = measure([&]() { r2 = fun::rank(A, threads); });
+    std::printf("GF(65521) %zux%zu: naive %7.1f ms  blocked %7.1f ms  "
+                "%u threads %7.1f ms%s\n",
+                n, n, t0, t1, threads, t2,
+                r0 == r1 && r1 == r2 ? "" : "  MISMATCH");
+  }
+  {
+    const std::size_t n = 4096;
+    fun::gf2_matrix A(n, n);
+    for (std::size_t i = 0; i != n; ++i)
+      for (std::size_t v = 0; v != A.words(); ++v)
+        A.row(i)[v] = gen();
+    std::size_t r0 = 0, r1 = 0, r2 = 0;
+    const double t0 = measure([&]() { r0 = naive_rank(A); });
+    const double t1 = measure([&]() { r1 = fun::rank(A); });
+    const double t2 = measure([&]() { r2 = fun::rank(A, threads); });
+    std::printf("GF(2) %zux%zu: naive %7.1f ms  M4RI %7.1f ms  "
+                "%u threads %7.1f ms%s\n",
+                n, n, t0, t1, threads, t2,
+                r0 == r1 && r1 == r2 ? "" : "  MISMATCH");
+  }
+  return 0;
+}
@@ -0,0 +1,69 @@
+// Micro-benchmark: recursive Euclid gcd versus the gcd engine in gcd.hpp.
+//
+//   g++ -std=c++17 -O2 -I../lib/include/fun gcd_bench.cpp -o gcd_bench
+
+#include <gcd.hpp>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+/// The recursion formerly used by boost::gcd and fun::gcd
+template <typename _Z> _Z recursive_gcd(const _Z &a, const _Z &b)
+{
+  return b == _Z(0) ? (a < _Z(0) ? -a : a) : recursive_gcd(b, a % b);
+}
+
+template <typename _Z, class _Fn>
+static double measure(const std::vector<_Z> &a, const std::vector<_Z> &b,
+                      _Fn &&fn, std::uint64_t &check)
+{
+  auto t0 = std::chrono::steady_clock::now();
+  _Z s = 0;
+  for (std::size_t k = 0; k != a.size(); ++k)
+    s += fn(a[k], b[k]);
+  auto t1 = std::chrono::steady_clock::now();
+  check = static_cast<std::uint64_t>(s);
+  return std::chrono::duration<double, std::nano>(t1 - t0).count() / a.size();
+}
+
+template <typename _Z>
+static void run(const char *name, const std::vector<_Z> &a,
+                const std::vector<_Z> &b)
+{
+  std::uint64_t c1, c2;
+  double t1 = measure(a, b, [](const _Z &x, const _Z &y) {
+    return recursive_gcd(x, y); }, c1);
+  double t2 = measure(a, b, [](const _Z &x, const _Z &y) {
+    return fun::fast_gcd(x, y); }, c2);
+  std::printf("%-10s recursive %7.1f ns  engine %7.1f ns  speedup %.2fx%s\n",
+              name, t1, t2, t1 / t2, c1 == c2 ? "" : "  MISMATCH");
+}
+
+int main()
+{
+  const std::size_t n = 1 << 20;
+  std::mt19937_64 gen(2019);
+
+  std::vector<std::int32_t> a32(n), b32(n);
+  std::vector<std::int64_t> a64(n), b64(n);
+  for (std::size_t k = 0; k != n; ++k) {
+    a32[k] = std::int32_t(gen() >> 33);
+    b32[k] = std::int32_t(gen() >> 33);
+    a64[k] = std::int64_t(gen() >> 1);
+    b64[k] = std::int64_t(gen() >> 1);
+  }
+  run("int32", a32, b32);
+  run("int64", a64, b64);
+
+#ifdef FUN_HAS_INT128
+  std::vector<fun::int128_t> a128(n), b128(n);
+  for (std::size_t k = 0; k != n; ++k) {
+    a128[k] = fun::int128_t(gen() >> 1) << 63 | fun::int128_t(gen() >> 1);
+    b128[k] = fun::int128_t(gen() >> 1) << 63 | fun::int128_t(gen() >> 1);
+  }
+  run("int128", a128, b128);
+#endif
+  return 0;
+}
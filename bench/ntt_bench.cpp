@@ -0,0 +1,71 @@
+// Micro-benchmark: polynomial products over GF(998244353) by the NTT
+// against schoolbook, and multipoint evaluation against Horner's rule.
+//
+//   g++ -std=c++17 -O2 -I../lib/include/fun ntt_bench.cpp -o ntt_bench
+
+#include <GF.hpp>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <ntt.hpp>
+#include <random>
+#include <vector>
+
+template <class _Fn> static double measure(_Fn &&fn)
+{
+  auto t0 = std::chrono::steady_clock::now();
+  fn();
+  auto t1 = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>(t1 - t0).count();
+}
+
+constexpr std::uint64_t P = 998244353;
+typedef fun::GF<P> F;
+
+static std::vector<F> random_poly(std::size_t n, std::mt19937_64 &gen)
+{
+  std::vector<F> f;
+  for (std::size_t i = 0; i != n; ++i)
+    f.emplace_back(unsigned(gen() % P));
+  return f;
+}
+
+int main()
+{
+  std::mt19937_64 gen(2019);
+  typedef fun::detail::ntt_engine<P> E;
+  for (std::size_t n : {32U, 64U, 96U, 128U, 192U, 256U, 1024U, 4096U, 16384U}) {
+    const auto f = random_poly(n, gen), g = random_poly(n, gen);
+    const auto a = fun::detail::poly_words(f), b = fun::detail::poly_words(g);
+    const int reps = int(65536 / n);
+    std::vector<std::uint32_t> c0, c1;
+    const double t0 = measure([&]() {
+      for (int k = 0; k != reps; ++k)
+        c0 = E::schoolbook_mul(a, b);
+    });
+    const double t1 = measure([&]() {
+      for (int k = 0; k != reps; ++k)
+        c1 = E::multiply(a, b);
+    });
+    std::printf("product %6zu x %6zu: schoolbook %9.4f ms  ntt %9.4f ms%s\n",
+                n, n, t0 / reps, t1 / reps, c0 == c1 ? "" : "  MISMATCH");
+  }
+  {
+    const std::size_t n = 8192;
+    const auto f = random_poly(n, gen), x = random_poly(n, gen);
+    std::vector<F> y0(n), y1;
+    const double t0 = measure([&]() {
+      for (std::size_t i = 0; i != n; ++i) {
+        F s;
+        for (std::size_t j = n; j-- != 0;)
+          s = s * x[i] + f[j];
+        y0[i] = s;
+      }
+    });
+    const double t1 = measure([&]() { y1 = fun::multipoint_eval(f, x); });
+    std::printf("evaluate degree %zu at %zu points: Horner %7.1f ms  "
+                "tree %7.1f ms%s\n",
+                n - 1, n, t0, t1, y0 == y1 ? "" : "  MISMATCH");
+  }
+  return 0;
+}
@@ -0,0 +1,113 @@
+// Micro-benchmark: heap allocations and cost per element of copying, cross,
+// dot and incident of pg_point/pg_line (pg_point_new.hpp, inline vec<K, 3>
+// storage) against the same operations on std::valarray<K> coordinates.
+//
+//   g++ -std=c++17 -O2 -I../lib/include/fun pg_point_new_bench.cpp
+//       -o pg_point_new_bench
+
+#include <pg_point_new.hpp>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <vector>
+
+static std::size_t allocations = 0;
+
+void *operator new(std::size_t n)
+{
+  ++allocations;
+  if (void *p = std::malloc(n ? n : 1))
+    return p;
+  throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+
+/// Return the cost per element of fn() and its number of allocations
+template <class _Fn>
+static double measure(std::size_t n, std::size_t &count, _Fn &&fn)
+{
+  const std::size_t a0 = allocations;
+  auto t0 = std::chrono::steady_clock::now();
+  fn();
+  auto t1 = std::chrono::steady_clock::now();
+  count = allocations - a0;
+  return std::chrono::duration<double, std::nano>(t1 - t0).count() / n;
+}
+
+template <typename _K>
+static void run(const char *name, std::mt19937_64 &gen)
+{
+  typedef std::valarray<_K> V;
+  const std::size_t n = 1 << 20;
+  std::vector<fun::pg_point<_K>> p, q;
+  std::vector<fun::pg_line<_K>> l(n);
+  std::vector<V> vp, vq, vl(n);
+  for (std::size_t k = 0; k != n; ++k) {
+    p.emplace_back(_K(gen() % 1000), _K(gen() % 1000), _K(gen() % 1000));
+    q.emplace_back(_K(gen() % 1000), _K(gen() % 1000), _K(gen() % 1000));
+    vp.push_back(V{p[k][0], p[k][1], p[k][2]});
+    vq.push_back(V{q[k][0], q[k][1], q[k][2]});
+  }
+
+  std::size_t a_copy, a_vcopy, a_cross, a_vcross, a_dot, a_vdot, a_inc,
+      a_vinc;
+  const double t_copy = measure(n, a_copy, [&]() {
+    std::vector<fun::pg_point<_K>> r(p);
+    std::swap(r, q);
+    std::swap(r, q);
+  });
+  const double t_vcopy = measure(n, a_vcopy, [&]() {
+    std::vector<V> r(vp);
+    std::swap(r, vq);
+    std::swap(r, vq);
+  });
+  const double t_cross = measure(n, a_cross, [&]() {
+    for (std::size_t k = 0; k != n; ++k)
+      l[k] = fun::pg_line<_K>(p[k], q[k]);
+  });
+  const double t_vcross = measure(n, a_vcross, [&]() {
+    for (std::size_t k = 0; k != n; ++k)
+      vl[k] = fun::cross(vp[k], vq[k]);
+  });
+  _K s = _K(0), vs = _K(0);
+  const double t_dot = measure(n, a_dot, [&]() {
+    for (std::size_t k = 0; k != n; ++k)
+      s += dot(q[k], l[(k + 1) % n]);
+  });
+  const double t_vdot = measure(n, a_vdot, [&]() {
+    for (std::size_t k = 0; k != n; ++k)
+      vs += (vq[k] * vl[(k + 1) % n]).sum(); // the former valarray dot
+  });
+  std::size_t c = 0, vc = 0;
+  const double t_inc = measure(n, a_inc, [&]() {
+    for (std::size_t k = 0; k != n; ++k)
+      c += incident(p[k], l[k]);
+  });
+  const double t_vinc = measure(n, a_vinc, [&]() {
+    for (std::size_t k = 0; k != n; ++k)
+      vc += (vp[k] * vl[k]).sum() == _K(0);
+  });
+  const bool ok = s == vs && c == n && vc == n;
+  std::printf("%-7s copy %6.2f ns %zu / %6.2f ns %zu\n"
+              "        cross %6.2f ns %zu / %6.2f ns %zu\n"
+              "        dot %6.2f ns %zu / %6.2f ns %zu\n"
+              "        incident %6.2f ns %zu / %6.2f ns %zu%s\n",
+              name, t_copy, a_copy, t_vcopy, a_vcopy, t_cross, a_cross,
+              t_vcross, a_vcross, t_dot, a_dot, t_vdot, a_vdot, t_inc, a_inc,
+              t_vinc, a_vinc, ok ? "" : "  MISMATCH");
+}
+
+int main()
+{
+  std::printf("pg_point/pg_line / std::valarray: time per element and "
+              "heap allocations\n");
+  std::mt19937_64 gen(2019);
+  run<int>("int", gen);
+  run<double>("double", gen);
+  return 0;
+}
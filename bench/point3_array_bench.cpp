@@ -0,0 +1,72 @@
+// Micro-benchmark: cost per element of the batched join and dot of
+// point3_array<K> / line3_array<K> against loops over point3<K> and
+// line3<K> in an array of structures, for the SIMD level the build targets.
+//
+//   g++ -std=c++17 -O2 -mavx2 -I../lib/include/fun point3_array_bench.cpp
+//       -o point3_array_bench
+
+#include <point3_array.hpp>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+template <class _Fn> static double measure(std::size_t n, _Fn &&fn)
+{
+  auto t0 = std::chrono::steady_clock::now();
+  fn();
+  auto t1 = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(t1 - t0).count() / n;
+}
+
+template <typename _K>
+static void run(const char *name, std::mt19937_64 &gen)
+{
+  const std::size_t n = 1 << 16, rounds = 64;
+  std::vector<fun::point3<_K>> p, q;
+  std::vector<fun::line3<_K>> l(n);
+  std::vector<_K> d(n);
+  fun::point3_array<_K> a, b;
+  for (std::size_t k = 0; k != n; ++k) {
+    p.emplace_back(_K(gen() % 1000), _K(gen() % 1000), _K(gen() % 1000));
+    q.emplace_back(_K(gen() % 1000), _K(gen() % 1000), _K(gen() % 1000));
+    a.push_back(p.back());
+    b.push_back(q.back());
+  }
+
+  const double t_join = measure(n * rounds, [&]() {
+    for (std::size_t i = 0; i != rounds; ++i)
+      for (std::size_t k = 0; k != n; ++k)
+        l[k] = join(p[k], q[k]);
+  });
+  fun::line3_array<_K> m;
+  const double t_ajoin = measure(n * rounds, [&]() {
+    for (std::size_t i = 0; i != rounds; ++i)
+      join(a, b, m);
+  });
+  const double t_dot = measure(n * rounds, [&]() {
+    for (std::size_t i = 0; i != rounds; ++i)
+      for (std::size_t k = 0; k != n; ++k)
+        d[k] = dot(p[k], l[k]);
+  });
+  fun::aligned_vector<_K> e;
+  const double t_adot = measure(n * rounds, [&]() {
+    for (std::size_t i = 0; i != rounds; ++i)
+      dot(a, m, e);
+  });
+  const bool ok = m[n - 1] == l[n - 1] && e[n - 1] == d[n - 1];
+  std::printf("%-8s join %5.2f / %5.2f ns  dot %5.2f / %5.2f ns%s\n", name,
+              t_join, t_ajoin, t_dot, t_adot, ok ? "" : "  MISMATCH");
+}
+
+int main()
+{
+  std::printf("point3<K> loop / point3_array<K> per element\n");
+  std::mt19937_64 gen(2019);
+  run<float>("float", gen);
+  run<double>("double", gen);
+  run<std::int32_t>("int32", gen);
+  run<std::int64_t>("int64", gen);
+  return 0;
+}
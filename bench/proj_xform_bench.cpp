@@ -0,0 +1,84 @@
+// Micro-benchmark: cost per point of mapping affine points by a homography:
+// a loop over point2d<K> (array of structures, H * (x, y, 1) then two
+// divisions) against transform() on point2d_array<K> (structure of arrays,
+// SIMD, fused reciprocal), and a chain of three transforms applied in turn
+// against the chain composed once.
+//
+//   g++ -std=c++17 -O2 -mavx2 -I../lib/include/fun proj_xform_bench.cpp
+//       -o proj_xform_bench
+
+#include <proj_xform.hpp>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+template <class _Fn> static double measure(std::size_t n, _Fn &&fn)
+{
+  auto t0 = std::chrono::steady_clock::now();
+  fn();
+  auto t1 = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(t1 - t0).count() / n;
+}
+
+template <typename _K>
+static void run(const char *name, std::mt19937_64 &gen)
+{
+  const std::size_t n = 1 << 20, rounds = 16;
+  const fun::matrix3d<_K> H1(_K(2), _K(1), _K(-3), _K(0.5), _K(3), _K(1),
+                             _K(0.001), _K(-0.002), _K(1));
+  const fun::matrix3d<_K> H2(_K(1), _K(0.2), _K(5), _K(-0.1), _K(1), _K(2),
+                             _K(0), _K(0), _K(1));
+  const fun::matrix3d<_K> H3(_K(0.9), _K(0), _K(0), _K(0), _K(1.1), _K(0),
+                             _K(0.0001), _K(0.0002), _K(1));
+  std::vector<fun::point2d<_K>> p, q(n);
+  for (std::size_t k = 0; k != n; ++k)
+    p.emplace_back(_K(gen() % 1000) / _K(20), _K(gen() % 1000) / _K(20));
+  const fun::point2d_array<_K> a(p.begin(), p.end());
+  fun::point2d_array<_K> b(n), c(n);
+
+  const double t_aos = measure(n * rounds, [&]() {
+    for (std::size_t i = 0; i != rounds; ++i)
+      for (std::size_t k = 0; k != n; ++k) {
+        const fun::vector3d<_K> v =
+            H1 * fun::vector3d<_K>(p[k].x(), p[k].y(), _K(1));
+        q[k] = fun::point2d<_K>(v.e1() / v.e3(), v.e2() / v.e3());
+      }
+  });
+  const double t_soa = measure(n * rounds, [&]() {
+    for (std::size_t i = 0; i != rounds; ++i)
+      transform(H1, a, b);
+  });
+  const double t_turn = measure(n * rounds, [&]() {
+    for (std::size_t i = 0; i != rounds; ++i) {
+      transform(H1, a, c);
+      transform(H2, c, c);
+      transform(H3, c, c);
+    }
+  });
+  const double t_comp = measure(n * rounds, [&]() {
+    for (std::size_t i = 0; i != rounds; ++i)
+      transform(fun::compose(H1, H2, H3), a, b);
+  });
+
+  const _K eps = _K(1e-3);
+  bool ok = true;
+  for (std::size_t k = 0; k < n; k += 4099)
+    ok = ok && std::abs(b[k].x() - c[k].x()) <= eps * (1 + std::abs(c[k].x()))
+         && std::abs(b[k].y() - c[k].y()) <= eps * (1 + std::abs(c[k].y()));
+  ok = ok && std::abs(q[n - 1].x() - fun::transform(H1, p[n - 1]).x()) <=
+                 eps * (1 + std::abs(q[n - 1].x()));
+  std::printf("%-7s AoS %5.2f / SoA %5.2f ns   3 in turn %5.2f / "
+              "composed %5.2f ns%s\n",
+              name, t_aos, t_soa, t_turn, t_comp, ok ? "" : "  MISMATCH");
+}
+
+int main()
+{
+  std::printf("point2d<K> loop / point2d_array<K> per point\n");
+  std::mt19937_64 gen(2019);
+  run<float>("float", gen);
+  run<double>("double", gen);
+  return 0;
+}
@@ -0,0 +1,68 @@
+// Micro-benchmark: iostream operators versus to_chars/from_chars columns.
+//
+//   g++ -std=c++17 -O2 -I../lib/include/fun rational_io_bench.cpp -o riob
+
+#include <rat.hpp>
+#include <rational_io.hpp>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+typedef boost::rat<std::int64_t> Rat;
+
+template <class _Fn> static double measure(_Fn &&fn, std::size_t n)
+{
+  auto t0 = std::chrono::steady_clock::now();
+  fn();
+  auto t1 = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(t1 - t0).count() / n;
+}
+
+int main()
+{
+  const std::size_t n = 1 << 20;
+  std::mt19937_64 gen(2019);
+  std::vector<Rat> v;
+  v.reserve(n);
+  for (std::size_t k = 0; k != n; ++k)
+    v.emplace_back(std::int64_t(gen() >> 24), std::int64_t(gen() >> 40) + 1);
+
+  std::string s1, s2;
+  double w1 = measure([&] {
+    std::ostringstream os;
+    for (const auto &r : v)
+      os << r << '\n';
+    s1 = os.str();
+  }, n);
+  double w2 = measure([&] {
+    fun::write_column(s2, v.data(), v.data() + v.size());
+  }, n);
+  std::printf("write  ostream %7.1f ns  to_chars %7.1f ns  speedup %.2fx%s\n",
+              w1, w2, w1 / w2, s1 == s2 ? "" : "  MISMATCH");
+
+  // "n/d" is the format that both operator>> and from_chars accept
+  std::ostringstream os;
+  for (const auto &r : v)
+    os << r.num() << '/' << r.denom() << '\n';
+  const std::string s3 = os.str();
+
+  std::vector<Rat> u1, u2;
+  u1.reserve(n);
+  u2.reserve(n);
+  double r1 = measure([&] {
+    std::istringstream is(s3);
+    Rat r;
+    while (is >> r)
+      u1.push_back(r);
+  }, n);
+  double r2 = measure([&] {
+    fun::read_column(s3.data(), s3.data() + s3.size(), u2);
+  }, n);
+  std::printf("read   istream %7.1f ns  from_chars %5.1f ns  speedup %.2fx%s\n",
+              r1, r2, r1 / r2, u1 == u2 ? "" : "  MISMATCH");
+  return 0;
+}
@@ -11,6 +11,11 @@
 
 #include <boost/operators.hpp>
 #include <cassert>
+#include <cstdint>     // for std::uint16_t, std::uint64_t
+#include <type_traits> // for std::conditional
+
+#include "GF_mont.hpp"   // for detail::montgomery
+#include "GF_traits.hpp" // for gf_traits
 
 namespace fun {
 /**
@@ -18,23 +23,72 @@ namespace fun {
  * @ingroup arithmetic
  *
  * Classes and functions for (extended) finite field.
+ * See also GF_mont<p> (GF_mont.hpp), which keeps the elements in
+ * Montgomery form so that products need no division.
  * @{
  */
 
 // Forward declarations.
-template <unsigned int _p> struct GF;
+template <std::uint64_t _p> struct GF;
+
+namespace detail {
+
+/**
+ *  Log/antilog tables of GF(p), built at compile time: exp[i] = g^i for
+ *  0 <= i < 2(p-1), so that exp[log[a] + log[b]] needs no reduction.
+ */
+template <std::uint64_t _p> struct gf_table {
+  std::uint16_t log[_p];
+  std::uint16_t exp[2 * _p];
+  std::uint16_t inv[_p];
+
+  constexpr gf_table() : log{}, exp{}, inv{} {
+    const unsigned int g = gf_traits<_p>::primitive_root;
+    unsigned int x = 1;
+    for (unsigned int i = 0; i + 1 < _p; ++i) {
+      exp[i] = exp[i + _p - 1] = static_cast<std::uint16_t>(x);
+      log[x] = static_cast<std::uint16_t>(i);
+      x = x * g % _p;
+    }
+    for (unsigned int a = 1; a < _p; ++a)
+      inv[a] = exp[(_p - 1 - log[a]) % (_p - 1)];
+  }
+
+  static const gf_table &get() noexcept {
+    static constexpr gf_table t{};
+    return t;
+  }
+};
+
+} // namespace detail
 
 /**
  *  finite (Galois) field.
  *
- *  @param  p  Prime number
+ *  Elements are stored in 32 bits for p < 2^32 and in 64 bits otherwise.
+ *  Products of a large p are reduced by two Montgomery REDC's on 128-bit
+ *  intermediates instead of a 128-bit division.
+ *
+ *  @param  p  Prime number (< 2^64; > 2^32 requires 128-bit integers)
  */
-template <unsigned int _p = 3> struct GF : boost::field_operators<GF<_p>> {
+template <std::uint64_t _p = 3> struct GF : boost::field_operators<GF<_p>> {
+  static_assert(gf_traits<_p>::is_prime, "GF<p> requires a prime p");
+
+  /// Compile-time metadata of the field (primitive root, constants)
+  typedef gf_traits<_p> traits;
+
+  /// Multiply, invert and raise to a power by log/antilog tables.
+  static constexpr bool table_mode = traits::table_mode;
+
+  /// Value typedef (unsigned int for p < 2^32).
+  typedef typename std::conditional<(_p >> 32) == 0, unsigned int,
+                                    std::uint64_t>::type value_type;
+
   /// Default constructor.
   constexpr GF() noexcept : _m(0) {}
 
   ///  Unspecified parameters default to 0.
-  explicit GF(unsigned int m) noexcept : _m(m) { assert(_m < _p); }
+  explicit GF(value_type m) noexcept : _m(m) { assert(_m < _p); }
 
   // Lets the compiler synthesize the copy constructor
   // GF (const GF<_p>&);
@@ -42,7 +96,7 @@ template <unsigned int _p = 3> struct GF : boost::field_operators<GF<_p>> {
   GF(const GF<_p> &s) noexcept : _m(s.value()) { assert(_m >= 0); }
 
   /// Return internal element of finite field.
-  constexpr unsigned int value() const noexcept { return _m; }
+  constexpr value_type value() const noexcept { return _m; }
 
   // Lets the compiler synthesize the assignment operator
   // GF<_p>& operator= (const GF<_p>&);
@@ -54,77 +108,139 @@ template <unsigned int _p = 3> struct GF : boost::field_operators<GF<_p>> {
 
   /// Add @a s to this finite field.
   GF<_p> &operator+=(const GF<_p> &s) {
-    _m += s.value();
-    _m %= _p;
+    const value_type t = value_type(_p - s.value());
+    _m = _m >= t ? _m - t : _m + s.value(); // no division, no overflow
     assert(_m < _p);
     return *this;
   }
 
   /// Subtract @a s from this finite field.
   GF<_p> &operator-=(const GF<_p> &s) {
-    _m += _p - s.value();
-    _m = _m % _p;
+    _m = _m >= s.value() ? value_type(_m - s.value())
+                         : value_type(_m + (_p - s.value()));
     assert(_m < _p);
     return *this;
   }
 
   /// Multiply @a s to this finite field.
   GF<_p> &operator*=(const GF<_p> &s) {
-    _m *= s.value();
-    _m %= _p;
+    if constexpr (table_mode) {
+      const auto &t = detail::gf_table<_p>::get();
+      _m = _m == 0 || s.value() == 0 ? 0 : t.exp[t.log[_m] + t.log[s.value()]];
+    } else if constexpr ((_p >> 32) == 0) {
+      _m = static_cast<value_type>(static_cast<std::uint64_t>(_m) *
+                                   s.value() % _p);
+    } else {
+      static_assert(_p % 2 == 1, "GF<p> requires a prime p");
+      _m = detail::montgomery<_p>::mul_mod(_m, s.value());
+    }
     assert(_m < _p);
     return *this;
   }
 
+  /// Divide this finite field by @a s (!= 0).
+  GF<_p> &operator/=(const GF<_p> &s) { return *this *= inv(s); }
+
 private:
-  unsigned int _m;
+  value_type _m;
 };
 
 // Operators:
 ///  Return new finite field @a r plus @a s.
-template <unsigned int _p> inline GF<_p> operator+(GF<_p> r, const GF<_p> &s) {
+template <std::uint64_t _p> inline GF<_p> operator+(GF<_p> r, const GF<_p> &s) {
   return r += s;
 }
 
 ///  Return new finite field @a r minus @a s.
-template <unsigned int _p> inline GF<_p> operator-(GF<_p> r, const GF<_p> &s) {
+template <std::uint64_t _p> inline GF<_p> operator-(GF<_p> r, const GF<_p> &s) {
   return r -= s;
 }
 
 //@{
 ///  Return new finite field @a r times @a a.
-template <unsigned int _p> inline GF<_p> operator*(GF<_p> r, const GF<_p> &s) {
+template <std::uint64_t _p> inline GF<_p> operator*(GF<_p> r, const GF<_p> &s) {
   return r *= s;
 }
 //@}
 
 /// Return @a r.
-template <unsigned int _p>
+template <std::uint64_t _p>
 inline constexpr GF<_p> operator+(const GF<_p> &r) noexcept {
   return r;
 }
 
 /// Return negation of @a r
-template <unsigned int _p> inline GF<_p> operator-(const GF<_p> &r) {
+template <std::uint64_t _p> inline GF<_p> operator-(const GF<_p> &r) {
   if (r.value() == 0)
     return r;
-  return GF<_p>(_p - r.value());
+  return GF<_p>(typename GF<_p>::value_type(_p - r.value()));
 }
 
 /// Return true if @a r is equal to @a s.
-template <unsigned int _p>
+template <std::uint64_t _p>
 inline constexpr bool operator==(const GF<_p> &r, const GF<_p> &s) noexcept {
   return r.value() == s.value();
 }
 
 /// Return false if @a r is equal to @a s.
-template <unsigned int _p>
+template <std::uint64_t _p>
 inline constexpr bool operator!=(const GF<_p> &r, const GF<_p> &s) noexcept {
   return !(r == s);
 }
 
+/**
+ *  Return the multiplicative inverse of @a r (!= 0): a table lookup for
+ *  small p, the extended Euclidean algorithm otherwise.
+ */
+template <std::uint64_t _p> inline GF<_p> inv(const GF<_p> &r) {
+  assert(r.value() != 0);
+  if constexpr (GF<_p>::table_mode) {
+    return GF<_p>(detail::gf_table<_p>::get().inv[r.value()]);
+  } else {
+    typedef typename GF<_p>::value_type _V;
+    // The Bezout coefficients are computed mod 2^64; the final one has
+    // |t| <= p / 2 < 2^63, so that its sign is recovered exactly.
+    std::uint64_t t = 0, nt = 1;
+    std::uint64_t a = _p, b = r.value();
+    while (b != 0) {
+      const std::uint64_t q = a / b;
+      const std::uint64_t t2 = t - q * nt;
+      t = nt;
+      nt = t2;
+      const std::uint64_t b2 = a - q * b;
+      a = b;
+      b = b2;
+    }
+    return GF<_p>(_V((t >> 63) != 0 ? t + _p : t));
+  }
+}
+
+/**
+ *  Return @a r raised to the power @a n (a negative @a n inverts @a r
+ *  first; 0^0 == 1).
+ */
+template <std::uint64_t _p> inline GF<_p> pow(const GF<_p> &r, long long n) {
+  if (n < 0)
+    return pow(inv(r), -(n + 1)) * inv(r); // -n may overflow
+  typedef typename GF<_p>::value_type _V;
+  if (r.value() == 0)
+    return GF<_p>(_V(n == 0 ? 1 % _p : 0));
+  if constexpr (GF<_p>::table_mode) {
+    const auto &t = detail::gf_table<_p>::get();
+    const unsigned long long e = t.log[r.value()] * (n % (_p - 1));
+    return GF<_p>(t.exp[e % (_p - 1)]);
+  } else {
+    GF<_p> x(r), y(_V(1));
+    for (auto e = static_cast<std::uint64_t>(n) % (_p - 1); e != 0;
+         e >>= 1, x *= x)
+      if (e & 1)
+        y *= x;
+    return y;
+  }
+}
+
 ///  Insertion operator for finite field values.
-template <unsigned int _p, class _Stream>
+template <std::uint64_t _p, class _Stream>
 _Stream &operator<<(_Stream &os, const GF<_p> &r) {
   os << '(' << r.value() << " mod " << _p << ')';
   return os;
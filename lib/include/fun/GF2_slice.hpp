@@ -0,0 +1,222 @@
+// The template and inlines for the -*- C++ -*- bit-sliced GF(2) vectors.
+// Initially implemented by Wai-Shing Luk <luk036@gmail.com>
+//
+
+/** @file include/GF2_slice.hpp
+ *  This is a C++ Library header.
+ */
+
+#ifndef FUN_GF2_SLICE_HPP
+#define FUN_GF2_SLICE_HPP 1
+
+#include <cassert>
+#include <cstddef> // for std::size_t
+#include <cstdint> // for std::uint64_t
+
+#include "GF.hpp"
+#include "gcd.hpp" // for detail::popcount64
+#include "vector3.hpp"
+
+namespace fun {
+/**
+ * @addtogroup GF
+ * @{
+ */
+
+/**
+ *  64 vectors of GF(2)^N, bit-sliced: bit i of the word w[j] is the j-th
+ *  coordinate of the vector in lane i.
+ *
+ *  Addition is an XOR and multiplication an AND of whole words, so that
+ *  dot and cross products are computed for 64 vectors at once; predicates
+ *  return a 64-bit lane mask, to be combined with &, | and ~ and counted
+ *  with count(). Since the only nonzero scalar of GF(2) is 1, the points
+ *  of PG(N-1, 2) are exactly the nonzero vectors and equality of vectors
+ *  is equality of points.
+ *
+ *  @param  N  Number of coordinates (3 for the plane PG(2, 2))
+ */
+template <std::size_t _N = 3> struct gf2_slice {
+  static_assert(_N > 0 && _N <= 32, "gf2_slice<N> requires 0 < N <= 32");
+
+  /// Lane masks
+  typedef std::uint64_t mask_type;
+
+  /// Coordinate words.
+  mask_type w[_N];
+
+  /// Default constructor (all lanes zero).
+  constexpr gf2_slice() noexcept : w{} {}
+
+  /// Return the vector @a v (bit j = coordinate j) in all 64 lanes.
+  static constexpr gf2_slice broadcast(std::uint32_t v) noexcept {
+    gf2_slice s;
+    for (std::size_t j = 0; j != _N; ++j)
+      s.w[j] = ((v >> j) & 1U) != 0 ? ~mask_type(0) : mask_type(0);
+    return s;
+  }
+
+  /**
+   *  Return all points of PG(N-1, 2): lane i holds the vector i + 1, for
+   *  i < 2^N - 1 (N <= 6); the other lanes are zero. See points_mask().
+   */
+  static constexpr gf2_slice all_points() noexcept {
+    static_assert(_N <= 6, "PG(N-1, 2) has more than 64 points");
+    gf2_slice s;
+    for (std::uint32_t i = 0; i + 1 < (1U << _N); ++i)
+      s.set(i, i + 1);
+    return s;
+  }
+
+  /// Return the mask of the lanes used by all_points().
+  static constexpr mask_type points_mask() noexcept {
+    static_assert(_N <= 6, "PG(N-1, 2) has more than 64 points");
+    return (mask_type(1) << ((1U << _N) - 1)) - 1; // 2^N - 1 < 64
+  }
+
+  /// Return the vector in lane @a i (bit j = coordinate j).
+  constexpr std::uint32_t get(unsigned i) const noexcept {
+    assert(i < 64);
+    std::uint32_t v = 0;
+    for (std::size_t j = 0; j != _N; ++j)
+      v |= std::uint32_t((w[j] >> i) & 1U) << j;
+    return v;
+  }
+
+  /// Store the vector @a v (bit j = coordinate j) into lane @a i.
+  constexpr void set(unsigned i, std::uint32_t v) noexcept {
+    assert(i < 64);
+    for (std::size_t j = 0; j != _N; ++j)
+      w[j] = (w[j] & ~(mask_type(1) << i)) | (mask_type((v >> j) & 1U) << i);
+  }
+
+  /// Add @a s to this vector lane-wise.
+  constexpr gf2_slice &operator+=(const gf2_slice &s) noexcept {
+    for (std::size_t j = 0; j != _N; ++j)
+      w[j] ^= s.w[j];
+    return *this;
+  }
+
+  /// Subtract @a s from this vector lane-wise (same as addition).
+  constexpr gf2_slice &operator-=(const gf2_slice &s) noexcept {
+    return *this += s;
+  }
+
+  /// Keep the lanes of @a m and clear the others.
+  constexpr gf2_slice &operator&=(mask_type m) noexcept {
+    for (std::size_t j = 0; j != _N; ++j)
+      w[j] &= m;
+    return *this;
+  }
+};
+
+///  Return new vectors @a r plus @a s (lane-wise).
+template <std::size_t _N>
+inline constexpr gf2_slice<_N> operator+(gf2_slice<_N> r,
+                                         const gf2_slice<_N> &s) noexcept {
+  return r += s;
+}
+
+///  Return new vectors @a r minus @a s (lane-wise).
+template <std::size_t _N>
+inline constexpr gf2_slice<_N> operator-(gf2_slice<_N> r,
+                                         const gf2_slice<_N> &s) noexcept {
+  return r -= s;
+}
+
+///  Return the mask of the lanes where @a r and @a s are equal.
+template <std::size_t _N>
+inline constexpr std::uint64_t equal(const gf2_slice<_N> &r,
+                                     const gf2_slice<_N> &s) noexcept {
+  std::uint64_t d = 0;
+  for (std::size_t j = 0; j != _N; ++j)
+    d |= r.w[j] ^ s.w[j];
+  return ~d;
+}
+
+///  Return the mask of the lanes where @a r is nonzero (a point).
+template <std::size_t _N>
+inline constexpr std::uint64_t nonzero(const gf2_slice<_N> &r) noexcept {
+  std::uint64_t d = 0;
+  for (std::size_t j = 0; j != _N; ++j)
+    d |= r.w[j];
+  return d;
+}
+
+///  Return the lane-wise dot products of @a v and @a w (as a mask).
+template <std::size_t _N>
+inline constexpr std::uint64_t dot(const gf2_slice<_N> &v,
+                                   const gf2_slice<_N> &w) noexcept {
+  std::uint64_t d = 0;
+  for (std::size_t j = 0; j != _N; ++j)
+    d ^= v.w[j] & w.w[j];
+  return d;
+}
+
+///  Return the mask of the lanes where the point @a p is incident with the
+///  hyperplane (line for N = 3) @a l.
+template <std::size_t _N>
+inline constexpr std::uint64_t incident(const gf2_slice<_N> &p,
+                                        const gf2_slice<_N> &l) noexcept {
+  return ~dot(p, l);
+}
+
+///  Return new vectors @a v x @a w (lane-wise cross product; join or meet).
+inline constexpr gf2_slice<3> cross(const gf2_slice<3> &v,
+                                    const gf2_slice<3> &w) noexcept {
+  gf2_slice<3> r;
+  r.w[0] = (v.w[1] & w.w[2]) ^ (v.w[2] & w.w[1]);
+  r.w[1] = (v.w[2] & w.w[0]) ^ (v.w[0] & w.w[2]);
+  r.w[2] = (v.w[0] & w.w[1]) ^ (v.w[1] & w.w[0]);
+  return r;
+}
+
+///  Return the lane-wise determinants of @a p, @a q and @a r (as a mask);
+///  a zero bit means that the three points are collinear.
+inline constexpr std::uint64_t det(const gf2_slice<3> &p, const gf2_slice<3> &q,
+                                   const gf2_slice<3> &r) noexcept {
+  return dot(p, cross(q, r));
+}
+
+///  Return the number of lanes in the mask @a m.
+inline constexpr int count(std::uint64_t m) noexcept {
+  return detail::popcount64(m);
+}
+
+///  Return the vector @a v packed into bits (bit j = coordinate j).
+inline constexpr std::uint32_t pack(const vector3<GF<2>> &v) noexcept {
+  return v.e1().value() | (v.e2().value() << 1) | (v.e3().value() << 2);
+}
+
+///  Return the vector packed by pack().
+inline vector3<GF<2>> unpack(std::uint32_t v) {
+  return vector3<GF<2>>(GF<2>(v & 1U), GF<2>((v >> 1) & 1U),
+                        GF<2>((v >> 2) & 1U));
+}
+
+/**
+ *  Load up to 64 vectors of [@a first, @a last) (e.g. point3<GF<2>>) into
+ *  the lanes 0, 1, ... of a new slice; the remaining lanes are zero.
+ */
+template <class _InputIterator>
+inline gf2_slice<3> make_slice(_InputIterator first, _InputIterator last) {
+  gf2_slice<3> s;
+  for (unsigned i = 0; first != last; ++first, ++i) {
+    assert(i < 64);
+    const std::uint64_t v = pack(*first);
+    s.w[0] |= (v & 1U) << i;
+    s.w[1] |= ((v >> 1) & 1U) << i;
+    s.w[2] |= ((v >> 2) & 1U) << i;
+  }
+  return s;
+}
+
+///  Return the vector in lane @a i of @a s.
+inline vector3<GF<2>> lane(const gf2_slice<3> &s, unsigned i) {
+  return unpack(s.get(i));
+}
+
+/** @} */
+} // namespace fun
+
+#endif
@@ -0,0 +1,476 @@
+// The template and inlines for the -*- C++ -*- finite field arrays.
+// Initially implemented by Wai-Shing Luk <luk036@gmail.com>
+//
+
+/** @file include/GF_array.hpp
+ *  This is a C++ Library header.
+ */
+
+#ifndef FUN_GF_ARRAY_HPP
+#define FUN_GF_ARRAY_HPP 1
+
+#include <boost/operators.hpp>
+#include <cassert>
+#include <cstddef> // for std::size_t
+#include <cstdint> // for std::uint32_t
+#include <type_traits> // for std::is_same
+#include <utility> // for std::move
+#include <vector>
+
+#include "GF.hpp"
+#include "GF_mont.hpp" // for detail::montgomery
+
+#if defined(__AVX2__) || defined(__SSE4_1__)
+#include <immintrin.h>
+#define FUN_GF_SIMD 1
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define FUN_GF_SIMD 1
+#endif
+
+namespace fun {
+/**
+ * @addtogroup GF
+ * @{
+ */
+
+namespace detail {
+
+/**
+ *  Scalar kernel of GF(p), p odd and < 2^31: the same operations as the
+ *  SIMD kernels below, on a single lane.
+ *
+ *  The SIMD kernels multiply in Montgomery form: mont_mul(a, b) returns
+ *  a * b / R mod p (R = 2^32), so that a product costs two of them (the
+ *  second one by R^2 mod p), while sums of products, as in dot and cross
+ *  products, need a single final multiplication by R^2. The scalar
+ *  kernel takes R = 1 instead: its mont_mul is the product mod the
+ *  constant @a _p, which the compiler turns into multiplications, and
+ *  the modulus arguments are ignored.
+ */
+template <std::uint64_t _p> struct gf_scalar {
+  static constexpr std::size_t lanes = 1;
+  typedef std::uint32_t reg;
+
+  static reg load(const std::uint32_t *a) noexcept { return *a; }
+  static void store(std::uint32_t *r, reg a) noexcept { *r = a; }
+  static reg set1(std::uint32_t a) noexcept { return a; }
+
+  static reg add(reg a, reg b, reg) noexcept {
+    const reg s = a + b;
+    return s >= _p ? reg(s - _p) : s;
+  }
+
+  static reg sub(reg a, reg b, reg) noexcept {
+    return a >= b ? a - b : reg(a - b + _p);
+  }
+
+  static reg mont_mul(reg a, reg b, reg, reg) noexcept {
+    return reg(std::uint64_t(a) * b % _p);
+  }
+};
+
+#if defined(__AVX2__)
+/// Eight lanes of GF(p) in a __m256i (AVX2)
+struct gf_simd {
+  static constexpr std::size_t lanes = 8;
+  typedef __m256i reg;
+
+  static reg load(const std::uint32_t *a) noexcept {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a));
+  }
+  static void store(std::uint32_t *r, reg a) noexcept {
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(r), a);
+  }
+  static reg set1(std::uint32_t a) noexcept {
+    return _mm256_set1_epi32(int(a));
+  }
+
+  // With a, b < p < 2^31, the wrong one of s and s - p is >= 2^31.
+  static reg add(reg a, reg b, reg p) noexcept {
+    const reg s = _mm256_add_epi32(a, b);
+    return _mm256_min_epu32(s, _mm256_sub_epi32(s, p));
+  }
+
+  static reg sub(reg a, reg b, reg p) noexcept {
+    const reg d = _mm256_sub_epi32(a, b);
+    return _mm256_min_epu32(d, _mm256_add_epi32(d, p));
+  }
+
+  // REDC of the even and of the odd lanes, merged by a blend.
+  static reg mont_mul(reg a, reg b, reg p, reg p_inv) noexcept {
+    const reg te = _mm256_mul_epu32(a, b);
+    const reg to = _mm256_mul_epu32(_mm256_srli_epi64(a, 32),
+                                    _mm256_srli_epi64(b, 32));
+    const reg he = _mm256_mul_epu32(_mm256_mul_epu32(te, p_inv), p);
+    const reg ho = _mm256_mul_epu32(_mm256_mul_epu32(to, p_inv), p);
+    const reg th = _mm256_blend_epi32(_mm256_srli_epi64(te, 32), to, 0xaa);
+    const reg hh = _mm256_blend_epi32(_mm256_srli_epi64(he, 32), ho, 0xaa);
+    return sub(th, hh, p);
+  }
+};
+#elif defined(__SSE4_1__)
+/// Four lanes of GF(p) in a __m128i (SSE4.1)
+struct gf_simd {
+  static constexpr std::size_t lanes = 4;
+  typedef __m128i reg;
+
+  static reg load(const std::uint32_t *a) noexcept {
+    return _mm_loadu_si128(reinterpret_cast<const __m128i *>(a));
+  }
+  static void store(std::uint32_t *r, reg a) noexcept {
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(r), a);
+  }
+  static reg set1(std::uint32_t a) noexcept { return _mm_set1_epi32(int(a)); }
+
+  static reg add(reg a, reg b, reg p) noexcept {
+    const reg s = _mm_add_epi32(a, b);
+    return _mm_min_epu32(s, _mm_sub_epi32(s, p));
+  }
+
+  static reg sub(reg a, reg b, reg p) noexcept {
+    const reg d = _mm_sub_epi32(a, b);
+    return _mm_min_epu32(d, _mm_add_epi32(d, p));
+  }
+
+  static reg mont_mul(reg a, reg b, reg p, reg p_inv) noexcept {
+    const reg te = _mm_mul_epu32(a, b);
+    const reg to = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+    const reg he = _mm_mul_epu32(_mm_mul_epu32(te, p_inv), p);
+    const reg ho = _mm_mul_epu32(_mm_mul_epu32(to, p_inv), p);
+    const reg th = _mm_blend_epi16(_mm_srli_epi64(te, 32), to, 0xcc);
+    const reg hh = _mm_blend_epi16(_mm_srli_epi64(he, 32), ho, 0xcc);
+    return sub(th, hh, p);
+  }
+};
+#elif defined(__ARM_NEON)
+/// Four lanes of GF(p) in a uint32x4_t (NEON)
+struct gf_simd {
+  static constexpr std::size_t lanes = 4;
+  typedef uint32x4_t reg;
+
+  static reg load(const std::uint32_t *a) noexcept { return vld1q_u32(a); }
+  static void store(std::uint32_t *r, reg a) noexcept { vst1q_u32(r, a); }
+  static reg set1(std::uint32_t a) noexcept { return vdupq_n_u32(a); }
+
+  static reg add(reg a, reg b, reg p) noexcept {
+    const reg s = vaddq_u32(a, b);
+    return vminq_u32(s, vsubq_u32(s, p));
+  }
+
+  static reg sub(reg a, reg b, reg p) noexcept {
+    const reg d = vsubq_u32(a, b);
+    return vminq_u32(d, vaddq_u32(d, p));
+  }
+
+  static reg mont_mul(reg a, reg b, reg p, reg p_inv) noexcept {
+    const uint64x2_t tl = vmull_u32(vget_low_u32(a), vget_low_u32(b));
+    const uint64x2_t th = vmull_u32(vget_high_u32(a), vget_high_u32(b));
+    const reg m = vmulq_u32(vcombine_u32(vmovn_u64(tl), vmovn_u64(th)), p_inv);
+    const uint64x2_t hl = vmull_u32(vget_low_u32(m), vget_low_u32(p));
+    const uint64x2_t hh = vmull_u32(vget_high_u32(m), vget_high_u32(p));
+    return sub(vcombine_u32(vshrn_n_u64(tl, 32), vshrn_n_u64(th, 32)),
+               vcombine_u32(vshrn_n_u64(hl, 32), vshrn_n_u64(hh, 32)), p);
+  }
+};
+#endif
+
+/**
+ *  Batched kernels of GF(p) on contiguous buffers of values (< p): the
+ *  bulk is processed by gf_simd, if any, the remainder by gf_scalar.
+ */
+template <std::uint64_t _p> struct gf_kernel {
+  typedef std::uint32_t word;
+  typedef montgomery<_p> _Mont;
+  typedef gf_scalar<_p> _One;
+#ifdef FUN_GF_SIMD
+  typedef gf_simd _Vec;
+#else
+  typedef _One _Vec;
+#endif
+
+  /// Constants of the kernel _B (R = 1 for the scalar one)
+  template <class _B> struct consts {
+    static constexpr bool plain = std::is_same<_B, _One>::value;
+    typename _B::reg p = _B::set1(word(_p));
+    typename _B::reg p_inv = _B::set1(_Mont::p_inv);
+    typename _B::reg r2 = _B::set1(_Mont::r2);
+
+    /// Return @a t * R mod p, i.e. undo the division by R of a mont_mul
+    typename _B::reg fix(typename _B::reg t) const noexcept {
+      return plain ? t : _B::mont_mul(t, r2, p, p_inv);
+    }
+
+    /// Return @a s * R mod p
+    static word mont(word s) noexcept {
+      return plain ? s : _Mont::redc(std::uint64_t(s) * _Mont::r2);
+    }
+  };
+
+  /// Apply @a f(B, consts, i) to the lanes i, i + 1, ... of [0, n)
+  template <class _F> static void for_each(std::size_t n, _F f) {
+    std::size_t i = 0;
+    if constexpr (_Vec::lanes > 1) {
+      const consts<_Vec> cv;
+      for (; i + _Vec::lanes <= n; i += _Vec::lanes)
+        f(_Vec(), cv, i);
+    }
+    const consts<_One> cs;
+    for (; i != n; ++i)
+      f(_One(), cs, i);
+  }
+
+  static void add(const word *a, const word *b, word *r, std::size_t n) {
+    for_each(n, [=](auto B, const auto &c, std::size_t i) {
+      B.store(r + i, B.add(B.load(a + i), B.load(b + i), c.p));
+    });
+  }
+
+  static void sub(const word *a, const word *b, word *r, std::size_t n) {
+    for_each(n, [=](auto B, const auto &c, std::size_t i) {
+      B.store(r + i, B.sub(B.load(a + i), B.load(b + i), c.p));
+    });
+  }
+
+  static void mul(const word *a, const word *b, word *r, std::size_t n) {
+    for_each(n, [=](auto B, const auto &c, std::size_t i) {
+      const auto t = B.mont_mul(B.load(a + i), B.load(b + i), c.p, c.p_inv);
+      B.store(r + i, c.fix(t));
+    });
+  }
+
+  /// r = a * s
+  static void scale(const word *a, word s, word *r, std::size_t n) {
+    for_each(n, [=](auto B, const auto &c, std::size_t i) {
+      B.store(r + i, B.mont_mul(B.load(a + i), B.set1(c.mont(s)), c.p,
+                                c.p_inv));
+    });
+  }
+
+  /// r = a * b + d
+  static void fma(const word *a, const word *b, const word *d, word *r,
+                  std::size_t n) {
+    for_each(n, [=](auto B, const auto &c, std::size_t i) {
+      const auto t = B.mont_mul(B.load(a + i), B.load(b + i), c.p, c.p_inv);
+      B.store(r + i, B.add(c.fix(t), B.load(d + i),
+                           c.p));
+    });
+  }
+
+  /// Return sum a[i] * b[i]
+  static word dot(const word *a, const word *b, std::size_t n) {
+    const consts<_Vec> c;
+    typename _Vec::reg acc = _Vec::set1(0);
+    std::size_t i = 0;
+    for (; i + _Vec::lanes <= n; i += _Vec::lanes)
+      acc = _Vec::add(acc, _Vec::mont_mul(_Vec::load(a + i),
+                                          _Vec::load(b + i), c.p, c.p_inv),
+                      c.p);
+    word lanes[_Vec::lanes];
+    _Vec::store(lanes, acc);
+    word s = 0;
+    for (std::size_t j = 0; j != _Vec::lanes; ++j)
+      s = _One::add(s, lanes[j], 0);
+    if (!c.plain)
+      s = _Mont::redc(std::uint64_t(s) * _Mont::r2);
+    for (; i != n; ++i)
+      s = _One::add(s, _One::mont_mul(a[i], b[i], 0, 0), 0);
+    return s;
+  }
+
+  /// (r1, r2, r3) = (a1, a2, a3) x (b1, b2, b3), lane-wise
+  static void cross(const word *const a[3], const word *const b[3],
+                    word *const r[3], std::size_t n) {
+    for_each(n, [=](auto B, const auto &c, std::size_t i) {
+      const auto x1 = B.load(a[0] + i), x2 = B.load(a[1] + i),
+                 x3 = B.load(a[2] + i);
+      const auto y1 = B.load(b[0] + i), y2 = B.load(b[1] + i),
+                 y3 = B.load(b[2] + i);
+      const auto mm = [&](auto u, auto v) {
+        return B.mont_mul(u, v, c.p, c.p_inv);
+      };
+      B.store(r[0] + i, c.fix(B.sub(mm(x2, y3), mm(x3, y2), c.p)));
+      B.store(r[1] + i, c.fix(B.sub(mm(x3, y1), mm(x1, y3), c.p)));
+      B.store(r[2] + i, c.fix(B.sub(mm(x1, y2), mm(x2, y1), c.p)));
+    });
+  }
+
+  /// r = a1 * b1 + a2 * b2 + a3 * b3, lane-wise
+  static void dot3(const word *const a[3], const word *const b[3], word *r,
+                   std::size_t n) {
+    for_each(n, [=](auto B, const auto &c, std::size_t i) {
+      const auto mm = [&](int k) {
+        return B.mont_mul(B.load(a[k] + i), B.load(b[k] + i), c.p, c.p_inv);
+      };
+      const auto t = B.add(B.add(mm(0), mm(1), c.p), mm(2), c.p);
+      B.store(r + i, c.fix(t));
+    });
+  }
+};
+
+} // namespace detail
+
+/**
+ *  Contiguous array of elements of GF(p) with batched arithmetic.
+ *
+ *  The values are stored as 32-bit words, so that the element-wise
+ *  operations, the dot product and the lane-wise cross product run 8
+ *  (AVX2) or 4 (SSE4.1, NEON) lanes at a time with Montgomery reductions
+ *  on the vector registers, and without the temporaries of GF<p>'s
+ *  operators. The kernels are chosen at compile time (e.g. -mavx2); a
+ *  scalar kernel handles the remainder and builds without SIMD.
+ *
+ *  @param  p  Odd prime number < 2^31
+ */
+template <std::uint64_t _p = 3>
+class gf_array : boost::additive<gf_array<_p>>,
+                 boost::multipliable<gf_array<_p>>,
+                 boost::multipliable2<gf_array<_p>, GF<_p>> {
+  static_assert(_p % 2 == 1 && _p < (1U << 31),
+                "gf_array<p> requires an odd p < 2^31");
+
+  typedef detail::gf_kernel<_p> _Kernel;
+
+public:
+  /// Value typedef.
+  typedef GF<_p> value_type;
+
+  /// Storage typedef (values < p).
+  typedef std::uint32_t word;
+
+  /// Default constructor (empty).
+  gf_array() = default;
+
+  /// Construct @a n copies of @a a.
+  explicit gf_array(std::size_t n, const GF<_p> &a = GF<_p>())
+      : _v(n, word(a.value())) {}
+
+  /// Construct from the elements of [@a first, @a last).
+  template <class _InputIterator>
+  gf_array(_InputIterator first, _InputIterator last) {
+    for (; first != last; ++first)
+      push_back(*first);
+  }
+
+  /// Return the number of elements.
+  std::size_t size() const noexcept { return _v.size(); }
+
+  /// Return the element @a i.
+  GF<_p> operator[](std::size_t i) const { return GF<_p>(_v[i]); }
+
+  /// Set the element @a i to @a a.
+  void set(std::size_t i, const GF<_p> &a) { _v[i] = word(a.value()); }
+
+  /// Append @a a.
+  void push_back(const GF<_p> &a) { _v.push_back(word(a.value())); }
+
+  /// Return the values (< p).
+  const word *data() const noexcept { return _v.data(); }
+
+  /// Return the values; all of them must stay < p.
+  word *data() noexcept { return _v.data(); }
+
+  /// Add @a s to this array element-wise.
+  gf_array &operator+=(const gf_array &s) {
+    assert(size() == s.size());
+    _Kernel::add(data(), s.data(), data(), size());
+    return *this;
+  }
+
+  /// Subtract @a s from this array element-wise.
+  gf_array &operator-=(const gf_array &s) {
+    assert(size() == s.size());
+    _Kernel::sub(data(), s.data(), data(), size());
+    return *this;
+  }
+
+  /// Multiply this array by @a s element-wise.
+  gf_array &operator*=(const gf_array &s) {
+    assert(size() == s.size());
+    _Kernel::mul(data(), s.data(), data(), size());
+    return *this;
+  }
+
+  /// Multiply this array by @a a.
+  gf_array &operator*=(const GF<_p> &a) {
+    _Kernel::scale(data(), word(a.value()), data(), size());
+    return *this;
+  }
+
+  /// Add @a x * @a y to this array element-wise (a fused multiply-add).
+  gf_array &fma(const gf_array &x, const gf_array &y) {
+    assert(size() == x.size() && size() == y.size());
+    _Kernel::fma(x.data(), y.data(), data(), data(), size());
+    return *this;
+  }
+
+  /// Return true if @a r is equal to @a s.
+  friend bool operator==(const gf_array &r, const gf_array &s) {
+    return r._v == s._v;
+  }
+
+  /// Return false if @a r is equal to @a s.
+  friend bool operator!=(const gf_array &r, const gf_array &s) {
+    return r._v != s._v;
+  }
+
+private:
+  std::vector<word> _v;
+};
+
+/// Return @a x * @a y + @a z element-wise.
+template <std::uint64_t _p>
+inline gf_array<_p> fma(const gf_array<_p> &x, const gf_array<_p> &y,
+                        gf_array<_p> z) {
+  return z.fma(x, y);
+}
+
+/// Return the dot product of @a x and @a y.
+template <std::uint64_t _p>
+inline GF<_p> dot(const gf_array<_p> &x, const gf_array<_p> &y) {
+  assert(x.size() == y.size());
+  return GF<_p>(detail::gf_kernel<_p>::dot(x.data(), y.data(), x.size()));
+}
+
+/**
+ *  Return the lane-wise cross products of the vectors (v[0][i], v[1][i],
+ *  v[2][i]) and (w[0][i], w[1][i], w[2][i]), e.g. the joins of two arrays
+ *  of point3<GF<p>> stored by coordinates.
+ */
+template <std::uint64_t _p>
+inline void cross(const gf_array<_p> (&v)[3], const gf_array<_p> (&w)[3],
+                  gf_array<_p> (&r)[3]) {
+  const std::size_t n = v[0].size();
+  const std::uint32_t *a[3] = {v[0].data(), v[1].data(), v[2].data()};
+  const std::uint32_t *b[3] = {w[0].data(), w[1].data(), w[2].data()};
+  gf_array<_p> t[3] = {gf_array<_p>(n), gf_array<_p>(n), gf_array<_p>(n)};
+  std::uint32_t *c[3] = {t[0].data(), t[1].data(), t[2].data()};
+  for (int k = 0; k != 3; ++k)
+    assert(v[k].size() == n && w[k].size() == n);
+  detail::gf_kernel<_p>::cross(a, b, c, n);
+  for (int k = 0; k != 3; ++k)
+    r[k] = std::move(t[k]); // r may alias v or w
+}
+
+/**
+ *  Return the lane-wise dot products of the vectors (v[0][i], v[1][i],
+ *  v[2][i]) and (w[0][i], w[1][i], w[2][i]); the zeros are the incident
+ *  point-line pairs.
+ */
+template <std::uint64_t _p>
+inline gf_array<_p> dot(const gf_array<_p> (&v)[3],
+                        const gf_array<_p> (&w)[3]) {
+  const std::size_t n = v[0].size();
+  const std::uint32_t *a[3] = {v[0].data(), v[1].data(), v[2].data()};
+  const std::uint32_t *b[3] = {w[0].data(), w[1].data(), w[2].data()};
+  for (int k = 0; k != 3; ++k)
+    assert(v[k].size() == n && w[k].size() == n);
+  gf_array<_p> r(n);
+  detail::gf_kernel<_p>::dot3(a, b, r.data(), n);
+  return r;
+}
+
+/** @} */
+} // namespace fun
+
+#endif
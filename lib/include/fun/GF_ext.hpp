@@ -0,0 +1,504 @@
+// The template and inlines for the -*- C++ -*- extension field classes.
+// Initially implemented by Wai-Shing Luk <luk036@gmail.com>
+//
+
+/** @file include/GF_ext.hpp
+ *  This is a C++ Library header.
+ */
+
+#ifndef FUN_GF_EXT_HPP
+#define FUN_GF_EXT_HPP 1
+
+#include <boost/operators.hpp>
+#include <cassert>
+#include <cstdint>     // for std::uint16_t, std::uint64_t
+#include <type_traits> // for std::conditional
+
+#include "gcd.hpp" // for fun::bit_length, fun::uint128_t
+
+#if defined(__PCLMUL__)
+#include <wmmintrin.h> // for _mm_clmulepi64_si128
+#elif defined(__aarch64__) && (defined(__ARM_FEATURE_AES) ||                \
+                               defined(__ARM_FEATURE_CRYPTO))
+#include <arm_neon.h> // for vmull_p64
+#define FUN_HAS_VMULL_P64 1
+#endif
+
+namespace fun {
+/**
+ * @addtogroup GF
+ * @{
+ */
+
+namespace detail {
+
+/// Return @a p ^ @a k (0 on overflow of 64 bits)
+inline constexpr std::uint64_t ipow(std::uint64_t p, unsigned int k) noexcept {
+  std::uint64_t q = 1;
+  for (unsigned int i = 0; i < k; ++i) {
+    if (q > ~std::uint64_t(0) / p)
+      return 0;
+    q *= p;
+  }
+  return q;
+}
+
+// Polynomials over GF(2) as bitmasks (bit i: coefficient of x^i).
+
+/// Return the degree of the GF(2) polynomial @a a (-1 for 0)
+inline constexpr int deg2(std::uint64_t a) noexcept { return bit_length(a) - 1; }
+
+/// Return @a a mod @a b over GF(2) (b != 0)
+inline constexpr std::uint64_t mod2(std::uint64_t a, std::uint64_t b) noexcept {
+  const int n = deg2(b);
+  for (int d = deg2(a); d >= n; d = deg2(a))
+    a ^= b << (d - n);
+  return a;
+}
+
+/// Return @a a * @a b mod @a f over GF(2) (deg a, deg b < deg f)
+inline constexpr std::uint64_t mulmod2(std::uint64_t a, std::uint64_t b,
+                                       std::uint64_t f) noexcept {
+  const int n = deg2(f);
+  std::uint64_t r = 0;
+  for (; b != 0; b >>= 1) {
+    if (b & 1)
+      r ^= a;
+    a <<= 1;
+    if ((a >> n) & 1)
+      a ^= f;
+  }
+  return r;
+}
+
+/**
+ *  Return true if the GF(2) polynomial @a f is irreducible (Rabin's
+ *  test): x^(2^n) == x mod f, and gcd(x^(2^(n/r)) - x, f) == 1 for the
+ *  prime divisors r of n = deg f.
+ */
+inline constexpr bool irreducible2(std::uint64_t f) noexcept {
+  const int n = deg2(f);
+  if (n <= 1)
+    return n == 1;
+  std::uint64_t t[64] = {}; // t[i] = x^(2^i) mod f
+  t[0] = 2;
+  for (int i = 1; i <= n; ++i)
+    t[i] = mulmod2(t[i - 1], t[i - 1], f);
+  if (t[n] != 2)
+    return false;
+  int m = n;
+  for (int r = 2; r <= m; ++r) {
+    if (m % r != 0)
+      continue;
+    while (m % r == 0)
+      m /= r;
+    std::uint64_t a = f, b = t[n / r] ^ 2; // gcd(f, x^(2^(n/r)) - x)
+    while (b != 0) {
+      const std::uint64_t c = mod2(a, b);
+      a = b;
+      b = c;
+    }
+    if (a != 1)
+      return false;
+  }
+  return true;
+}
+
+// Polynomials over GF(p) as base-p numbers (digit i: coefficient of x^i).
+
+/// Return true if the monic polynomial @a f of degree @a k is irreducible
+/// over GF(@a p), by trial division (small p^k only)
+inline constexpr bool irreducible_p(std::uint64_t p, unsigned int k,
+                                    std::uint64_t f) noexcept {
+  std::uint64_t fc[64] = {};
+  for (unsigned int i = 0; i <= k; ++i, f /= p)
+    fc[i] = f % p;
+  if (fc[k] != 1)
+    return false;
+  for (unsigned int d = 1; 2 * d <= k; ++d) {
+    const std::uint64_t lo = ipow(p, d);
+    for (std::uint64_t g = lo; g != 2 * lo; ++g) { // monic, degree d
+      std::uint64_t gc[64] = {}, r[64] = {};
+      std::uint64_t h = g;
+      for (unsigned int i = 0; i <= d; ++i, h /= p)
+        gc[i] = h % p;
+      for (unsigned int i = 0; i <= k; ++i)
+        r[i] = fc[i];
+      for (unsigned int i = k; i >= d; --i) { // r -= r[i] x^(i-d) g
+        const std::uint64_t c = r[i];
+        for (unsigned int j = 0; j <= d; ++j)
+          r[i - d + j] = (r[i - d + j] + (p - c) * gc[j]) % p;
+      }
+      bool zero = true;
+      for (unsigned int i = 0; i < d; ++i)
+        zero = zero && r[i] == 0;
+      if (zero)
+        return false;
+    }
+  }
+  return true;
+}
+
+/// Return @a a * @a b mod @a f over GF(@a p); @a f monic of degree @a k
+inline constexpr std::uint64_t mulmod_p(std::uint64_t p, unsigned int k,
+                                        std::uint64_t f, std::uint64_t a,
+                                        std::uint64_t b) noexcept {
+  std::uint64_t ac[32] = {}, bc[32] = {}, fc[32] = {}, r[64] = {};
+  for (unsigned int i = 0; i < k; ++i, a /= p, b /= p, f /= p) {
+    ac[i] = a % p;
+    bc[i] = b % p;
+    fc[i] = f % p;
+  }
+  for (unsigned int i = 0; i < k; ++i)
+    for (unsigned int j = 0; j < k; ++j)
+      r[i + j] = (r[i + j] + ac[i] * bc[j]) % p;
+  for (unsigned int i = 2 * k - 2; i >= k; --i) // x^k == -(f - x^k)
+    for (unsigned int j = 0; j < k; ++j)
+      r[i - k + j] = (r[i - k + j] + (p - r[i]) * fc[j]) % p;
+  std::uint64_t s = 0;
+  for (unsigned int i = k; i-- > 0;)
+    s = s * p + r[i];
+  return s;
+}
+
+/// Return the smallest monic irreducible polynomial of degree @a k over
+/// GF(@a p), leading term included
+inline constexpr std::uint64_t default_irreducible(std::uint64_t p,
+                                                   unsigned int k) noexcept {
+  const std::uint64_t q = ipow(p, k);
+  for (std::uint64_t f = q;; ++f)
+    if (p == 2 ? irreducible2(f) : irreducible_p(p, k, f))
+      return f;
+}
+
+/**
+ *  Tables of GF(q), q = p^k <= 2^16, built once at run time (on first
+ *  use) from a generator g: exp[i] = g^i (two periods), log, and for odd
+ *  p the Zech logarithms zech[n] = log(1 + g^n) (q - 1 if 1 + g^n == 0).
+ *  g is the first element with g^((q-1)/r) != 1 for every prime factor r
+ *  of q - 1.
+ */
+template <std::uint64_t _p, unsigned int _k, std::uint64_t _f>
+struct ext_table {
+  static constexpr std::uint64_t q = ipow(_p, _k);
+
+  std::uint16_t exp[2 * q];
+  std::uint16_t log[q];
+  std::uint16_t zech[q];
+
+  ext_table() : exp{}, log{}, zech{} {
+    auto mul = [](std::uint64_t a, std::uint64_t b) {
+      return _p == 2 ? mulmod2(a, b, _f) : mulmod_p(_p, _k, _f, a, b);
+    };
+    auto pow = [&mul](std::uint64_t a, std::uint64_t n) {
+      std::uint64_t r = 1;
+      for (; n != 0; n >>= 1, a = mul(a, a))
+        if (n & 1)
+          r = mul(r, a);
+      return r;
+    };
+    std::uint64_t primes[16], np = 0; // prime factors of q - 1
+    for (std::uint64_t m = q - 1, r = 2; m != 1; ++r) {
+      if (r * r > m)
+        r = m;
+      if (m % r == 0) {
+        primes[np++] = r;
+        while (m % r == 0)
+          m /= r;
+      }
+    }
+    std::uint64_t g = _k > 1 ? _p : 1; // try x first
+    for (;; ++g) {
+      std::uint64_t i = 0;
+      while (i != np && pow(g, (q - 1) / primes[i]) != 1)
+        ++i;
+      if (i == np && g != 0)
+        break;
+    }
+    std::uint64_t h = 1;
+    for (std::uint64_t i = 0; i + 1 < q; ++i) {
+      exp[i] = exp[i + q - 1] = std::uint16_t(h);
+      log[h] = std::uint16_t(i);
+      h = mul(h, g);
+    }
+    for (std::uint64_t n = 0; n + 1 < q && _p != 2; ++n) {
+      const std::uint64_t a = exp[n], c = a % _p;
+      const std::uint64_t s = a - c + (c + 1) % _p; // 1 + g^n
+      zech[n] = s == 0 ? std::uint16_t(q - 1) : log[s];
+    }
+  }
+
+  static const ext_table &get() noexcept {
+    static const ext_table t;
+    return t;
+  }
+};
+
+/// Return the carry-less product of @a a and @a b (< 2^32 each)
+inline std::uint64_t clmul32(std::uint64_t a, std::uint64_t b) noexcept {
+#if defined(__PCLMUL__)
+  return std::uint64_t(_mm_cvtsi128_si64(_mm_clmulepi64_si128(
+      _mm_cvtsi64_si128(static_cast<long long>(a)),
+      _mm_cvtsi64_si128(static_cast<long long>(b)), 0)));
+#elif defined(FUN_HAS_VMULL_P64)
+  return std::uint64_t(vmull_p64(a, b));
+#else
+  std::uint64_t r = 0;
+  for (; b != 0; b &= b - 1)
+    r ^= a << ctz64(b);
+  return r;
+#endif
+}
+
+#ifdef FUN_HAS_INT128
+/// Return the carry-less product of @a a and @a b
+inline uint128_t clmul64(std::uint64_t a, std::uint64_t b) noexcept {
+#if defined(__PCLMUL__)
+  const __m128i r = _mm_clmulepi64_si128(
+      _mm_cvtsi64_si128(static_cast<long long>(a)),
+      _mm_cvtsi64_si128(static_cast<long long>(b)), 0);
+  return uint128_t(std::uint64_t(_mm_cvtsi128_si64(r))) |
+         uint128_t(std::uint64_t(_mm_cvtsi128_si64(_mm_unpackhi_epi64(r, r))))
+             << 64;
+#elif defined(FUN_HAS_VMULL_P64)
+  return uint128_t(vmull_p64(a, b));
+#else
+  uint128_t r = 0;
+  for (; b != 0; b &= b - 1)
+    r ^= uint128_t(a) << ctz64(b);
+  return r;
+#endif
+}
+#endif
+
+} // namespace detail
+
+/**
+ *  Extension field GF(p^k) = GF(p)[x] / (f).
+ *
+ *  Elements are written as polynomials of degree < k packed into an
+ *  integer: a bitmask for p = 2, base-p digits otherwise (the constant
+ *  polynomials 0, 1, ..., p-1 are the integers 0, 1, ..., p-1). value()
+ *  returns this packed form, the constructor takes it.
+ *
+ *  - GF(2^k), k <= 12: bitmask, addition is XOR, multiplication and
+ *    inversion are log/antilog table lookups;
+ *  - GF(2^k), k > 12: bitmask, carry-less multiplication (PCLMULQDQ or
+ *    PMULL if available, shifts otherwise) reduced by folding with f;
+ *  - GF(p^k), p odd, p^k <= 2^16: elements are stored as discrete
+ *    logarithms, so that products are additions of logarithms and sums
+ *    use the Zech logarithm table.
+ *
+ *  The tables are built once, on first use. Since vector3, point3 and
+ *  line3 only need the field operators, they work unchanged over
+ *  GF_ext, e.g. point3<GF_ext<2, 2>> for the projective plane of order 4.
+ *
+ *  @param  p  Prime number
+ *  @param  k  Degree of the extension
+ *  @param  f  Monic irreducible polynomial of degree k, packed as above
+ *             with its leading term (e.g. 0b10011 for x^4 + x + 1, or
+ *             10 = 9 + 1 for x^2 + 1 over GF(3)); the default is the
+ *             smallest one
+ */
+template <std::uint64_t _p, unsigned int _k,
+          std::uint64_t _f = detail::default_irreducible(_p, _k)>
+struct GF_ext : boost::field_operators<GF_ext<_p, _k, _f>> {
+  /// Order of the field.
+  static constexpr std::uint64_t order = detail::ipow(_p, _k);
+
+  static_assert(_k >= 1 && order != 0, "GF_ext<p, k> requires p^k < 2^64");
+  static_assert(_p == 2 || order <= 65536,
+                "GF_ext<p, k> requires p^k <= 2^16 for an odd p");
+  static_assert(_p == 2 ? detail::irreducible2(_f)
+                        : detail::irreducible_p(_p, _k, _f),
+                "GF_ext<p, k, f> requires an irreducible f of degree k");
+
+  /// GF(2^k) with log/antilog tables
+  static constexpr bool table_mode = _p == 2 && _k <= 12;
+
+  /// Elements stored as logarithms (odd p)
+  static constexpr bool log_mode = _p != 2;
+
+  /// Value typedef: the packed polynomial
+  typedef typename std::conditional<(order >> 32) == 0, std::uint32_t,
+                                    std::uint64_t>::type value_type;
+
+  /// Default constructor.
+  constexpr GF_ext() noexcept : _m(zero_rep()) {}
+
+  ///  Construct the element with the packed polynomial @a m (< order).
+  explicit GF_ext(value_type m) noexcept {
+    assert(m < order);
+    if constexpr (log_mode)
+      _m = m == 0 ? zero_rep() : table().log[m];
+    else
+      _m = m;
+  }
+
+  /// Return the element as a packed polynomial.
+  value_type value() const noexcept {
+    if constexpr (log_mode)
+      return _m == zero_rep() ? 0 : table().exp[_m];
+    else
+      return _m;
+  }
+
+  /// Return true if the element is 0.
+  constexpr bool is_zero() const noexcept { return _m == zero_rep(); }
+
+  /// Add @a s to this finite field.
+  GF_ext &operator+=(const GF_ext &s) noexcept {
+    if constexpr (log_mode) {
+      if (is_zero()) {
+        _m = s._m;
+      } else if (!s.is_zero()) { // g^a + g^b = g^a (1 + g^(b-a))
+        const value_type z =
+            table().zech[s._m >= _m ? s._m - _m : s._m + (order - 1) - _m];
+        _m = z == zero_rep() ? zero_rep() : add_log(_m, z);
+      }
+    } else {
+      _m ^= s._m;
+    }
+    return *this;
+  }
+
+  /// Subtract @a s from this finite field.
+  GF_ext &operator-=(const GF_ext &s) noexcept { return *this += -s; }
+
+  /// Multiply @a s to this finite field.
+  GF_ext &operator*=(const GF_ext &s) noexcept {
+    if constexpr (log_mode) {
+      _m = is_zero() || s.is_zero() ? zero_rep() : add_log(_m, s._m);
+    } else if constexpr (table_mode) {
+      const auto &t = table();
+      _m = _m == 0 || s._m == 0 ? 0 : t.exp[t.log[_m] + t.log[s._m]];
+    } else {
+      _m = mul_clmul(_m, s._m);
+    }
+    return *this;
+  }
+
+  /// Divide this finite field by @a s (!= 0).
+  GF_ext &operator/=(const GF_ext &s) noexcept { return *this *= inv(s); }
+
+  /// Return the multiplicative inverse of @a r (!= 0).
+  friend GF_ext inv(const GF_ext &r) noexcept {
+    assert(!r.is_zero());
+    GF_ext t;
+    if constexpr (log_mode) {
+      t._m = r._m == 0 ? 0 : value_type(order - 1 - r._m);
+    } else if constexpr (table_mode) {
+      const auto &tb = table();
+      t._m = tb.exp[(order - 1 - tb.log[r._m]) % (order - 1)];
+    } else {
+      t = pow_clmul(r, order - 2); // a^(q-2), Fermat
+    }
+    return t;
+  }
+
+  /// Return @a r raised to the power @a n (0^0 == 1).
+  friend GF_ext pow(const GF_ext &r, long long n) noexcept {
+    if (n < 0)
+      return pow(inv(r), -(n + 1)) * inv(r); // -n may overflow
+    if (r.is_zero())
+      return n == 0 ? GF_ext(value_type(1)) : r;
+    std::uint64_t e = std::uint64_t(n) % (order - 1);
+    GF_ext t;
+    if constexpr (log_mode) {
+      const std::uint64_t l = std::uint64_t(r._m) * e % (order - 1);
+      t._m = value_type(l);
+    } else if constexpr (table_mode) {
+      const auto &tb = table();
+      t._m = tb.exp[std::uint64_t(tb.log[r._m]) * e % (order - 1)];
+    } else {
+      t = pow_clmul(r, e);
+    }
+    return t;
+  }
+
+  /// Return true if @a r is equal to @a s.
+  friend constexpr bool operator==(const GF_ext &r, const GF_ext &s) noexcept {
+    return r._m == s._m;
+  }
+
+  /// Return false if @a r is equal to @a s.
+  friend constexpr bool operator!=(const GF_ext &r, const GF_ext &s) noexcept {
+    return r._m != s._m;
+  }
+
+  /// Return negation of @a r
+  friend GF_ext operator-(const GF_ext &r) noexcept {
+    GF_ext t(r);
+    if constexpr (log_mode) { // -1 = g^((q-1)/2)
+      if (!r.is_zero())
+        t._m = add_log(r._m, value_type((order - 1) / 2));
+    }
+    return t; // characteristic 2: -a == a
+  }
+
+  /// Return @a r.
+  friend GF_ext operator+(const GF_ext &r) noexcept { return r; }
+
+private:
+  /// Representation of 0 (an out-of-range logarithm in log mode)
+  static constexpr value_type zero_rep() noexcept {
+    return log_mode ? value_type(order - 1) : 0;
+  }
+
+  static const auto &table() noexcept {
+    return detail::ext_table<_p, _k, _f>::get();
+  }
+
+  /// Return (a + b) mod (q - 1) for logarithms a, b < q - 1
+  static constexpr value_type add_log(value_type a, value_type b) noexcept {
+    const value_type t = value_type(order - 1 - b);
+    return a >= t ? value_type(a - t) : value_type(a + b);
+  }
+
+  /// Return @a x ^ @a e by square-and-multiply
+  static GF_ext pow_clmul(GF_ext x, std::uint64_t e) noexcept {
+    GF_ext y(value_type(1));
+    for (; e != 0; e >>= 1, x *= x)
+      if (e & 1)
+        y *= x;
+    return y;
+  }
+
+  /// Return a * b mod f in GF(2^k): carry-less product, then fold the
+  /// part above x^k back with f - x^k until the degree is below k
+  static value_type mul_clmul(value_type a, value_type b) noexcept {
+    constexpr std::uint64_t g = _f ^ (std::uint64_t(1) << _k);
+    constexpr std::uint64_t mask = (std::uint64_t(1) << _k) - 1;
+    if constexpr (_k <= 32) {
+      std::uint64_t r = detail::clmul32(a, b);
+      while ((r >> _k) != 0)
+        r = (r & mask) ^ detail::clmul32(r >> _k, g);
+      return value_type(r);
+    } else {
+#ifdef FUN_HAS_INT128
+      uint128_t r = detail::clmul64(a, b);
+      while ((r >> _k) != 0)
+        r = (r & mask) ^ detail::clmul64(std::uint64_t(r >> _k), g);
+      return value_type(r);
+#else
+      static_assert(_k <= 32, "GF_ext<2, k> with k > 32 requires 128-bit "
+                              "integers");
+      return 0;
+#endif
+    }
+  }
+
+  value_type _m;
+};
+
+///  Insertion operator for finite field values.
+template <std::uint64_t _p, unsigned int _k, std::uint64_t _f, class _Stream>
+_Stream &operator<<(_Stream &os, const GF_ext<_p, _k, _f> &r) {
+  os << '(' << r.value() << " in GF(" << _p << '^' << _k << "))";
+  return os;
+}
+
+/** @} */
+} // namespace fun
+
+#endif
@@ -0,0 +1,218 @@
+// The template and inlines for the -*- C++ -*- Montgomery finite field.
+// Initially implemented by Wai-Shing Luk <luk036@gmail.com>
+//
+
+/** @file include/GF_mont.hpp
+ *  This is a C++ Library header.
+ */
+
+#ifndef FUN_GF_MONT_HPP
+#define FUN_GF_MONT_HPP 1
+
+#include <boost/operators.hpp>
+#include <cassert>
+#include <cstdint>     // for std::uint32_t, std::uint64_t
+#include <type_traits> // for std::conditional
+
+#include "GF_traits.hpp" // for gf_traits
+#include "gcd.hpp"       // for fun::uint128_t
+
+namespace fun {
+/**
+ * @addtogroup GF
+ * @{
+ */
+
+namespace detail {
+
+/// Double-width unsigned type of the Montgomery word _W
+template <typename _W> struct mont_wide;
+template <> struct mont_wide<std::uint32_t> { typedef std::uint64_t type; };
+#ifdef FUN_HAS_INT128
+template <> struct mont_wide<std::uint64_t> { typedef uint128_t type; };
+#endif
+
+/// Montgomery word of the modulus @a _p: 32 bits if possible, else 64 bits
+template <std::uint64_t _p>
+using mont_word = typename std::conditional<(_p >> 32) == 0, std::uint32_t,
+                                            std::uint64_t>::type;
+
+/// Return p^-1 mod 2^N for an odd @a p (Newton's iteration)
+template <typename _W> inline constexpr _W mont_inverse(_W p) noexcept {
+  _W x = p; // p * p == 1 mod 8
+  for (int i = 0; i < 5; ++i)
+    x *= _W(2) - p * x; // doubles the number of correct bits
+  return x;
+}
+
+/// Return 2^2N mod @a p, N the bits of _W
+template <typename _W> inline constexpr _W mont_r2(_W p) noexcept {
+  typedef typename mont_wide<_W>::type _D;
+  const _D r = (_D(_W(~_W(0) % p)) + 1) % p; // 2^N mod p
+  return _W(r * r % p);
+}
+
+/**
+ *  Montgomery arithmetic modulo the odd @a _p with R = 2^N, N the bits of
+ *  the word: redc(t) = t / R mod p.
+ */
+template <std::uint64_t _p> struct montgomery {
+  typedef mont_word<_p> word;
+  typedef typename mont_wide<word>::type wide;
+
+  /// p^-1 mod R
+  static constexpr word p_inv = mont_inverse(word(_p));
+
+  /// R^2 mod p, to convert into Montgomery form
+  static constexpr word r2 = mont_r2(word(_p));
+
+  /**
+   *  Return t * R^-1 mod p for t < p * R.
+   *
+   *  With m = t * p^-1 mod R, the low words of t and m * p are equal, so
+   *  t - m * p is exactly (hi(t) - hi(m * p)) * R; the difference lies in
+   *  (-p, p), which avoids the overflow of t + m * p for p > R / 2.
+   */
+  static constexpr word redc(wide t) noexcept {
+    const word m = word(t) * p_inv;
+    const word h = word((wide(m) * _p) >> (8 * sizeof(word)));
+    const word th = word(t >> (8 * sizeof(word)));
+    return th >= h ? word(th - h) : word(th - h + _p);
+  }
+
+  /// Return a * b mod p for a, b < p (two REDC's, no division)
+  static constexpr word mul_mod(word a, word b) noexcept {
+    return redc(wide(redc(wide(a) * b)) * r2);
+  }
+};
+
+} // namespace detail
+
+/**
+ *  Finite field GF(p) in Montgomery form.
+ *
+ *  Same interface as GF<p>, but an element a is stored as a * R mod p,
+ *  R = 2^32 (or 2^64 for p > 2^32), so that a product needs two word
+ *  multiplications and a shift (Montgomery's REDC) instead of a division
+ *  by p. Addition and subtraction use a conditional subtraction. The
+ *  conversions happen only in the constructor and in value().
+ *
+ *  @param  p  Odd prime number (< 2^64; > 2^32 requires 128-bit integers)
+ */
+template <std::uint64_t _p = 3>
+struct GF_mont : boost::field_operators<GF_mont<_p>> {
+  static_assert(_p % 2 == 1 && gf_traits<_p>::is_prime,
+                "GF_mont<p> requires an odd prime p");
+
+  /// Value typedef (unsigned int for p < 2^32).
+  typedef detail::mont_word<_p> value_type;
+
+  /// Default constructor.
+  constexpr GF_mont() noexcept : _m(0) {}
+
+  ///  Construct the element @a m (< p).
+  explicit constexpr GF_mont(value_type m) noexcept
+      : _m(_Mont::redc(_Wide(m) * _Mont::r2)) {
+    assert(m < _p);
+  }
+
+  /// Return internal element of finite field.
+  constexpr value_type value() const noexcept { return _Mont::redc(_Wide(_m)); }
+
+  /// Return the Montgomery representation (value() * R mod p).
+  constexpr value_type raw() const noexcept { return _m; }
+
+  /// Add @a s to this finite field.
+  constexpr GF_mont &operator+=(const GF_mont &s) noexcept {
+    const value_type t = value_type(_p - s._m);
+    _m = _m >= t ? _m - t : _m + s._m;
+    return *this;
+  }
+
+  /// Subtract @a s from this finite field.
+  constexpr GF_mont &operator-=(const GF_mont &s) noexcept {
+    _m = _m >= s._m ? value_type(_m - s._m) : value_type(_m + (_p - s._m));
+    return *this;
+  }
+
+  /// Multiply @a s to this finite field.
+  constexpr GF_mont &operator*=(const GF_mont &s) noexcept {
+    _m = _Mont::redc(_Wide(_m) * s._m);
+    return *this;
+  }
+
+  /// Divide this finite field by @a s (!= 0).
+  GF_mont &operator/=(const GF_mont &s) { return *this *= inv(s); }
+
+  /// Return true if @a r is equal to @a s.
+  friend constexpr bool operator==(const GF_mont &r, const GF_mont &s) noexcept {
+    return r._m == s._m; // a -> a * R mod p is one-to-one
+  }
+
+  /// Return false if @a r is equal to @a s.
+  friend constexpr bool operator!=(const GF_mont &r, const GF_mont &s) noexcept {
+    return r._m != s._m;
+  }
+
+  /// Return negation of @a r
+  friend constexpr GF_mont operator-(const GF_mont &r) noexcept {
+    GF_mont t;
+    t._m = r._m == 0 ? 0 : value_type(_p - r._m);
+    return t;
+  }
+
+  /// Return @a r.
+  friend constexpr GF_mont operator+(const GF_mont &r) noexcept { return r; }
+
+private:
+  typedef detail::montgomery<_p> _Mont;
+  typedef typename _Mont::wide _Wide;
+
+  value_type _m;
+};
+
+namespace detail {
+
+/// Return @a r ^ @a e by square-and-multiply in Montgomery form
+template <std::uint64_t _p>
+inline GF_mont<_p> pow_mont(GF_mont<_p> x, std::uint64_t e) {
+  GF_mont<_p> y(1U);
+  for (; e != 0; e >>= 1, x *= x)
+    if (e & 1)
+      y *= x;
+  return y;
+}
+
+} // namespace detail
+
+/**
+ *  Return @a r raised to the power @a n by square-and-multiply in
+ *  Montgomery form (a negative @a n inverts @a r first; 0^0 == 1).
+ */
+template <std::uint64_t _p>
+inline GF_mont<_p> pow(const GF_mont<_p> &r, long long n) {
+  if (n < 0)
+    return pow(inv(r), -(n + 1)) * inv(r); // -n may overflow
+  std::uint64_t e = static_cast<std::uint64_t>(n);
+  if (r != GF_mont<_p>())
+    e %= _p - 1; // Fermat
+  return detail::pow_mont(r, e);
+}
+
+/// Return the multiplicative inverse of @a r (!= 0), r^(p-2) (Fermat).
+template <std::uint64_t _p> inline GF_mont<_p> inv(const GF_mont<_p> &r) {
+  assert(r != GF_mont<_p>());
+  return detail::pow_mont(r, _p - 2);
+}
+
+///  Insertion operator for finite field values.
+template <std::uint64_t _p, class _Stream>
+_Stream &operator<<(_Stream &os, const GF_mont<_p> &r) {
+  os << '(' << r.value() << " mod " << _p << ')';
+  return os;
+}
+
+/** @} */
+} // namespace fun
+
+#endif
@@ -0,0 +1,249 @@
+// The template and inlines for the -*- C++ -*- finite field metadata.
+// Initially implemented by Wai-Shing Luk <luk036@gmail.com>
+//
+
+/** @file include/GF_traits.hpp
+ *  This is a C++ Library header.
+ */
+
+#ifndef FUN_GF_TRAITS_HPP
+#define FUN_GF_TRAITS_HPP 1
+
+#include <cstdint> // for std::uint64_t
+
+#include "gcd.hpp" // for binary_gcd, detail::ctz64, fun::uint128_t
+
+namespace fun {
+/**
+ * @addtogroup GF
+ * @{
+ */
+
+namespace detail {
+
+// Forward declarations.
+template <std::uint64_t _p> struct montgomery;
+
+/// Return the high word of @a a * @a b
+inline constexpr std::uint64_t mulhi64(std::uint64_t a,
+                                       std::uint64_t b) noexcept {
+#ifdef FUN_HAS_INT128
+  return std::uint64_t((uint128_t(a) * b) >> 64);
+#else
+  const std::uint64_t a0 = a & 0xffffffffU, a1 = a >> 32;
+  const std::uint64_t b0 = b & 0xffffffffU, b1 = b >> 32;
+  const std::uint64_t t = a1 * b0 + ((a0 * b0) >> 32);
+  const std::uint64_t u = a0 * b1 + (t & 0xffffffffU);
+  return a1 * b1 + (t >> 32) + (u >> 32);
+#endif
+}
+
+/// Return @a a * @a b mod @a m
+inline constexpr std::uint64_t mul_mod64(std::uint64_t a, std::uint64_t b,
+                                         std::uint64_t m) noexcept {
+#ifdef FUN_HAS_INT128
+  return std::uint64_t(uint128_t(a) * b % m);
+#else
+  std::uint64_t r = 0; // double and add, without overflow
+  for (a %= m; b != 0; b >>= 1) {
+    if (b & 1)
+      r = r >= m - a ? r - (m - a) : r + a;
+    a = a >= m - a ? a - (m - a) : a + a;
+  }
+  return r;
+#endif
+}
+
+/// Return @a a ^ @a e mod @a m
+inline constexpr std::uint64_t pow_mod64(std::uint64_t a, std::uint64_t e,
+                                         std::uint64_t m) noexcept {
+  std::uint64_t r = 1 % m;
+  for (a %= m; e != 0; e >>= 1, a = mul_mod64(a, a, m))
+    if (e & 1)
+      r = mul_mod64(r, a, m);
+  return r;
+}
+
+/**
+ *  Return true if @a n is prime: Miller-Rabin with the first twelve primes
+ *  as bases, which is deterministic below 3.3 * 10^24.
+ */
+inline constexpr bool is_prime(std::uint64_t n) noexcept {
+  constexpr unsigned bases[] = {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37};
+  if (n < 2)
+    return false;
+  for (unsigned q : bases)
+    if (n % q == 0)
+      return n == q;
+  const int s = ctz64(n - 1);
+  const std::uint64_t d = (n - 1) >> s;
+  for (unsigned a : bases) {
+    std::uint64_t x = pow_mod64(a, d, n);
+    if (x == 1 || x == n - 1)
+      continue;
+    int i = 1;
+    for (; i < s; ++i) {
+      x = mul_mod64(x, x, n);
+      if (x == n - 1)
+        break;
+    }
+    if (i == s)
+      return false;
+  }
+  return true;
+}
+
+/// Return a nontrivial factor of the odd composite @a n (Pollard-Brent)
+inline constexpr std::uint64_t pollard_rho(std::uint64_t n) noexcept {
+  constexpr std::uint64_t batch = 128; // differences per gcd
+  for (std::uint64_t c = 1;; ++c) {
+    auto f = [n, c](std::uint64_t v) { return (mul_mod64(v, v, n) + c) % n; };
+    auto diff = [](std::uint64_t u, std::uint64_t v) {
+      return u > v ? u - v : v - u;
+    };
+    std::uint64_t x = 0, y = 2, ys = 2, q = 1, g = 1;
+    for (std::uint64_t r = 1; g == 1; r *= 2) {
+      x = y;
+      for (std::uint64_t i = 0; i != r; ++i)
+        y = f(y);
+      for (std::uint64_t k = 0; k < r && g == 1; k += batch) {
+        ys = y;
+        for (std::uint64_t i = 0; i != batch && i != r - k; ++i) {
+          y = f(y);
+          q = mul_mod64(q, diff(x, y), n);
+        }
+        g = binary_gcd(q, n);
+      }
+    }
+    if (g == n) // the batch overshot: redo it one step at a time
+      do {
+        ys = f(ys);
+        g = binary_gcd(diff(x, ys), n);
+      } while (g == 1);
+    if (g != n)
+      return g;
+  }
+}
+
+/// Distinct prime factors of an integer (at most 15 below 2^64)
+struct prime_factors {
+  std::uint64_t q[15];
+  int size;
+
+  constexpr prime_factors() noexcept : q{}, size(0) {}
+
+  /// Add the prime @a p unless already present
+  constexpr void add(std::uint64_t p) noexcept {
+    for (int i = 0; i != size; ++i)
+      if (q[i] == p)
+        return;
+    q[size++] = p;
+  }
+
+  /// Add the prime factors of @a n (without factors below 2^10)
+  constexpr void add_large(std::uint64_t n) noexcept {
+    if (n == 1)
+      return;
+    if (is_prime(n))
+      return add(n);
+    const std::uint64_t d = pollard_rho(n);
+    add_large(d);
+    add_large(n / d);
+  }
+};
+
+/// Return the distinct prime factors of @a n (trial division, then rho)
+inline constexpr prime_factors factorize(std::uint64_t n) noexcept {
+  prime_factors f;
+  for (std::uint64_t q = 2; q < 1024 && q * q <= n; q += q == 2 ? 1 : 2)
+    if (n % q == 0) {
+      f.add(q);
+      do
+        n /= q;
+      while (n % q == 0);
+    }
+  f.add_large(n);
+  return f;
+}
+
+/// Return the multiplicative order of @a a (!= 0) modulo the prime @a p
+inline constexpr std::uint64_t multiplicative_order(
+    std::uint64_t a, std::uint64_t p, const prime_factors &f) noexcept {
+  std::uint64_t e = p - 1;
+  for (int i = 0; i != f.size; ++i)
+    while (e % f.q[i] == 0 && pow_mod64(a, e / f.q[i], p) == 1)
+      e /= f.q[i];
+  return e;
+}
+
+/// Return the smallest primitive root modulo the prime @a p
+inline constexpr std::uint64_t primitive_root(std::uint64_t p,
+                                              const prime_factors &f) noexcept {
+  if (p == 2)
+    return 1;
+  for (std::uint64_t g = 2;; ++g) {
+    bool generator = true;
+    for (int i = 0; i != f.size && generator; ++i)
+      generator = pow_mod64(g, (p - 1) / f.q[i], p) != 1;
+    if (generator)
+      return g;
+  }
+}
+
+} // namespace detail
+
+/**
+ *  Compile-time metadata of the prime field GF(p).
+ *
+ *  Everything is a constant expression, so that no setup is done at run
+ *  time; the factorization of p - 1 (trial division, then Pollard-Brent)
+ *  is only evaluated by the members that need it.
+ *
+ *  @param  p  Prime number (< 2^64)
+ */
+template <std::uint64_t _p> struct gf_traits {
+  /// True if p is prime (deterministic Miller-Rabin)
+  static constexpr bool is_prime = detail::is_prime(_p);
+
+  /// Multiply, invert and raise to a power by log/antilog tables.
+  static constexpr bool table_mode = _p <= 1024;
+
+  /// Distinct prime factors of p - 1
+  static constexpr detail::prime_factors factors = detail::factorize(_p - 1);
+
+  /// Smallest primitive root modulo p
+  static constexpr std::uint64_t primitive_root =
+      detail::primitive_root(_p, factors);
+
+  /// Largest s with 2^s | p - 1: the longest NTT is 2^s
+  static constexpr int two_adicity = detail::ctz64(_p - 1);
+
+  /// Primitive root of unity of order 2^two_adicity
+  static constexpr std::uint64_t root_of_unity =
+      detail::pow_mod64(primitive_root, (_p - 1) >> two_adicity, _p);
+
+  /// Montgomery constants (odd p): p^-1 mod R and R^2 mod p (GF_mont.hpp)
+  typedef detail::montgomery<_p> montgomery;
+
+  /// Barrett constant floor((2^64 - 1) / p), for p < 2^32 (0 otherwise)
+  static constexpr std::uint64_t barrett =
+      (_p >> 32) == 0 ? ~std::uint64_t(0) / _p : 0;
+
+  /// Return @a x mod p by Barrett's reduction (p < 2^32)
+  static constexpr std::uint64_t reduce(std::uint64_t x) noexcept {
+    static_assert((_p >> 32) == 0, "reduce() requires p < 2^32");
+    // The quotient estimate is short by at most one
+    const std::uint64_t r = x - detail::mulhi64(x, barrett) * _p;
+    return r >= _p ? r - _p : r;
+  }
+
+  /// Return the multiplicative order of @a a (0 < a < p)
+  static constexpr std::uint64_t order(std::uint64_t a) noexcept {
+    return detail::multiplicative_order(a, _p, factors);
+  }
+};
+
+/** @} */
+} // namespace fun
+
+#endif
@@ -0,0 +1,213 @@
+// The template and inlines for the -*- C++ -*- adaptive predicates.
+// Initially implemented by Wai-Shing Luk <luk036@gmail.com>
+//
+
+/** @file include/adaptive_predicates.hpp
+ *  This is a C++ Library header.
+ */
+
+#ifndef FUN_ADAPTIVE_PREDICATES_HPP
+#define FUN_ADAPTIVE_PREDICATES_HPP 1
+
+#include <cmath>       // for std::fabs, std::isfinite
+#include <type_traits> // for std::is_integral, std::decay
+
+#include "bigint.hpp" // for fun::bigint
+#include "dyadic.hpp" // for fun::dyadic
+#include "line3.hpp"
+#include "point3.hpp"
+
+namespace fun {
+/**
+ * @defgroup adaptive Adaptive Predicates
+ * @ingroup geometry
+ *
+ * Exact predicates at floating point speed: the predicate polynomial is
+ * first evaluated in double together with a bound on its rounding error
+ * (fp_bound). Only when the value does not exceed the bound, i.e. the
+ * sign is uncertain, is it evaluated again exactly, with bigint for
+ * integer coordinates and dyadic<bigint> for floating point ones.
+ * @{
+ */
+
+/**
+ *  Double with a bound on its absolute error.
+ *
+ *  Every operation adds its own rounding error 2^-52 |result| (twice the
+ *  unit roundoff) to the propagated one, plus 2^-1074 for underflow in
+ *  products; the bound is then inflated by 2^-50 to cover the rounding
+ *  of the bound computation itself.
+ */
+struct fp_bound {
+  double value;
+  double error;
+
+  /// Construct from a double (exact)
+  constexpr fp_bound(double v = 0.0) noexcept : value(v), error(0.0) {}
+
+  /// Construct from an integer (exact up to 2^53)
+  template <typename _I, class = typename std::enable_if<
+                             std::is_integral<_I>::value>::type>
+  constexpr fp_bound(_I i) noexcept
+      : value(double(i)),
+        error(magnitude(double(i)) >= 0x1p53 ? eps() * magnitude(double(i))
+                                             : 0.0) {}
+
+  constexpr fp_bound(double v, double e) noexcept : value(v), error(e) {}
+
+  /// Return true if the sign of the exact value is known.
+  bool certain() const noexcept {
+    return std::isfinite(value) && std::isfinite(error) &&
+           (std::fabs(value) > error || (value == 0.0 && error == 0.0));
+  }
+
+  /// Return the sign of the value (meaningful if certain())
+  int sign() const noexcept { return value < 0.0 ? -1 : (value > 0.0 ? 1 : 0); }
+
+  static constexpr double eps() noexcept { return 0x1p-52; }
+  static constexpr double inflate() noexcept { return 1.0 + 0x1p-50; }
+
+  /// Return |@a x| (std::fabs is not constexpr in C++17)
+  static constexpr double magnitude(double x) noexcept {
+    return x < 0.0 ? -x : x;
+  }
+};
+
+inline fp_bound operator+(const fp_bound &a, const fp_bound &b) noexcept {
+  const double v = a.value + b.value;
+  return fp_bound(v, (a.error + b.error + fp_bound::eps() * std::fabs(v)) *
+                         fp_bound::inflate());
+}
+
+inline fp_bound operator-(const fp_bound &a, const fp_bound &b) noexcept {
+  const double v = a.value - b.value;
+  return fp_bound(v, (a.error + b.error + fp_bound::eps() * std::fabs(v)) *
+                         fp_bound::inflate());
+}
+
+inline fp_bound operator*(const fp_bound &a, const fp_bound &b) noexcept {
+  const double v = a.value * b.value;
+  return fp_bound(v, (std::fabs(a.value) * b.error +
+                      std::fabs(b.value) * a.error + a.error * b.error +
+                      fp_bound::eps() * std::fabs(v) + 0x1p-1074) *
+                         fp_bound::inflate());
+}
+
+inline fp_bound operator-(const fp_bound &a) noexcept {
+  return fp_bound(-a.value, a.error);
+}
+
+namespace adaptive {
+
+namespace detail {
+
+/// Exact number type for the coordinates of type _K
+template <typename _K, class = void> struct exact_type {
+  typedef _K type; // already exact (e.g. rat<>)
+};
+
+template <typename _K>
+struct exact_type<_K, typename std::enable_if<std::is_integral<_K>::value>::type> {
+  typedef bigint type;
+};
+
+template <typename _K>
+struct exact_type<_K, typename std::enable_if<
+                          std::is_floating_point<_K>::value>::type> {
+  typedef dyadic<bigint> type;
+};
+
+template <typename _T, typename _K>
+inline point3<_T> rebind(const point3<_K> &p) {
+  return point3<_T>(_T(p.x()), _T(p.y()), _T(p.z()));
+}
+
+template <typename _T, typename _K>
+inline line3<_T> rebind(const line3<_K> &l) {
+  return line3<_T>(_T(l.a()), _T(l.b()), _T(l.c()));
+}
+
+} // namespace detail
+
+/**
+ *  Return the sign of @a expr(args...), a polynomial in the coordinates
+ *  of the points and lines @a args (all of the same coordinate type).
+ *
+ *  @a expr is a generic callable; it is called with fp_bound coordinates
+ *  first, and with exact ones only when that sign is uncertain.
+ */
+template <class _Fn, class _P0, class... _Ps>
+int sign(_Fn expr, const _P0 &p0, const _Ps &... ps) {
+  typedef typename std::decay<decltype(p0.e1())>::type _K;
+  if constexpr (std::is_arithmetic<_K>::value) {
+    const fp_bound r = expr(detail::rebind<fp_bound>(p0),
+                            detail::rebind<fp_bound>(ps)...);
+    if (r.certain())
+      return r.sign();
+  }
+  typedef typename detail::exact_type<_K>::type _E;
+  const _E r = expr(detail::rebind<_E>(p0), detail::rebind<_E>(ps)...);
+  return r < _E(0) ? -1 : (_E(0) < r ? 1 : 0);
+}
+
+/// Return true if the point @a p is incident with the line @a l.
+template <typename _K>
+inline bool incident(const point3<_K> &p, const line3<_K> &l) {
+  return sign([](const auto &x, const auto &m) { return dot(x, m); }, p,
+              l) == 0;
+}
+
+/// Return true if @a p and @a q are the same projective point
+/// (the cross product vanishes, points at infinity included).
+template <typename _K>
+inline bool equiv(const point3<_K> &p, const point3<_K> &q) {
+  return sign([](const auto &a, const auto &b) {
+           return a.y() * b.z() - a.z() * b.y(); }, p, q) == 0 &&
+         sign([](const auto &a, const auto &b) {
+           return a.z() * b.x() - a.x() * b.z(); }, p, q) == 0 &&
+         sign([](const auto &a, const auto &b) {
+           return a.x() * b.y() - a.y() * b.x(); }, p, q) == 0;
+}
+
+/// Return true if @a l and @a m are the same projective line.
+template <typename _K>
+inline bool equiv(const line3<_K> &l, const line3<_K> &m) {
+  return adaptive::equiv(point3<_K>(l.a(), l.b(), l.c()),
+               point3<_K>(m.a(), m.b(), m.c()));
+}
+
+///  Return true if @a a V ( @a b, @a c, @a d, @a e) are harmonic (p. 102)
+template <typename _K>
+inline bool harmonic(const point3<_K> &a, const point3<_K> &b,
+                     const point3<_K> &c, const point3<_K> &d,
+                     const point3<_K> &e) {
+  return sign([](const auto &a, const auto &b, const auto &c, const auto &d,
+                 const auto &e) {
+           auto ab = cross(a, b);
+           auto ac = cross(a, c);
+           return dot(ab, d) * dot(ac, e) + dot(ab, e) * dot(ac, d);
+         }, a, b, c, d, e) == 0;
+}
+
+///  Return true if @a a, @a b, @a c, @a d, @a e, @a f are on a conic (p. 102)
+template <typename _K>
+inline bool on_a_conic(const point3<_K> &a, const point3<_K> &b,
+                       const point3<_K> &c, const point3<_K> &d,
+                       const point3<_K> &e, const point3<_K> &f) {
+  return sign([](const auto &a, const auto &b, const auto &c, const auto &d,
+                 const auto &e, const auto &f) {
+           auto bc = cross(b, c);
+           auto ef = cross(e, f);
+           auto bf = cross(b, f);
+           auto ec = cross(e, c);
+           return dot(a, bc) * dot(a, ef) * dot(d, bf) * dot(d, ec) -
+                  dot(d, ef) * dot(d, bc) * dot(a, ec) * dot(a, bf);
+         }, a, b, c, d, e, f) == 0;
+}
+
+} // namespace adaptive
+
+/** @} */
+} // namespace fun
+
+#endif
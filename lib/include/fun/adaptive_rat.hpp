@@ -0,0 +1,410 @@
+#ifndef FUN_ADAPTIVE_RAT_HPP
+#define FUN_ADAPTIVE_RAT_HPP
+
+/**
+
+- Overflow-detecting companion of boost::rat<>
+- Features:
+  - Runs on std::int64_t as long as the results fit (native speed).
+  - Detects overflow with the checked-arithmetic builtins and then
+    promotes to a 128-bit integer, then to an arbitrary precision integer.
+  - Demotes back to the smallest tier whenever a result fits again.
+  - Same conventions as rat: den >= 0, NaN = 0/0, +-Inf = +-1/0,
+    no gcd() in the den1 == den2 case.
+
+**/
+
+#include <boost/multiprecision/cpp_int.hpp> // for cpp_int, multiprecision::gcd
+#include <boost/operators.hpp>              // for boost::ordered_field_operators
+#include <cstdint>                          // for std::int64_t
+#include <limits>                           // for std::numeric_limits
+#include <ostream>                          // for std::ostream
+#include <utility>                          // for std::move
+#include <variant>                          // for std::variant
+
+#include "gcd.hpp"              // for fun::fast_gcd, fun::int128_t
+#include "rat.hpp"              // for boost::rat
+#include "rational_compare.hpp" // for fun::compare_fractions
+
+namespace fun {
+
+namespace detail {
+
+#ifdef FUN_HAS_INT128
+typedef fun::int128_t adaptive_wide_int;
+#else
+// No native 128-bit type: the middle tier degenerates to a second try at
+// 64 bits before going to the arbitrary precision tier.
+typedef std::int64_t adaptive_wide_int;
+#endif
+typedef boost::multiprecision::cpp_int adaptive_big_int;
+
+/// Numerator/denominator pair of one tier
+template <typename _Z> struct adaptive_frac {
+  _Z num;
+  _Z den;
+};
+
+template <typename _Z> struct is_checked_int : std::is_integral<_Z> {};
+#ifdef FUN_HAS_INT128
+template <> struct is_checked_int<fun::int128_t> : std::true_type {};
+#endif
+
+/// Return true on overflow; @a r is only meaningful otherwise.
+template <typename _Z>
+inline bool add_overflow(const _Z &a, const _Z &b, _Z &r) {
+  if constexpr (is_checked_int<_Z>::value) {
+#if defined(__GNUC__) || defined(__clang__)
+    _Z t; // @a r may alias @a a or @a b
+    const bool o = __builtin_add_overflow(a, b, &t);
+    r = t;
+    return o;
+#else
+    if ((b > 0 && a > std::numeric_limits<_Z>::max() - b) ||
+        (b < 0 && a < std::numeric_limits<_Z>::min() - b))
+      return true;
+    r = a + b;
+    return false;
+#endif
+  } else {
+    r = a + b;
+    return false;
+  }
+}
+
+template <typename _Z>
+inline bool sub_overflow(const _Z &a, const _Z &b, _Z &r) {
+  if constexpr (is_checked_int<_Z>::value) {
+#if defined(__GNUC__) || defined(__clang__)
+    _Z t; // @a r may alias @a a or @a b
+    const bool o = __builtin_sub_overflow(a, b, &t);
+    r = t;
+    return o;
+#else
+    if ((b < 0 && a > std::numeric_limits<_Z>::max() + b) ||
+        (b > 0 && a < std::numeric_limits<_Z>::min() + b))
+      return true;
+    r = a - b;
+    return false;
+#endif
+  } else {
+    r = a - b;
+    return false;
+  }
+}
+
+template <typename _Z>
+inline bool mul_overflow(const _Z &a, const _Z &b, _Z &r) {
+  if constexpr (is_checked_int<_Z>::value) {
+#if defined(__GNUC__) || defined(__clang__)
+    _Z t; // @a r may alias @a a or @a b
+    const bool o = __builtin_mul_overflow(a, b, &t);
+    r = t;
+    return o;
+#else
+    if (a != 0 && b != 0) {
+      const _Z hi = std::numeric_limits<_Z>::max();
+      const _Z lo = std::numeric_limits<_Z>::min();
+      if ((a > 0 && b > 0 && a > hi / b) || (a < 0 && b < 0 && a < hi / b) ||
+          (a > 0 && b < 0 && b < lo / a) || (a < 0 && b > 0 && a < lo / b))
+        return true;
+    }
+    r = a * b;
+    return false;
+#endif
+  } else {
+    r = a * b;
+    return false;
+  }
+}
+
+template <typename _Z> inline _Z adaptive_gcd(const _Z &a, const _Z &b) {
+  return fun::fast_gcd(a, b);
+}
+
+inline adaptive_big_int adaptive_gcd(const adaptive_big_int &a,
+                                     const adaptive_big_int &b) {
+  return boost::multiprecision::gcd(a, b);
+}
+
+/// Make the denominator non-negative; false on overflow.
+template <typename _Z> inline bool fix_sign(adaptive_frac<_Z> &x) {
+  if (!(x.den < _Z(0)))
+    return true;
+  return !sub_overflow(_Z(0), x.num, x.num) &&
+         !sub_overflow(_Z(0), x.den, x.den);
+}
+
+/// Divide by the gcd and make the denominator positive.
+template <typename _Z> inline bool reduce(adaptive_frac<_Z> &x) {
+  if (x.den == _Z(0))
+    return true;
+  if (x.num == _Z(0)) {
+    x.den = _Z(1);
+    return true;
+  }
+  const _Z g = adaptive_gcd(x.num, x.den);
+  x.num /= g;
+  x.den /= g;
+  return fix_sign(x);
+}
+
+// Kernels: compute into @a x from @a x and @a y; return false (leaving
+// @a x unspecified) when the tier overflows.
+
+template <typename _Z>
+inline bool add_kernel(adaptive_frac<_Z> &x, const adaptive_frac<_Z> &y,
+                       bool negate) {
+  _Z y_num = y.num;
+  if (negate && sub_overflow(_Z(0), y_num, y_num))
+    return false;
+  if (x.den == y.den)
+    return !add_overflow(x.num, y_num, x.num);
+
+  // Same algorithm as rat::operator+=(): a/b + c/d with g = gcd(b,d)
+  _Z g = adaptive_gcd(x.den, y.den);
+  const _Z b1 = x.den / g;
+  _Z t1, t2;
+  if (mul_overflow(x.num, _Z(y.den / g), t1) || mul_overflow(y_num, b1, t2) ||
+      add_overflow(t1, t2, x.num))
+    return false;
+  g = adaptive_gcd(x.num, g);
+  x.num /= g;
+  return !mul_overflow(b1, _Z(y.den / g), x.den);
+}
+
+template <typename _Z>
+inline bool mul_kernel(adaptive_frac<_Z> &x, const adaptive_frac<_Z> &y) {
+  _Z n, d;
+  if (!mul_overflow(x.num, y.num, n) && !mul_overflow(x.den, y.den, d)) {
+    x.num = n;
+    x.den = d;
+    return true;
+  }
+  // Cross-reduce before giving up on this tier
+  const _Z g1 = adaptive_gcd(x.num, y.den);
+  const _Z g2 = adaptive_gcd(y.num, x.den);
+  if (g1 == _Z(0) || g2 == _Z(0))
+    return false;
+  return !mul_overflow(_Z(x.num / g1), _Z(y.num / g2), x.num) &&
+         !mul_overflow(_Z(x.den / g2), _Z(y.den / g1), x.den);
+}
+
+template <typename _Z>
+inline bool div_kernel(adaptive_frac<_Z> &x, const adaptive_frac<_Z> &y) {
+  adaptive_frac<_Z> r{y.den, y.num};
+  if (!fix_sign(r))
+    return false;
+  return mul_kernel(x, r) && fix_sign(x);
+}
+
+/// Three-way comparison; never overflows (see fun::compare_fractions).
+template <typename _Z>
+inline int cmp_kernel(const adaptive_frac<_Z> &x, const adaptive_frac<_Z> &y) {
+  return compare_fractions(x.num, x.den, y.num, y.den);
+}
+
+} // namespace detail
+} // namespace fun
+
+namespace boost {
+
+/**
+ *  Rational number that adapts its integer width to the magnitude of
+ *  the values: int64_t -> 128-bit -> arbitrary precision.
+ */
+class adaptive_rat
+    : ordered_field_operators<adaptive_rat> {
+public:
+  typedef std::int64_t small_int;
+  typedef fun::detail::adaptive_wide_int wide_int;
+  typedef fun::detail::adaptive_big_int big_int;
+
+  /// Integer tier currently used for the representation
+  enum tier_type { small_tier = 0, wide_tier = 1, big_tier = 2 };
+
+  adaptive_rat() : _rep{small_frac{0, 1}} {}
+  adaptive_rat(small_int n) : _rep{small_frac{n, 1}} {}
+  adaptive_rat(small_int n, small_int d) : _rep{small_frac{n, d}} {
+    normalize();
+  }
+
+  /// Construct from a boost::rat<> of any builtin integer type
+  template <typename IntType>
+  explicit adaptive_rat(const rat<IntType> &r)
+      : _rep{small_frac{0, 1}} {
+    assign_tier(fun::detail::adaptive_frac<big_int>{big_int(r.numerator()),
+                                               big_int(r.denominator())});
+  }
+
+  /// Return the current integer tier.
+  tier_type tier() const noexcept { return tier_type(_rep.index()); }
+
+  /// Return the numerator as an arbitrary precision integer.
+  big_int numerator() const {
+    return std::visit([](const auto &x) { return big_int(x.num); }, _rep);
+  }
+
+  /// Return the denominator as an arbitrary precision integer.
+  big_int denominator() const {
+    return std::visit([](const auto &x) { return big_int(x.den); }, _rep);
+  }
+
+  // Arithmetic assignment operators
+  adaptive_rat &operator+=(const adaptive_rat &r) {
+    apply(r, [](auto &x, const auto &y) { return add_kernel(x, y, false); });
+    return *this;
+  }
+
+  adaptive_rat &operator-=(const adaptive_rat &r) {
+    apply(r, [](auto &x, const auto &y) { return add_kernel(x, y, true); });
+    return *this;
+  }
+
+  adaptive_rat &operator*=(const adaptive_rat &r) {
+    apply(r, [](auto &x, const auto &y) { return mul_kernel(x, y); });
+    return *this;
+  }
+
+  adaptive_rat &operator/=(const adaptive_rat &r) {
+    apply(r, [](auto &x, const auto &y) { return div_kernel(x, y); });
+    return *this;
+  }
+
+  // Comparison operators
+  bool operator<(const adaptive_rat &r) const { return compare(r) < 0; }
+  bool operator==(const adaptive_rat &r) const { return compare(r) == 0; }
+
+  /// Bring to lowest terms (and to the smallest tier that fits).
+  void normalize() {
+    const bool ok = std::visit(
+        [](auto &x) {
+          auto y = x;
+          if (!fun::detail::reduce(y))
+            return false;
+          x = y;
+          return true;
+        },
+        _rep);
+    if (!ok) { // the sign flip of a minimum value overflowed
+      big_frac x = as<big_tier>();
+      fun::detail::reduce(x);
+      _rep = x;
+    }
+    demote();
+  }
+
+  /// Convert to a floating point value.
+  double to_double() const {
+    return std::visit(
+        [](const auto &x) {
+          return static_cast<double>(x.num) / static_cast<double>(x.den);
+        },
+        _rep);
+  }
+
+private:
+  typedef fun::detail::adaptive_frac<small_int> small_frac;
+  typedef fun::detail::adaptive_frac<wide_int> wide_frac;
+  typedef fun::detail::adaptive_frac<big_int> big_frac;
+  typedef std::variant<small_frac, wide_frac, big_frac> rep_type;
+
+  rep_type _rep;
+
+  /// Return this value widened to tier @a I.
+  template <std::size_t I>
+  std::variant_alternative_t<I, rep_type> as() const {
+    typedef decltype(std::variant_alternative_t<I, rep_type>::num) _Z;
+    return std::visit(
+        [](const auto &x) {
+          return std::variant_alternative_t<I, rep_type>{
+              static_cast<_Z>(x.num), static_cast<_Z>(x.den)};
+        },
+        _rep);
+  }
+
+  /// Apply @a kernel in the widest tier of both operands, promoting on
+  /// overflow.
+  template <class _Kernel>
+  void apply(const adaptive_rat &r, _Kernel kernel) {
+    if (_rep.index() == small_tier && r._rep.index() == small_tier) {
+      small_frac x = *std::get_if<small_tier>(&_rep);
+      if (kernel(x, *std::get_if<small_tier>(&r._rep))) {
+        *std::get_if<small_tier>(&_rep) = x;
+        return;
+      }
+    }
+    std::size_t t = _rep.index() > r._rep.index() ? _rep.index()
+                                                   : r._rep.index();
+    if (t <= wide_tier) {
+      wide_frac x = as<wide_tier>();
+      if (kernel(x, r.as<wide_tier>()) && fun::detail::reduce(x)) {
+        assign_tier(x);
+        return;
+      }
+    }
+    // Off the fast path the gcd is affordable, and it lets us demote.
+    big_frac x = as<big_tier>();
+    kernel(x, r.as<big_tier>());
+    fun::detail::reduce(x);
+    assign_tier(std::move(x));
+  }
+
+  int compare(const adaptive_rat &r) const {
+    if (_rep.index() == small_tier && r._rep.index() == small_tier)
+      return cmp_kernel(*std::get_if<small_tier>(&_rep),
+                        *std::get_if<small_tier>(&r._rep));
+    if (_rep.index() <= wide_tier && r._rep.index() <= wide_tier)
+      return cmp_kernel(as<wide_tier>(), r.as<wide_tier>());
+    return cmp_kernel(as<big_tier>(), r.as<big_tier>());
+  }
+
+  /// Store @a x in the smallest tier that can hold it.
+  template <typename _Z>
+  void assign_tier(fun::detail::adaptive_frac<_Z> x) {
+    if (fits<small_int>(x.num) && fits<small_int>(x.den))
+      _rep = small_frac{static_cast<small_int>(x.num),
+                        static_cast<small_int>(x.den)};
+    else if (fits<wide_int>(x.num) && fits<wide_int>(x.den))
+      _rep = wide_frac{static_cast<wide_int>(x.num),
+                       static_cast<wide_int>(x.den)};
+    else
+      _rep = big_frac{big_int(std::move(x.num)), big_int(std::move(x.den))};
+  }
+
+  void demote() {
+    if (_rep.index() == wide_tier)
+      assign_tier(*std::get_if<wide_tier>(&_rep));
+    else if (_rep.index() == big_tier)
+      assign_tier(*std::get_if<big_tier>(&_rep));
+  }
+
+  template <typename _T, typename _Z> static bool fits(const _Z &v) {
+    if constexpr (sizeof(_Z) <= sizeof(_T) && !std::is_class<_Z>::value)
+      return true;
+    else
+      return !(v < _Z(std::numeric_limits<_T>::min())) &&
+             !(_Z(std::numeric_limits<_T>::max()) < v);
+  }
+};
+
+/// Return true if @a r is not a number (0/0).
+inline bool is_NaN(const adaptive_rat &r) {
+  return r.denominator() == 0 && r.numerator() == 0;
+}
+
+template <typename T> inline T rat_cast(const adaptive_rat &src) {
+  return static_cast<T>(src.to_double());
+}
+
+inline adaptive_rat operator-(const adaptive_rat &r) {
+  return adaptive_rat(0) -= r;
+}
+
+inline std::ostream &operator<<(std::ostream &os, const adaptive_rat &r) {
+  return os << r.numerator() << '/' << r.denominator();
+}
+
+} // namespace boost
+
+#endif // FUN_ADAPTIVE_RAT_HPP
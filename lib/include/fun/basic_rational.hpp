@@ -0,0 +1,607 @@
+// The template and inlines for the -*- C++ -*- rational number classes.
+// Initially implemented by Wai-Shing Luk <luk036@gmail.com>
+//
+
+/** @file include/basic_rational.hpp
+ *  This is a C++ Library header.
+ */
+
+#ifndef FUN_BASIC_RATIONAL_HPP
+#define FUN_BASIC_RATIONAL_HPP 1
+
+#include <boost/operators.hpp>
+#include <cstddef>     // for std::size_t
+#include <functional>  // for std::hash
+#include <iomanip>     // for std::setw
+#include <istream>     // for std::istream
+#include <limits>      // for std::numeric_limits
+#include <sstream>     // for std::ostringstream
+#include <string>
+#include <type_traits> // for std::is_same, std::common_type
+
+#include "gcd.hpp"              // for fun::fast_gcd
+#include "rational_compare.hpp" // for fun::compare_fractions
+
+namespace fun {
+/**
+ * @defgroup rational (extended) Rational Number
+ * @ingroup arithmetic
+ *
+ * Classes and functions for (extended) rational number.
+ * Both fun::rational<> (rational.hpp) and boost::rat<> (rat.hpp) are
+ * aliases of basic_rational<> with a different normalization policy.
+ *
+ * Conventions shared by all policies:
+ *  - the denominator is never negative,
+ *  - 0/0 is NaN, n/0 is +Inf or -Inf depending on the sign of n,
+ *  - equal denominators are checked first (no gcd() at all).
+ *
+ * The policy also selects the text format (member parenthesized):
+ * fun::rational prints "n", "(n/d)", "Inf", "-Inf" or "NaN", boost::rat
+ * prints "n/d" at all times (n/0 and 0/0 included). operator>> reads
+ * "n", "n/d" and "(n/d)".
+ * @{
+ */
+
+namespace detail {
+/// Return 2^n in the integer type _Z
+template <typename _Z> inline constexpr _Z pow2(int n) {
+  _Z r(1);
+  for (; n != 0; --n)
+    r = r + r;
+  return r;
+}
+} // namespace detail
+
+/**
+ *  Normalize after every operation (lowest terms at all times).
+ *
+ *  Equality is then a comparison of the components, and additions use
+ *  the gcd of the denominators only.
+ */
+struct eager_normalize {
+  static constexpr bool canonical = true;
+  static constexpr bool on_construct = true;
+  static constexpr bool parenthesized = true;
+
+  template <typename _Z>
+  static constexpr bool needs_reduce(const _Z &, const _Z &) noexcept {
+    return true;
+  }
+};
+
+/**
+ *  Normalize lazily: on construction, on print or hash (of a copy), and
+ *  whenever the numerator or the denominator exceeds 2^Bits.
+ *
+ *  @param  Bits  Magnitude threshold; 0 means half of the digits of the
+ *                integer type (256 bits for unbounded types).
+ */
+template <int _Bits = 0> struct lazy_normalize {
+  static constexpr bool canonical = false;
+  static constexpr bool on_construct = true;
+  static constexpr bool parenthesized = false;
+
+  template <typename _Z>
+  static bool needs_reduce(const _Z &n, const _Z &d) noexcept {
+    typedef std::numeric_limits<_Z> _L;
+    constexpr int bits =
+        _Bits != 0 ? _Bits : (_L::is_bounded ? _L::digits / 2 : 256);
+    static const _Z limit = detail::pow2<_Z>(bits);
+    return limit < d || limit < n || n < -limit;
+  }
+};
+
+/**
+ *  Never normalize, apart from keeping the denominator non-negative.
+ *
+ *  Meant for dyadic or fixed-denominator use, where the denominators
+ *  stay equal and the den1 == den2 fast path is always taken.
+ */
+struct never_normalize {
+  static constexpr bool canonical = false;
+  static constexpr bool on_construct = false;
+  static constexpr bool parenthesized = false;
+
+  template <typename _Z>
+  static constexpr bool needs_reduce(const _Z &, const _Z &) noexcept {
+    return false;
+  }
+};
+
+/// Tag to construct a rational number from its raw components
+struct unnormalized_t {};
+constexpr unnormalized_t unnormalized{};
+
+// Forward declarations.
+template <typename _Z, class _Policy> struct basic_rational;
+
+/**
+ *  Rational number with a selectable normalization policy.
+ *
+ *  @param  _Z       Type of rational number elements (integer-like)
+ *  @param  _Policy  eager_normalize, lazy_normalize<> or never_normalize
+ */
+template <typename _Z, class _Policy = eager_normalize>
+struct basic_rational
+    : boost::ordered_field_operators<
+          basic_rational<_Z, _Policy>,
+          boost::ordered_field_operators2<basic_rational<_Z, _Policy>, _Z>> {
+  static_assert(std::numeric_limits<_Z>::is_specialized,
+                "basic_rational<> requires an integer-like type");
+
+  /// Value typedef.
+  typedef _Z value_type;
+  typedef _Z int_type;
+  typedef _Policy policy_type;
+
+  /// Default constructor.
+  constexpr basic_rational() : _num(0), _den(1) {}
+
+  /// Construct from an integer @a n.
+  constexpr basic_rational(const _Z &n) : _num(n), _den(1) {}
+
+  /// Construct from @a n / @a d.
+  basic_rational(const _Z &n, const _Z &d) : _num(n), _den(d) {
+    if (_Policy::on_construct)
+      normalize();
+    else
+      fix_sign();
+  }
+
+  /// Construct from raw components (den >= 0) without normalization.
+  constexpr basic_rational(const _Z &n, const _Z &d, unnormalized_t)
+      : _num(n), _den(d) {}
+
+  /// Converting constructor
+  template <typename _Up, class _Q>
+  explicit basic_rational(const basic_rational<_Up, _Q> &s)
+      : _num(s.num()), _den(s.denom()) {
+    if (_Policy::canonical && !_Q::canonical)
+      normalize();
+  }
+
+  // Lets the compiler synthesize the copy constructor and assignment
+
+  /// Assign this rational number to rational number @a s.
+  template <typename _Up, class _Q>
+  basic_rational &operator=(const basic_rational<_Up, _Q> &s) {
+    return *this = basic_rational(s);
+  }
+
+  /// Assign from an integer @a i.
+  basic_rational &operator=(const _Z &i) {
+    _num = i;
+    _den = _Z(1);
+    return *this;
+  }
+
+  /// Assign in place
+  basic_rational &assign(const _Z &n, const _Z &d) {
+    return *this = basic_rational(n, d);
+  }
+
+  /// Return first element of rational number.
+  constexpr _Z num() const { return _num; }
+
+  /// Return second element of rational number.
+  constexpr _Z denom() const { return _den; }
+
+  /// Return first element of rational number (boost naming).
+  constexpr _Z numerator() const { return _num; }
+
+  /// Return second element of rational number (boost naming).
+  constexpr _Z denominator() const { return _den; }
+
+  /// Increase this rational number (prefix operator)
+  basic_rational &operator++() {
+    _num += _den;
+    return *this;
+  }
+
+  /// Decrease this rational number (prefix operator)
+  basic_rational &operator--() {
+    _num -= _den;
+    return *this;
+  }
+
+  /// Increase this rational number (postfix operator)
+  basic_rational operator++(int) {
+    basic_rational res(*this);
+    ++(*this);
+    return res;
+  }
+
+  /// Decrease this rational number (postfix operator)
+  basic_rational operator--(int) {
+    basic_rational res(*this);
+    --(*this);
+    return res;
+  }
+
+  /// Add @a a to this rational number (gcd(n + a*d, d) == gcd(n, d)).
+  basic_rational &operator+=(const _Z &a) {
+    _num += _den * a;
+    return _Policy::canonical ? *this : update();
+  }
+
+  /// Subtract @a a from this rational number.
+  basic_rational &operator-=(const _Z &a) {
+    _num -= _den * a;
+    return _Policy::canonical ? *this : update();
+  }
+
+  /// Multiply this rational number by @a a.
+  basic_rational &operator*=(const _Z &a) {
+    if (!_Policy::canonical) {
+      _num *= a;
+      return update();
+    }
+    if (a == _Z(0) && _den == _Z(0)) { // Inf * 0
+      _num = _Z(0);
+      return *this;
+    }
+    // Avoid overflow and preserve normalization
+    const _Z g = fast_gcd(a, _den);
+    _num *= a / g;
+    _den /= g;
+    return *this;
+  }
+
+  /// Divide this rational number by @a a.
+  basic_rational &operator/=(const _Z &a) {
+    if (!_Policy::canonical) {
+      _den *= a;
+      fix_sign();
+      return update();
+    }
+    if (a == _Z(0) && _num == _Z(0)) { // 0 / 0
+      _den = _Z(0);
+      return *this;
+    }
+    const _Z g = fast_gcd(_num, a);
+    _num /= g;
+    _den *= a / g;
+    fix_sign();
+    return *this;
+  }
+
+  /// Add @a s to this rational number.
+  basic_rational &operator+=(const basic_rational &s) {
+    return add(s._num, s._den);
+  }
+
+  /// Subtract @a s from this rational number.
+  basic_rational &operator-=(const basic_rational &s) {
+    return add(-s._num, s._den);
+  }
+
+  /// Multiply @a s to this rational number.
+  basic_rational &operator*=(const basic_rational &s) {
+    // Protect against self-modification
+    const _Z s_num = s._num, s_den = s._den;
+    if (_Policy::canonical) {
+      // Avoid overflow and preserve normalization
+      const _Z g1 = fast_gcd(_num, s_den);
+      const _Z g2 = fast_gcd(s_num, _den);
+      if (g1 != _Z(0) && g2 != _Z(0)) {
+        _num = (_num / g1) * (s_num / g2);
+        _den = (_den / g2) * (s_den / g1);
+        return *this;
+      }
+    } else if (_num == s_den && _num != _Z(0)) { // a/b * c/a
+      _num = s_num;
+      return *this;
+    } else if (_den == s_num && _den != _Z(0)) { // a/b * b/d
+      _den = s_den;
+      return *this;
+    }
+    _num *= s_num;
+    _den *= s_den;
+    return update();
+  }
+
+  /// Divide @a s to this rational number.
+  basic_rational &operator/=(const basic_rational &s) {
+    basic_rational r(s._den, s._num, unnormalized);
+    r.fix_sign();
+    return *this *= r;
+  }
+
+  /// Return true if this rational number is zero.
+  constexpr bool operator!() const { return _num == _Z(0); }
+
+  /// Return true if this rational number is not zero.
+  explicit constexpr operator bool() const { return _num != _Z(0); }
+
+  /// Cast to double
+  explicit operator double() const {
+    return static_cast<double>(_num) / static_cast<double>(_den);
+  }
+
+  /// Return true if this rational number is less than @a i.
+  bool operator<(const _Z &i) const {
+    return compare_fractions(_num, _den, i, _Z(1)) < 0;
+  }
+
+  /// Return true if this rational number is greater than @a i.
+  bool operator>(const _Z &i) const {
+    return compare_fractions(_num, _den, i, _Z(1)) > 0;
+  }
+
+  /// Return true if this rational number is equal to @a i.
+  bool operator==(const _Z &i) const {
+    return compare_fractions(_num, _den, i, _Z(1)) == 0;
+  }
+
+  /// Bring this rational number to lowest terms.
+  void normalize() {
+    if (_den == _Z(0))
+      return;
+    // Handle the case of zero separately, to avoid division by zero
+    if (_num == _Z(0)) {
+      _den = _Z(1);
+      return;
+    }
+    const _Z g = fast_gcd(_num, _den);
+    _num /= g;
+    _den /= g;
+    fix_sign();
+  }
+
+private:
+  /// Ensure that the denominator is non-negative
+  void fix_sign() {
+    if (_den < _Z(0)) {
+      _num = -_num;
+      _den = -_den;
+    }
+  }
+
+  /// Apply the normalization policy after an operation.
+  basic_rational &update() {
+    if (_Policy::needs_reduce(_num, _den))
+      normalize();
+    return *this;
+  }
+
+  /// Add @a s_num / @a s_den to this rational number.
+  basic_rational &add(const _Z &s_num, const _Z &s_den) {
+    if (_den == s_den) {
+      _num += s_num;
+      return update();
+    }
+    if (!_Policy::canonical) {
+      _num = _num * s_den + s_num * _den;
+      _den *= s_den;
+      return update();
+    }
+    // This calculation avoids overflow, and minimises the number of
+    // expensive calculations (Nickolay Mladenov, see boost::rational):
+    // with g = gcd(b,d), b = b1*g, d = d1*g,
+    // a/b + c/d = (a*d1 + c*b1) / (b1*d1*g), and
+    // gcd(a*d1 + c*b1, b1*d1*g) = gcd(a*d1 + c*b1, g).
+    _Z g = fast_gcd(_den, s_den);
+    _den /= g; // = b1 from the calculations above
+    _num = _num * (s_den / g) + s_num * _den;
+    g = fast_gcd(_num, g);
+    _num /= g;
+    _den *= s_den / g;
+    return *this;
+  }
+
+  _Z _num;
+  _Z _den;
+};
+
+// Operators:
+///  Return new rational number @a r plus @a s.
+template <typename _Z, class _P, typename _Up, class _Q>
+inline auto operator+(const basic_rational<_Z, _P> &r,
+                      const basic_rational<_Up, _Q> &s)
+    -> basic_rational<decltype(r.num() * s.denom()), _P> {
+  typedef basic_rational<decltype(r.num() * s.denom()), _P> _R;
+  _R res(r);
+  return res += _R(s);
+}
+
+///  Return new rational number @a r minus @a s.
+template <typename _Z, class _P, typename _Up, class _Q>
+inline auto operator-(const basic_rational<_Z, _P> &r,
+                      const basic_rational<_Up, _Q> &s)
+    -> basic_rational<decltype(r.num() * s.denom()), _P> {
+  typedef basic_rational<decltype(r.num() * s.denom()), _P> _R;
+  _R res(r);
+  return res -= _R(s);
+}
+
+///  Return new rational number @a r times @a s.
+template <typename _Z, class _P, typename _Up, class _Q>
+inline auto operator*(const basic_rational<_Z, _P> &r,
+                      const basic_rational<_Up, _Q> &s)
+    -> basic_rational<decltype(r.num() * s.num()), _P> {
+  typedef basic_rational<decltype(r.num() * s.num()), _P> _R;
+  _R res(r);
+  return res *= _R(s);
+}
+
+///  Return new rational number @a r divided by @a s.
+template <typename _Z, class _P, typename _Up, class _Q>
+inline auto operator/(const basic_rational<_Z, _P> &r,
+                      const basic_rational<_Up, _Q> &s)
+    -> basic_rational<decltype(r.num() * s.num()), _P> {
+  typedef basic_rational<decltype(r.num() * s.num()), _P> _R;
+  _R res(r);
+  return res /= _R(s);
+}
+
+/// Return @a r.
+template <typename _Z, class _P>
+inline constexpr basic_rational<_Z, _P>
+operator+(const basic_rational<_Z, _P> &r) {
+  return r;
+}
+
+/// Return negation of @a r
+template <typename _Z, class _P>
+inline constexpr basic_rational<_Z, _P>
+operator-(const basic_rational<_Z, _P> &r) {
+  return basic_rational<_Z, _P>(-r.num(), r.denom(), unnormalized);
+}
+
+/// Return true if @a r is equal to @a s.
+template <typename _Z, class _P, typename _Up, class _Q>
+inline bool operator==(const basic_rational<_Z, _P> &r,
+                       const basic_rational<_Up, _Q> &s) {
+  if (r.denom() == s.denom())
+    return r.num() == s.num();
+  if (_P::canonical && _Q::canonical)
+    return false;
+  typedef typename std::common_type<_Z, _Up>::type _C;
+  return compare_fractions<_C>(r.num(), r.denom(), s.num(), s.denom()) == 0;
+}
+
+/// Return false if @a r is equal to @a s.
+template <typename _Z, class _P, typename _Up, class _Q>
+inline bool operator!=(const basic_rational<_Z, _P> &r,
+                       const basic_rational<_Up, _Q> &s) {
+  return !(r == s);
+}
+
+/// Return true if @a r is less than @a s.
+template <typename _Z, class _P, typename _Up, class _Q>
+inline bool operator<(const basic_rational<_Z, _P> &r,
+                      const basic_rational<_Up, _Q> &s) {
+  typedef typename std::common_type<_Z, _Up>::type _C;
+  return compare_fractions<_C>(r.num(), r.denom(), s.num(), s.denom()) < 0;
+}
+
+/// Return true if @a r is not a number (0/0).
+template <typename _Z, class _P>
+inline constexpr bool is_NaN(const basic_rational<_Z, _P> &r) {
+  return r.denom() == _Z(0) && r.num() == _Z(0);
+}
+
+/// Return the absolute value of @a r.
+template <typename _Z, class _P>
+inline basic_rational<_Z, _P> abs(const basic_rational<_Z, _P> &r) {
+  return r.num() < _Z(0) ? -r : r;
+}
+
+/// Type conversion
+template <typename T, typename _Z, class _P>
+inline constexpr T rat_cast(const basic_rational<_Z, _P> &src) {
+  return static_cast<T>(src.num()) / static_cast<T>(src.denom());
+}
+
+///  Insertion operator for rational number values (lowest terms), in the
+///  format of the policy (see above). The "n/d" format honours the width
+///  and the showpos, internal and showbase flags, which apply to n.
+template <typename _Z, class _P, class _Stream>
+_Stream &operator<<(_Stream &os, const basic_rational<_Z, _P> &r) {
+  basic_rational<_Z, _P> c(r);
+  if (!_P::canonical)
+    c.normalize();
+  const auto &a = c.num();
+  const auto &b = c.denom();
+  if constexpr (!_P::parenthesized) {
+    if constexpr (std::is_base_of<std::ios_base, _Stream>::value) {
+      // The slash directly precedes the denominator, which has no prefixes.
+      std::ostringstream ss;
+      ss.copyfmt(os);
+      ss.tie(nullptr);
+      ss.exceptions(std::ios::goodbit);
+      ss.width(0);
+      ss << std::noshowpos << std::noshowbase << '/' << b;
+      const std::string tail = ss.str();
+      const std::streamsize w =
+          os.width() - static_cast<std::streamsize>(tail.size());
+      ss.clear();
+      ss.str("");
+      ss.flags(os.flags());
+      ss << std::setw(w < 0 || (os.flags() & std::ios::adjustfield) !=
+                                   std::ios::internal
+                          ? 0
+                          : w)
+         << a;
+      os << ss.str() + tail;
+    } else {
+      os << a << '/' << b;
+    }
+    return os;
+  }
+  _Z zero(0), one(1);
+  if (b == one) {
+    os << a;
+    return os;
+  }
+  if (b != zero) {
+    os << '(' << a << '/' << b << ')';
+    return os;
+  }
+  if (a < zero) {
+    os << "-Inf";
+    return os;
+  }
+  if (a > zero) {
+    os << "Inf";
+    return os;
+  }
+  os << "NaN";
+  return os;
+}
+
+/// A utility class to reset the format flags for an istream at end
+/// of scope, even in case of exceptions
+struct rational_resetter {
+  rational_resetter(std::istream &is) : is_(is), f_(is.flags()) {}
+  ~rational_resetter() { is_.flags(f_); }
+  std::istream &is_;
+  std::istream::fmtflags f_;
+};
+
+///  Extraction operator for rational number values ("n", "n/d" or
+///  "(n/d)"). On failure @a r is left unchanged.
+template <typename _Z, class _P>
+std::istream &operator>>(std::istream &is, basic_rational<_Z, _P> &r) {
+  _Z n = _Z(0), d = _Z(1);
+  rational_resetter sentry(is);
+
+  const bool paren = (is >> std::ws).peek() == '(';
+  if (paren)
+    is.get();
+  if (!(is >> n))
+    return is;
+  if (!is.eof() && is.peek() == '/') {
+    is.get();
+    if (!(is >> std::noskipws >> d))
+      return is;
+  } else if (paren) {
+    is.setstate(std::ios::failbit);
+    return is;
+  }
+  if (paren && is.get() != ')') {
+    is.setstate(std::ios::failbit);
+    return is;
+  }
+  r.assign(n, d);
+  return is;
+}
+
+/** @} */
+} // namespace fun
+
+namespace std {
+/// Hash of the lowest terms, so that equal values hash equally.
+template <typename _Z, class _P> struct hash<fun::basic_rational<_Z, _P>> {
+  std::size_t operator()(const fun::basic_rational<_Z, _P> &r) const {
+    fun::basic_rational<_Z, _P> c(r);
+    if (!_P::canonical)
+      c.normalize();
+    const std::size_t h = std::hash<_Z>()(c.num());
+    return h ^ (std::hash<_Z>()(c.denom()) + 0x9e3779b9 + (h << 6) + (h >> 2));
+  }
+};
+} // namespace std
+
+#endif
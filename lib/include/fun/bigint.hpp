@@ -0,0 +1,695 @@
+// The inlines for the -*- C++ -*- arbitrary-precision integer class.
+// Initially implemented by Wai-Shing Luk <luk036@gmail.com>
+//
+
+/** @file include/bigint.hpp
+ *  This is a C++ Library header.
+ */
+
+#ifndef FUN_BIGINT_HPP
+#define FUN_BIGINT_HPP 1
+
+#include <algorithm> // for std::fill
+#include <boost/operators.hpp>
+#include <cassert>
+#include <cctype>    // for std::isdigit
+#include <cmath>       // for std::ldexp
+#include <cstddef>     // for std::size_t
+#include <cstdint>     // for std::uint64_t
+#include <cstring>     // for std::memcpy
+#include <functional>  // for std::hash
+#include <istream>     // for std::istream
+#include <limits>      // for std::numeric_limits
+#include <string>      // for std::string
+#include <type_traits> // for std::enable_if
+#include <utility>     // for std::swap
+#include <vector>      // for std::vector
+
+#include "gcd.hpp" // for fun::uint128_t, fun::lehmer_gcd, fun::bit_length
+
+#ifndef FUN_HAS_INT128
+#error "bigint.hpp requires a compiler with a 128-bit integer type"
+#endif
+
+namespace fun {
+
+namespace detail {
+/// Built-in integer types (including the 128-bit ones), but not bool
+template <typename _I>
+struct is_builtin_int
+    : std::integral_constant<bool, std::is_integral<_I>::value &&
+                                       !std::is_same<_I, bool>::value> {};
+template <> struct is_builtin_int<int128_t> : std::true_type {};
+template <> struct is_builtin_int<uint128_t> : std::true_type {};
+} // namespace detail
+
+/**
+ * @defgroup bigint Arbitrary-precision Integer
+ * @ingroup arithmetic
+ *
+ * Sign-magnitude integer of 64-bit limbs. Up to two limbs (128 bits)
+ * are stored inline, so that exact predicates on moderately sized
+ * coordinates do not allocate; longer values spill to the heap.
+ * As for the built-in integer types, division truncates toward zero and
+ * the right shift rounds toward negative infinity.
+ * @{
+ */
+
+/**
+ *  Arbitrary-precision integer with a small inline buffer.
+ *
+ *  Usable as the integer type of rat<>, rational<>, dyadic<> and as the
+ *  element type of vector3<>.
+ */
+class bigint
+    : boost::ordered_euclidean_ring_operators1<
+          bigint, boost::shiftable2<bigint, int, boost::unit_steppable<bigint>>> {
+public:
+  typedef std::uint64_t limb_type;
+
+  /// Number of limbs stored without allocation
+  static constexpr std::uint32_t inline_limbs = 2;
+
+  /// Default constructor (zero).
+  bigint() noexcept : _size(0), _cap(inline_limbs), _neg(false) {
+    _small[0] = _small[1] = 0;
+  }
+
+  /// Construct from a built-in (or 128-bit) integer @a v.
+  template <typename _I, class = typename std::enable_if<
+                             detail::is_builtin_int<_I>::value>::type>
+  bigint(_I v) noexcept : bigint() {
+    _neg = v < _I(0);
+    const auto u = detail::uabs(v);
+    _small[0] = limb_type(u);
+    if constexpr (sizeof(_I) > 8)
+      _small[1] = limb_type(u >> 64);
+    _size = inline_limbs;
+    trim();
+  }
+
+  /// Construct from a decimal string with an optional sign.
+  explicit bigint(const char *s) : bigint() {
+    const bool neg = *s == '-';
+    if (*s == '-' || *s == '+')
+      ++s;
+    for (; *s >= '0' && *s <= '9';) {
+      limb_type chunk = 0, scale = 1;
+      for (int i = 0; i < 19 && *s >= '0' && *s <= '9'; ++i, ++s) {
+        chunk = chunk * 10 + limb_type(*s - '0');
+        scale *= 10;
+      }
+      mul_add(scale, chunk);
+    }
+    _neg = neg && _size != 0;
+  }
+
+  /// Copy constructor
+  bigint(const bigint &o) : bigint() {
+    reserve(o._size, false);
+    std::memcpy(data(), o.data(), sizeof(limb_type) * o._size);
+    _size = o._size;
+    _neg = o._neg;
+  }
+
+  /// Move constructor
+  bigint(bigint &&o) noexcept : _size(o._size), _cap(o._cap), _neg(o._neg) {
+    if (o.is_inline()) {
+      _small[0] = o._small[0];
+      _small[1] = o._small[1];
+    } else {
+      _heap = o._heap;
+      o._cap = inline_limbs;
+    }
+    o._size = 0;
+    o._neg = false;
+  }
+
+  /// Copy assignment
+  bigint &operator=(const bigint &o) {
+    if (this != &o) {
+      reserve(o._size, false);
+      std::memcpy(data(), o.data(), sizeof(limb_type) * o._size);
+      _size = o._size;
+      _neg = o._neg;
+    }
+    return *this;
+  }
+
+  /// Move assignment
+  bigint &operator=(bigint &&o) noexcept {
+    if (this != &o) {
+      release();
+      _size = o._size;
+      _cap = o._cap;
+      _neg = o._neg;
+      if (o.is_inline()) {
+        _small[0] = o._small[0];
+        _small[1] = o._small[1];
+      } else {
+        _heap = o._heap;
+        o._cap = inline_limbs;
+      }
+      o._size = 0;
+      o._neg = false;
+    }
+    return *this;
+  }
+
+  ~bigint() { release(); }
+
+  /// Return true if the value is stored without heap allocation.
+  bool is_inline() const noexcept { return _cap <= inline_limbs; }
+
+  /// Return the number of limbs of the magnitude.
+  std::size_t size() const noexcept { return _size; }
+
+  /// Return the limbs of the magnitude (least significant first).
+  const limb_type *limbs() const noexcept { return data(); }
+
+  /// Return -1, 0 or 1.
+  int sign() const noexcept { return _size == 0 ? 0 : (_neg ? -1 : 1); }
+
+  /// Add @a b to this integer.
+  bigint &operator+=(const bigint &b) { return add(b, b._neg); }
+
+  /// Subtract @a b from this integer.
+  bigint &operator-=(const bigint &b) { return add(b, !b._neg); }
+
+  /// Multiply this integer by @a b.
+  bigint &operator*=(const bigint &b) {
+    if (_size == 0 || b._size == 0)
+      return *this = bigint();
+    const bool neg = _neg != b._neg;
+    if (_size == 1 && b._size == 1) {
+      const uint128_t p = uint128_t(data()[0]) * b.data()[0];
+      data()[0] = limb_type(p);
+      data()[1] = limb_type(p >> 64); // _cap >= 2 always
+      _size = 2;
+      _neg = neg;
+      trim();
+      return *this;
+    }
+    bigint r;
+    r.reserve(_size + b._size, false);
+    limb_type *z = r.data();
+    const limb_type *x = data(), *y = b.data();
+    std::fill(z, z + _size + b._size, limb_type(0));
+    for (std::uint32_t i = 0; i < _size; ++i) {
+      limb_type carry = 0;
+      for (std::uint32_t j = 0; j < b._size; ++j) {
+        const uint128_t t = uint128_t(x[i]) * y[j] + z[i + j] + carry;
+        z[i + j] = limb_type(t);
+        carry = limb_type(t >> 64);
+      }
+      z[i + b._size] = carry;
+    }
+    r._size = _size + b._size;
+    r._neg = neg;
+    r.trim();
+    return *this = std::move(r);
+  }
+
+  /// Divide this integer by @a b (truncating toward zero).
+  bigint &operator/=(const bigint &b) {
+    bigint q;
+    divmod(*this, b, &q, nullptr);
+    return *this = std::move(q);
+  }
+
+  /// Replace this integer by the remainder of the division by @a b.
+  bigint &operator%=(const bigint &b) {
+    bigint r;
+    divmod(*this, b, nullptr, &r);
+    return *this = std::move(r);
+  }
+
+  /// Multiply the magnitude by 2^k.
+  bigint &operator<<=(int k) {
+    if (_size == 0 || k <= 0)
+      return k < 0 ? *this >>= -k : *this;
+    const std::uint32_t w = std::uint32_t(k) / 64, s = std::uint32_t(k) % 64;
+    const std::uint32_t n = _size;
+    reserve(n + w + 1);
+    limb_type *r = data();
+    r[n + w] = s == 0 ? 0 : r[n - 1] >> (64 - s);
+    for (std::uint32_t i = n - 1; i > 0; --i)
+      r[i + w] = s == 0 ? r[i] : (r[i] << s) | (r[i - 1] >> (64 - s));
+    r[w] = r[0] << s;
+    std::fill(r, r + w, limb_type(0));
+    _size = n + w + 1;
+    trim();
+    return *this;
+  }
+
+  /// Divide this integer by 2^k, rounding toward negative infinity like
+  /// the built-in arithmetic shift (bigint(-3) >> 1 == -2).
+  bigint &operator>>=(int k) {
+    if (_size == 0 || k <= 0)
+      return k < 0 ? *this <<= -k : *this;
+    const std::uint32_t w = std::uint32_t(k) / 64, s = std::uint32_t(k) % 64;
+    if (w >= _size)
+      return *this = _neg ? bigint(-1) : bigint();
+    limb_type *r = data();
+    // a negative value whose shifted-out bits are not all zero takes one
+    // more step down
+    bool inexact = _neg && s != 0 && (r[w] & ((limb_type(1) << s) - 1)) != 0;
+    for (std::uint32_t i = 0; _neg && !inexact && i < w; ++i)
+      inexact = r[i] != 0;
+    const std::uint32_t n = _size - w;
+    for (std::uint32_t i = 0; i < n; ++i) {
+      limb_type v = r[i + w] >> s;
+      if (s != 0 && i + w + 1 < _size)
+        v |= r[i + w + 1] << (64 - s);
+      r[i] = v;
+    }
+    _size = n;
+    trim();
+    return inexact ? --*this : *this;
+  }
+
+  /// Increase this integer (prefix operator)
+  bigint &operator++() { return *this += bigint(1); }
+
+  /// Decrease this integer (prefix operator)
+  bigint &operator--() { return *this -= bigint(1); }
+
+  /// Return the negation of this integer.
+  bigint operator-() const {
+    bigint r(*this);
+    r._neg = !_neg && _size != 0;
+    return r;
+  }
+
+  /// Return this integer.
+  bigint operator+() const { return *this; }
+
+  /// Return true if this integer is zero.
+  bool operator!() const noexcept { return _size == 0; }
+
+  /// Return true if this integer is not zero.
+  explicit operator bool() const noexcept { return _size != 0; }
+
+  /// Convert to a built-in integer (modulo 2^N, like the unsigned types).
+  template <typename _I, class = typename std::enable_if<
+                             detail::is_builtin_int<_I>::value>::type>
+  explicit operator _I() const noexcept {
+    uint128_t u = _size == 0 ? 0 : data()[0];
+    if (_size > 1)
+      u |= uint128_t(data()[1]) << 64;
+    if (_neg)
+      u = uint128_t(0) - u;
+    return _I(u);
+  }
+
+  /// Convert to double.
+  explicit operator double() const noexcept {
+    if (_size == 0)
+      return 0.0;
+    const limb_type *x = data();
+    double d = double(x[_size - 1]);
+    if (_size > 1)
+      d = std::ldexp(d, 64) + double(x[_size - 2]);
+    if (_size > 2)
+      d = std::ldexp(d, 64 * int(_size - 2));
+    return _neg ? -d : d;
+  }
+
+  /// Return true if @a a is less than @a b.
+  friend bool operator<(const bigint &a, const bigint &b) noexcept {
+    if (a._neg != b._neg)
+      return a._neg;
+    const int c = compare_magnitude(a, b);
+    return a._neg ? c > 0 : c < 0;
+  }
+
+  /// Return true if @a a is equal to @a b.
+  friend bool operator==(const bigint &a, const bigint &b) noexcept {
+    return a._neg == b._neg && compare_magnitude(a, b) == 0;
+  }
+
+  /// Return the decimal representation.
+  std::string to_string() const {
+    if (_size == 0)
+      return "0";
+    constexpr limb_type base = 10000000000000000000ULL; // 10^19
+    std::vector<limb_type> x(data(), data() + _size);
+    std::vector<limb_type> chunks;
+    while (!x.empty()) {
+      chunks.push_back(div_small(x.data(), std::uint32_t(x.size()), base));
+      while (!x.empty() && x.back() == 0)
+        x.pop_back();
+    }
+    std::string s = _neg ? "-" : "";
+    s += std::to_string(chunks.back());
+    for (std::size_t i = chunks.size() - 1; i-- > 0;) {
+      const std::string t = std::to_string(chunks[i]);
+      s.append(19 - t.size(), '0');
+      s += t;
+    }
+    return s;
+  }
+
+  /// Compute the quotient @a q and the remainder @a r of @a a / @a b.
+  /// Either output may be null; the outputs must not alias the inputs.
+  static void divmod(const bigint &a, const bigint &b, bigint *q, bigint *r) {
+    assert(b._size != 0);
+    if (compare_magnitude(a, b) < 0) {
+      if (q)
+        *q = bigint();
+      if (r)
+        *r = a;
+      return;
+    }
+    const bool qneg = a._neg != b._neg;
+    if (a._size <= 2) { // then b._size <= 2 as well
+      const uint128_t x = a.low128(), y = b.low128();
+      if (q)
+        q->assign128(x / y, qneg);
+      if (r)
+        r->assign128(x % y, a._neg);
+      return;
+    }
+    if (b._size == 1) {
+      bigint t(a);
+      const limb_type rem = div_small(t.data(), t._size, b.data()[0]);
+      t._neg = qneg;
+      t.trim();
+      if (q)
+        *q = std::move(t);
+      if (r)
+        r->assign128(rem, a._neg);
+      return;
+    }
+    div_knuth(a, b, q, r);
+  }
+
+private:
+  limb_type *data() noexcept { return is_inline() ? _small : _heap; }
+  const limb_type *data() const noexcept { return is_inline() ? _small : _heap; }
+
+  void release() noexcept {
+    if (!is_inline())
+      delete[] _heap;
+    _cap = inline_limbs;
+  }
+
+  /// Make room for @a n limbs, keeping the current ones if @a keep.
+  void reserve(std::uint32_t n, bool keep = true) {
+    if (n <= _cap)
+      return;
+    const std::uint32_t cap = n < 2 * _cap ? 2 * _cap : n;
+    limb_type *p = new limb_type[cap];
+    if (keep)
+      std::memcpy(p, data(), sizeof(limb_type) * _size);
+    release();
+    _heap = p;
+    _cap = cap;
+  }
+
+  /// Drop the leading zero limbs (zero is never negative).
+  void trim() noexcept {
+    const limb_type *x = data();
+    while (_size != 0 && x[_size - 1] == 0)
+      --_size;
+    if (_size == 0)
+      _neg = false;
+  }
+
+  uint128_t low128() const noexcept {
+    uint128_t u = _size == 0 ? 0 : data()[0];
+    if (_size > 1)
+      u |= uint128_t(data()[1]) << 64;
+    return u;
+  }
+
+  void assign128(uint128_t u, bool neg) {
+    reserve(2, false);
+    data()[0] = limb_type(u);
+    data()[1] = limb_type(u >> 64);
+    _size = 2;
+    _neg = neg;
+    trim();
+  }
+
+  static int compare_magnitude(const bigint &a, const bigint &b) noexcept {
+    if (a._size != b._size)
+      return a._size < b._size ? -1 : 1;
+    const limb_type *x = a.data(), *y = b.data();
+    for (std::uint32_t i = a._size; i-- > 0;)
+      if (x[i] != y[i])
+        return x[i] < y[i] ? -1 : 1;
+    return 0;
+  }
+
+  /// Add @a b with the sign @a bneg (in place; @a b may alias *this).
+  bigint &add(const bigint &b, bool bneg) {
+    const std::uint32_t nb = b._size;
+    if (nb == 0)
+      return *this;
+    if (_neg == bneg || _size == 0) {
+      const std::uint32_t n = _size > nb ? _size : nb;
+      reserve(n + 1);
+      limb_type *r = data();
+      const limb_type *y = b.data();
+      std::fill(r + _size, r + n + 1, limb_type(0));
+      limb_type carry = 0;
+      for (std::uint32_t i = 0; i < n; ++i) {
+        const uint128_t t = uint128_t(r[i]) + (i < nb ? y[i] : 0) + carry;
+        r[i] = limb_type(t);
+        carry = limb_type(t >> 64);
+      }
+      r[n] = carry;
+      _size = n + 1;
+      _neg = bneg;
+      trim();
+      return *this;
+    }
+    const int c = compare_magnitude(*this, b);
+    if (c == 0)
+      return *this = bigint();
+    if (c < 0) { // |b| - |this|, with the sign of b
+      reserve(nb);
+      _neg = bneg;
+    }
+    limb_type *r = data();
+    const limb_type *y = b.data();
+    const std::uint32_t n = c > 0 ? _size : nb;
+    limb_type borrow = 0;
+    for (std::uint32_t i = 0; i < n; ++i) {
+      const limb_type xi = i < _size ? r[i] : 0, yi = i < nb ? y[i] : 0;
+      const limb_type u = c > 0 ? xi : yi, v = c > 0 ? yi : xi;
+      const limb_type d = u - v - borrow;
+      borrow = (u < v || (u == v && borrow != 0)) ? 1 : 0;
+      r[i] = d;
+    }
+    _size = n;
+    trim();
+    return *this;
+  }
+
+  /// this = this * m + a (magnitude only)
+  void mul_add(limb_type m, limb_type a) {
+    reserve(_size + 1);
+    limb_type *r = data();
+    limb_type carry = a;
+    for (std::uint32_t i = 0; i < _size; ++i) {
+      const uint128_t t = uint128_t(r[i]) * m + carry;
+      r[i] = limb_type(t);
+      carry = limb_type(t >> 64);
+    }
+    r[_size++] = carry;
+    trim();
+  }
+
+  /// Divide the limbs @a x[0..n) by @a d in place; return the remainder.
+  static limb_type div_small(limb_type *x, std::uint32_t n, limb_type d) {
+    uint128_t rem = 0;
+    for (std::uint32_t i = n; i-- > 0;) {
+      const uint128_t t = (rem << 64) | x[i];
+      x[i] = limb_type(t / d);
+      rem = t % d;
+    }
+    return limb_type(rem);
+  }
+
+  /// Long division (Knuth, TAOCP vol. 2, Algorithm 4.3.1D).
+  static void div_knuth(const bigint &a, const bigint &b, bigint *q,
+                        bigint *r) {
+    const std::uint32_t n = b._size, m = a._size - b._size;
+    const int s = detail::clz64(b.data()[n - 1]);
+    std::vector<limb_type> vn(n), un(a._size + 1);
+    const limb_type *v = b.data(), *u = a.data();
+    for (std::uint32_t i = n - 1; i > 0; --i)
+      vn[i] = s == 0 ? v[i] : (v[i] << s) | (v[i - 1] >> (64 - s));
+    vn[0] = v[0] << s;
+    un[a._size] = s == 0 ? 0 : u[a._size - 1] >> (64 - s);
+    for (std::uint32_t i = a._size - 1; i > 0; --i)
+      un[i] = s == 0 ? u[i] : (u[i] << s) | (u[i - 1] >> (64 - s));
+    un[0] = u[0] << s;
+
+    bigint quot;
+    quot.reserve(m + 1, false);
+    limb_type *qd = quot.data();
+    const uint128_t base = uint128_t(1) << 64;
+    for (std::uint32_t j = m + 1; j-- > 0;) {
+      const uint128_t num = (uint128_t(un[j + n]) << 64) | un[j + n - 1];
+      uint128_t qhat = num / vn[n - 1], rhat = num % vn[n - 1];
+      while (qhat >= base ||
+             qhat * vn[n - 2] > ((rhat << 64) | un[j + n - 2])) {
+        --qhat;
+        rhat += vn[n - 1];
+        if (rhat >= base)
+          break;
+      }
+      // Multiply and subtract
+      limb_type borrow = 0, carry = 0;
+      for (std::uint32_t i = 0; i < n; ++i) {
+        const uint128_t p = qhat * vn[i] + carry;
+        carry = limb_type(p >> 64);
+        const limb_type lo = limb_type(p), x = un[i + j];
+        un[i + j] = x - lo - borrow;
+        borrow = (x < lo || (x == lo && borrow != 0)) ? 1 : 0;
+      }
+      const limb_type x = un[j + n];
+      un[j + n] = x - carry - borrow;
+      borrow = (x < carry || (x == carry && borrow != 0)) ? 1 : 0;
+      qd[j] = limb_type(qhat);
+      if (borrow != 0) { // add back
+        --qd[j];
+        limb_type c = 0;
+        for (std::uint32_t i = 0; i < n; ++i) {
+          const uint128_t t = uint128_t(un[i + j]) + vn[i] + c;
+          un[i + j] = limb_type(t);
+          c = limb_type(t >> 64);
+        }
+        un[j + n] += c;
+      }
+    }
+    if (q) {
+      quot._size = m + 1;
+      quot._neg = a._neg != b._neg;
+      quot.trim();
+      *q = std::move(quot);
+    }
+    if (r) {
+      bigint rem;
+      rem.reserve(n, false);
+      limb_type *rd = rem.data();
+      for (std::uint32_t i = 0; i < n; ++i)
+        rd[i] = s == 0 ? un[i] : (un[i] >> s) | (un[i + 1] << (64 - s));
+      rem._size = n;
+      rem._neg = a._neg;
+      rem.trim();
+      *r = std::move(rem);
+    }
+  }
+
+  std::uint32_t _size; ///< number of limbs in use
+  std::uint32_t _cap;  ///< capacity (inline_limbs when not on the heap)
+  bool _neg;
+  union {
+    limb_type _small[inline_limbs];
+    limb_type *_heap;
+  };
+};
+
+// The free functions below are templates so that the implicit conversion
+// from the built-in integers can not hijack calls meant for them.
+template <typename _B>
+using enable_if_bigint =
+    typename std::enable_if<std::is_same<_B, bigint>::value, int>::type;
+
+/// Return the number of significant bits of |@a x|.
+template <typename _B, enable_if_bigint<_B> = 0>
+inline int bit_length(const _B &x) noexcept {
+  const std::size_t n = x.size();
+  return n == 0 ? 0
+                : 64 * int(n - 1) + bit_length(std::uint64_t(x.limbs()[n - 1]));
+}
+
+/// Return the index of the least significant set bit of |@a x| (x != 0).
+template <typename _B, enable_if_bigint<_B> = 0>
+inline int lsb(const _B &x) noexcept {
+  const typename _B::limb_type *p = x.limbs();
+  int i = 0;
+  for (; p[i] == 0; ++i)
+    ;
+  return 64 * i + detail::ctz64(p[i]);
+}
+
+/// Return the index of the most significant set bit of |@a x| (x != 0).
+template <typename _B, enable_if_bigint<_B> = 0>
+inline int msb(const _B &x) noexcept {
+  return bit_length(x) - 1;
+}
+
+/// Return the absolute value of @a x.
+template <typename _B, enable_if_bigint<_B> = 0>
+inline _B abs(const _B &x) {
+  return x.sign() < 0 ? -x : x;
+}
+
+namespace detail {
+/// bigint has bit_length() and uint64_t conversions: use Lehmer's gcd
+template <> struct use_lehmer_gcd<bigint> : std::true_type {};
+} // namespace detail
+
+///  Insertion operator for bigint values (decimal).
+template <class _Stream, typename _B, enable_if_bigint<_B> = 0>
+_Stream &operator<<(_Stream &os, const _B &x) {
+  os << x.to_string();
+  return os;
+}
+
+///  Extraction operator for bigint values (decimal, optional sign).
+inline std::istream &operator>>(std::istream &is, bigint &x) {
+  std::istream::sentry sentry(is);
+  if (!sentry)
+    return is;
+  std::string s;
+  if (is.peek() == '-' || is.peek() == '+')
+    s += char(is.get());
+  while (std::isdigit(is.peek()))
+    s += char(is.get());
+  if (s.empty() || !std::isdigit(static_cast<unsigned char>(s.back())))
+    is.setstate(std::ios::failbit);
+  else
+    x = bigint(s.c_str());
+  return is;
+}
+
+/** @} */
+} // namespace fun
+
+namespace std {
+template <> class numeric_limits<fun::bigint> {
+public:
+  static constexpr bool is_specialized = true;
+  static constexpr bool is_signed = true;
+  static constexpr bool is_integer = true;
+  static constexpr bool is_exact = true;
+  static constexpr bool is_bounded = false;
+  static constexpr bool is_modulo = false;
+  static constexpr bool has_infinity = false;
+  static constexpr bool has_quiet_NaN = false;
+  static constexpr int radix = 2;
+  static constexpr int digits = 0;
+  static constexpr int digits10 = 0;
+  static fun::bigint min() { return fun::bigint(); }
+  static fun::bigint max() { return fun::bigint(); }
+  static fun::bigint lowest() { return fun::bigint(); }
+};
+
+template <> struct hash<fun::bigint> {
+  std::size_t operator()(const fun::bigint &x) const noexcept {
+    std::size_t h = std::size_t(x.sign() + 1);
+    for (std::size_t i = 0; i < x.size(); ++i)
+      h ^= std::hash<std::uint64_t>()(x.limbs()[i]) + 0x9e3779b9 + (h << 6) +
+           (h >> 2);
+    return h;
+  }
+};
+} // namespace std
+
+#endif
@@ -0,0 +1,460 @@
+// The template and inlines for the -*- C++ -*- dyadic rational classes.
+// Initially implemented by Wai-Shing Luk <luk036@gmail.com>
+//
+
+/** @file include/dyadic.hpp
+ *  This is a C++ Library header.
+ */
+
+#ifndef FUN_DYADIC_HPP
+#define FUN_DYADIC_HPP 1
+
+#include <algorithm>   // for std::max, std::min
+#include <boost/operators.hpp>
+#include <cassert>
+#include <cmath>       // for std::frexp, std::ldexp, std::isfinite
+#include <cstdint>     // for std::int64_t
+#include <limits>      // for std::numeric_limits
+#include <type_traits> // for std::is_integral, std::enable_if
+
+#include "basic_rational.hpp" // for fun::basic_rational
+#include "gcd.hpp"            // for detail::ctz64, detail::uabs
+
+namespace fun {
+/**
+ * @addtogroup rational
+ * @{
+ */
+
+namespace detail {
+
+/// Return the number of trailing zero bits of @a m (m != 0)
+template <typename _Z> inline int trailing_zeros(const _Z &m) {
+  if constexpr (std::is_integral<_Z>::value && sizeof(_Z) <= 8) {
+    return ctz64(std::uint64_t(uabs(m)));
+  }
+#ifdef FUN_HAS_INT128
+  else if constexpr (std::is_same<_Z, int128_t>::value ||
+                     std::is_same<_Z, uint128_t>::value) {
+    const uint128_t u = uabs(m);
+    const std::uint64_t lo = std::uint64_t(u);
+    return lo != 0 ? ctz64(lo) : 64 + ctz64(std::uint64_t(u >> 64));
+  }
+#endif
+  else { // lsb() of bigint or boost::multiprecision (found by ADL)
+    return int(lsb(m < _Z(0) ? _Z(-m) : m));
+  }
+}
+
+/// Return the number of significant bits of the unsigned value @a u
+template <typename _U> inline int ubit_length(const _U &u) {
+  if constexpr (sizeof(_U) <= 8)
+    return bit_length(std::uint64_t(u));
+  else
+    return bit_length(u);
+}
+
+/// Return m * 2^k (k >= 0), wrapping like the unsigned type would
+template <typename _Z> inline _Z shift_left(const _Z &m, int k) {
+  if constexpr (std::numeric_limits<_Z>::is_bounded) {
+    typedef typename make_unsigned<_Z>::type _U;
+    return _Z(_U(m) << k);
+  } else {
+    return m << k;
+  }
+}
+
+/// Return the smallest exponent e at which the bounded mantissa @a m of
+/// exponent @a em, shifted (or rounded) onto e, still fits in _Z
+template <typename _Z> inline int fit_exponent(const _Z &m, int em) {
+  const int d = ubit_length(uabs(m)) - std::numeric_limits<_Z>::digits;
+  return d <= 0 ? em + d : em + d + 1; // rounding may carry into a new bit
+}
+
+/// Return @a a + @a b for a bounded _Z; if the sum does not fit, return
+/// it halved (rounded to nearest) and increment the exponent @a e
+template <typename _Z> inline _Z add_round(const _Z &a, const _Z &b, int &e) {
+  if ((a < _Z(0)) != (b < _Z(0)))
+    return a + b;
+  typedef typename make_unsigned<_Z>::type _U;
+  const _U u = _U(uabs(a) + uabs(b)); // |a|, |b| <= max: no wrap
+  if (u <= _U(std::numeric_limits<_Z>::max()))
+    return a + b;
+  ++e;
+  const _Z h = _Z((u >> 1) + (u & _U(1)));
+  return a < _Z(0) ? _Z(-h) : h;
+}
+
+/// Return m / 2^k (k >= 0) rounded to nearest, ties away from zero
+/// (only needed, and only used with k > 0, for a bounded _Z)
+template <typename _Z> inline _Z shift_right_round(const _Z &m, int k) {
+  if (k == 0)
+    return m;
+  if constexpr (std::numeric_limits<_Z>::is_bounded) {
+    const auto u = uabs(m);
+    typedef std::remove_const_t<decltype(u)> _U;
+    const int w = std::numeric_limits<_U>::digits;
+    const _U q = k > w ? _U(0)
+                       : (k == w ? _U(u >> (w - 1))
+                                 : _U((u >> k) + ((u >> (k - 1)) & _U(1))));
+    return m < _Z(0) ? _Z(-_Z(q)) : _Z(q);
+  } else {
+    assert(false);
+    return m;
+  }
+}
+
+/// Return true if m * 2^k (k >= 0) fits in _Z (always, if _Z is unbounded)
+template <typename _Z> inline bool shift_fits(const _Z &m, int k) {
+  if constexpr (std::numeric_limits<_Z>::is_bounded)
+    return m == _Z(0) ||
+           ubit_length(uabs(m)) + k <= std::numeric_limits<_Z>::digits;
+  else
+    return true;
+}
+
+/// Return the product of the bounded @a a and @a b, rounded to nearest
+/// to the width of _Z if it does not fit, adding the number of dropped
+/// bits to the exponent @a e
+template <typename _Z> inline _Z mul_round(const _Z &a, const _Z &b, int &e) {
+  typedef typename make_unsigned<_Z>::type _U;
+  const int w = std::numeric_limits<_U>::digits, h = w / 2;
+  const int d = std::numeric_limits<_Z>::digits;
+  const _U x = uabs(a), y = uabs(b);
+  if (ubit_length(x) + ubit_length(y) <= d)
+    return a * b;
+  // (hi, lo) = x * y, from the products of the half words
+  const _U m = (_U(1) << h) - 1;
+  const _U p00 = (x & m) * (y & m), p01 = (x & m) * (y >> h),
+           p10 = (x >> h) * (y & m), p11 = (x >> h) * (y >> h);
+  const _U mid = (p00 >> h) + (p01 & m) + (p10 & m);
+  const _U hi = p11 + (p01 >> h) + (p10 >> h) + (mid >> h);
+  const _U lo = _U(mid << h) | (p00 & m);
+  // drop the t lowest bits, rounding to nearest, ties away from zero
+  int t = (hi != 0 ? w + ubit_length(hi) : ubit_length(lo)) - d;
+  if (t <= 0) // fits after all
+    return (a < _Z(0)) != (b < _Z(0)) ? _Z(-_Z(lo)) : _Z(lo);
+  const _U q = t < w ? _U(lo >> t) | _U(hi << (w - t)) : _U(hi >> (t - w));
+  const _U r = (t - 1 < w ? lo >> (t - 1) : hi >> (t - 1 - w)) & _U(1);
+  _U u = q + r;
+  if (ubit_length(u) > d) { // rounded up to 2^d
+    u >>= 1;
+    ++t;
+  }
+  e += t;
+  return (a < _Z(0)) != (b < _Z(0)) ? _Z(-_Z(u)) : _Z(u);
+}
+
+/// Return m / 2^k, where 2^k divides m
+template <typename _Z> inline _Z shift_right_exact(const _Z &m, int k) {
+  if constexpr (std::numeric_limits<_Z>::is_bounded) {
+    const auto u = uabs(m) >> k;
+    return m < _Z(0) ? _Z(-_Z(u)) : _Z(u);
+  } else {
+    return m >> k;
+  }
+}
+
+} // namespace detail
+
+/**
+ *  Dyadic rational number m * 2^e.
+ *
+ *  The denominator is a power of two, kept as the exponent e. Additions
+ *  align the mantissas by a shift, products add the exponents, and the
+ *  normalization (m odd, or m = 0 and e = 0) is a count-trailing-zeros:
+ *  no gcd() at all. The quotient of two dyadic numbers is a rational
+ *  number (boost::rat<>), so that e.g. quadrance() stays exact.
+ *
+ *  For a bounded _Z, a sum or product whose mantissa would overflow is
+ *  rounded to nearest instead, like a floating point number with the
+ *  precision of _Z. There is no NaN or infinity; the value m * 2^e must
+ *  fit in _Z when it is converted to a rational number (asserted).
+ *
+ *  @param  _Z  Type of the mantissa (integer-like)
+ */
+template <typename _Z>
+struct dyadic
+    : boost::ordered_ring_operators<
+          dyadic<_Z>, boost::ordered_ring_operators2<dyadic<_Z>, _Z>> {
+  static_assert(std::numeric_limits<_Z>::is_specialized,
+                "dyadic<> requires an integer-like type");
+
+  /// Value typedef.
+  typedef _Z value_type;
+  typedef _Z int_type;
+
+  /// Default constructor.
+  constexpr dyadic() : _num(0), _exp(0) {}
+
+  /// Construct from an integer @a n.
+  dyadic(const _Z &n) : _num(n), _exp(0) { normalize(); }
+
+  /// Construct from @a n * 2^e.
+  dyadic(const _Z &n, int e) : _num(n), _exp(e) { normalize(); }
+
+  /// Construct exactly from a finite float or double @a x.
+  template <typename _F, class = typename std::enable_if<
+                             std::is_floating_point<_F>::value>::type>
+  explicit dyadic(_F x) : _num(0), _exp(0) {
+    static_assert(!std::numeric_limits<_Z>::is_bounded ||
+                      std::numeric_limits<_Z>::digits >= 53,
+                  "exact conversion from double needs a 53-bit mantissa");
+    assert(std::isfinite(x));
+    int e;
+    const double f = std::frexp(double(x), &e); // x = f * 2^e, 1/2 <= |f| < 1
+    _num = _Z(static_cast<std::int64_t>(std::ldexp(f, 53)));
+    _exp = e - 53;
+    normalize();
+  }
+
+  /// Return the (odd) mantissa.
+  constexpr const _Z &mantissa() const { return _num; }
+
+  /// Return the exponent.
+  constexpr int exponent() const { return _exp; }
+
+  /// Add @a r to this dyadic number. The mantissa with the larger
+  /// exponent is shifted onto the other one. For a bounded _Z, if that
+  /// shift would overflow, both mantissas are brought to the smallest
+  /// exponent at which they fit instead, and if the sum overflows, it is
+  /// halved; the dropped bits are rounded to nearest (the sum is then
+  /// inexact).
+  dyadic &operator+=(const dyadic &r) {
+    if (_num == _Z(0))
+      return *this = r;
+    if (r._num == _Z(0))
+      return *this;
+    if constexpr (std::numeric_limits<_Z>::is_bounded) {
+      const int e = std::max({std::min(_exp, r._exp),
+                              detail::fit_exponent(_num, _exp),
+                              detail::fit_exponent(r._num, r._exp)});
+      const _Z a = scaled(e), b = r.scaled(e); // r may be *this
+      _exp = e;
+      _num = detail::add_round(a, b, _exp);
+      normalize();
+    } else if (_exp == r._exp) {
+      _num += r._num; // odd + odd is even
+      normalize();
+    } else { // exact sums stay odd
+      const bool up = _exp > r._exp; // this one has the larger exponent
+      _num = up ? detail::shift_left(_num, _exp - r._exp) + r._num
+                : _num + detail::shift_left(r._num, r._exp - _exp);
+      _exp = std::min(_exp, r._exp);
+    }
+    return *this;
+  }
+
+  /// Subtract @a r from this dyadic number.
+  dyadic &operator-=(const dyadic &r) { return *this += -r; }
+
+  /// Multiply this dyadic number by @a r. For a bounded _Z, a product
+  /// that does not fit is rounded to nearest (it is then inexact).
+  dyadic &operator*=(const dyadic &r) {
+    if (_num == _Z(0) || r._num == _Z(0))
+      return *this = dyadic();
+    if constexpr (std::numeric_limits<_Z>::is_bounded) {
+      int e = _exp + r._exp;
+      _num = detail::mul_round(_num, r._num, e);
+      _exp = e;
+      normalize(); // only a rounded product can be even
+    } else {
+      _num *= r._num; // odd * odd is odd
+      _exp += r._exp;
+    }
+    return *this;
+  }
+
+  /// Add the integer @a i to this dyadic number.
+  dyadic &operator+=(const _Z &i) { return *this += dyadic(i); }
+
+  /// Subtract the integer @a i from this dyadic number.
+  dyadic &operator-=(const _Z &i) { return *this += dyadic(-i); }
+
+  /// Multiply this dyadic number by the integer @a i.
+  dyadic &operator*=(const _Z &i) { return *this *= dyadic(i); }
+
+  /// Return the negation of this dyadic number.
+  dyadic operator-() const { return dyadic(-_num, _exp, 0); }
+
+  /// Return true if this dyadic number is zero.
+  constexpr bool operator!() const { return _num == _Z(0); }
+
+  /// Return true if this dyadic number is not zero.
+  explicit constexpr operator bool() const { return _num != _Z(0); }
+
+  /// Cast to double (rounds the mantissa only)
+  explicit operator double() const {
+    return std::ldexp(static_cast<double>(_num), _exp);
+  }
+
+  /// Convert to a rational number (already in lowest terms); the value
+  /// m * 2^e (or 2^-e) must fit in _Z
+  template <class _P> explicit operator basic_rational<_Z, _P>() const {
+    assert(_exp >= 0 ? detail::shift_fits(_num, _exp)
+                     : detail::shift_fits(_Z(1), -_exp));
+    return _exp >= 0
+               ? basic_rational<_Z, _P>(detail::shift_left(_num, _exp),
+                                        _Z(1), unnormalized)
+               : basic_rational<_Z, _P>(_num, detail::pow2<_Z>(-_exp),
+                                        unnormalized);
+  }
+
+  /// Return true if this dyadic number is less than @a r.
+  bool operator<(const dyadic &r) const { return compare(r) < 0; }
+
+  /// Return true if this dyadic number is equal to @a r.
+  bool operator==(const dyadic &r) const {
+    return _num == r._num && _exp == r._exp;
+  }
+
+  /// Return true if this dyadic number is less than @a i.
+  bool operator<(const _Z &i) const { return compare(dyadic(i)) < 0; }
+
+  /// Return true if this dyadic number is greater than @a i.
+  bool operator>(const _Z &i) const { return compare(dyadic(i)) > 0; }
+
+  /// Return true if this dyadic number is equal to @a i.
+  bool operator==(const _Z &i) const { return *this == dyadic(i); }
+
+  /// Return this dyadic number times 2^k (exact).
+  dyadic ldexp(int k) const {
+    return _num == _Z(0) ? *this : dyadic(_num, _exp + k, 0);
+  }
+
+  /// Bring the mantissa to an odd number (or zero).
+  void normalize() {
+    if (_num == _Z(0)) {
+      _exp = 0;
+      return;
+    }
+    const int k = detail::trailing_zeros(_num);
+    if (k != 0) {
+      _num = detail::shift_right_exact(_num, k);
+      _exp += k;
+    }
+  }
+
+private:
+  /// Construct from normalized components.
+  constexpr dyadic(const _Z &n, int e, int) : _num(n), _exp(e) {}
+
+  /// Return the mantissa for the exponent @a e (rounded if e > exponent)
+  _Z scaled(int e) const {
+    return e <= _exp ? detail::shift_left(_num, _exp - e)
+                     : detail::shift_right_round(_num, e - _exp);
+  }
+
+  /// Three-way comparison without overflow: the leading bit positions
+  /// are compared first, and only equal ones are aligned by a shift.
+  int compare(const dyadic &r) const {
+    const int sa = _num < _Z(0) ? -1 : (_Z(0) < _num ? 1 : 0);
+    const int sb = r._num < _Z(0) ? -1 : (_Z(0) < r._num ? 1 : 0);
+    if (sa != sb)
+      return sa < sb ? -1 : 1;
+    if (sa == 0 || _exp == r._exp)
+      return _num < r._num ? -1 : (r._num < _num ? 1 : 0);
+    const dyadic &lo = _exp < r._exp ? *this : r;
+    const dyadic &hi = _exp < r._exp ? r : *this;
+    const int d = hi._exp - lo._exp;
+    int c; // sign of |hi| - |lo|
+    if constexpr (std::numeric_limits<_Z>::is_bounded) {
+      const auto mlo = detail::uabs(lo._num), mhi = detail::uabs(hi._num);
+      const int tlo = detail::ubit_length(mlo);
+      const int thi = detail::ubit_length(mhi) + d;
+      if (tlo != thi)
+        c = tlo < thi ? 1 : -1;
+      else { // the shifted mantissa has the bit length of the other one
+        const auto s = decltype(mhi)(mhi << d);
+        c = mlo < s ? 1 : (s < mlo ? -1 : 0);
+      }
+    } else {
+      const _Z s = detail::shift_left(hi._num, d);
+      c = sa > 0 ? (lo._num < s ? 1 : (s < lo._num ? -1 : 0))
+                 : (s < lo._num ? 1 : (lo._num < s ? -1 : 0));
+    }
+    c *= sa; // signed difference of hi and lo
+    return &hi == this ? c : -c;
+  }
+
+  _Z _num;
+  int _exp;
+};
+
+/// Return @a x times 2^k (exact).
+template <typename _Z> inline dyadic<_Z> ldexp(const dyadic<_Z> &x, int k) {
+  return x.ldexp(k);
+}
+
+/// Return the absolute value of @a x.
+template <typename _Z> inline dyadic<_Z> abs(const dyadic<_Z> &x) {
+  return x.mantissa() < _Z(0) ? -x : x;
+}
+
+/// Return the quotient of @a x and @a y as a rational number.
+template <typename _Z>
+inline basic_rational<_Z, lazy_normalize<>> operator/(const dyadic<_Z> &x,
+                                                      const dyadic<_Z> &y) {
+  typedef basic_rational<_Z, lazy_normalize<>> _R;
+  const int e = x.exponent() - y.exponent();
+  assert(e >= 0 ? detail::shift_fits(x.mantissa(), e)
+                : detail::shift_fits(y.mantissa(), -e));
+  return e >= 0 ? _R(detail::shift_left(x.mantissa(), e), y.mantissa())
+                : _R(x.mantissa(), detail::shift_left(y.mantissa(), -e));
+}
+
+/// Return the quotient of @a x and @a i as a rational number.
+template <typename _Z>
+inline basic_rational<_Z, lazy_normalize<>> operator/(const dyadic<_Z> &x,
+                                                      const _Z &i) {
+  return x / dyadic<_Z>(i);
+}
+
+/// Return the quotient of @a i and @a x as a rational number.
+template <typename _Z>
+inline basic_rational<_Z, lazy_normalize<>> operator/(const _Z &i,
+                                                      const dyadic<_Z> &x) {
+  return dyadic<_Z>(i) / x;
+}
+
+// Mixed operators with basic_rational: the dyadic operand is converted
+// (without gcd) and the result is a rational number of the same policy.
+#define FUN_DYADIC_MIXED_OP(_Op)                                             \
+  template <typename _Z, class _P>                                           \
+  inline auto operator _Op(const basic_rational<_Z, _P> &r,                  \
+                           const dyadic<_Z> &x) {                            \
+    return r _Op basic_rational<_Z, _P>(x);                                  \
+  }                                                                          \
+  template <typename _Z, class _P>                                           \
+  inline auto operator _Op(const dyadic<_Z> &x,                              \
+                           const basic_rational<_Z, _P> &r) {                \
+    return basic_rational<_Z, _P>(x) _Op r;                                  \
+  }
+
+FUN_DYADIC_MIXED_OP(+)
+FUN_DYADIC_MIXED_OP(-)
+FUN_DYADIC_MIXED_OP(*)
+FUN_DYADIC_MIXED_OP(/)
+FUN_DYADIC_MIXED_OP(==)
+FUN_DYADIC_MIXED_OP(!=)
+FUN_DYADIC_MIXED_OP(<)
+FUN_DYADIC_MIXED_OP(>)
+FUN_DYADIC_MIXED_OP(<=)
+FUN_DYADIC_MIXED_OP(>=)
+
+#undef FUN_DYADIC_MIXED_OP
+
+///  Insertion operator for dyadic number values ("m" or "(m*2^e)").
+template <typename _Z, class _Stream>
+_Stream &operator<<(_Stream &os, const dyadic<_Z> &x) {
+  if (x.exponent() == 0)
+    os << x.mantissa();
+  else
+    os << '(' << x.mantissa() << "*2^" << x.exponent() << ')';
+  return os;
+}
+
+/** @} */
+} // namespace fun
+
+#endif
@@ -0,0 +1,629 @@
+// The template and inlines for the -*- C++ -*- Gaussian elimination.
+// Initially implemented by Wai-Shing Luk <luk036@gmail.com>
+//
+
+/** @file include/gauss.hpp
+ *  This is a C++ Library header.
+ */
+
+#ifndef FUN_GAUSS_HPP
+#define FUN_GAUSS_HPP 1
+
+#include <algorithm> // for std::min, std::swap_ranges
+#include <cassert>
+#include <cstddef> // for std::size_t
+#include <cstdint> // for std::uint64_t
+#include <limits>  // for std::numeric_limits
+#include <thread>
+#include <type_traits> // for std::integral_constant
+#include <utility>     // for std::swap
+#include <vector>
+
+#include "gcd.hpp" // for detail::ctz64
+
+namespace fun {
+
+// Forward declarations.
+template <std::uint64_t _p> struct GF;
+
+/**
+ * @defgroup gauss Gaussian Elimination
+ * @ingroup linear_alg
+ *
+ * Dense elimination engine for large (thousands of rows) incidence and
+ * collineation matrices: reduced row echelon form, rank, nullspace and
+ * solve.
+ *
+ * - Over a field (GF<p>, GF_ext, rat<>, ...): blocked Gauss-Jordan. The
+ *   pivots of a panel of columns are found on a copy of the panel only;
+ *   the rest of the matrix is then updated once per panel, in column
+ *   tiles that keep the pivot rows in cache.
+ * - Over GF(2) (gf2_matrix): bit-packed rows and the Method of Four
+ *   Russians (M4RI): the 2^k combinations of k pivot rows are tabulated,
+ *   so that a row is reduced by k columns with a single XOR.
+ * - Over the integers (built-in or bigint): fraction-free Gauss-Jordan
+ *   (Bareiss), in which all divisions are exact.
+ *
+ * The updates of the rows may be spread across threads by row panels.
+ * @{
+ */
+
+/**
+ *  Dense matrix, stored row by row.
+ *
+ *  @param  _K  Type of matrix elements
+ */
+template <typename _K> class dense_matrix {
+public:
+  /// Value typedef.
+  typedef _K value_type;
+
+  /// Default constructor (empty).
+  dense_matrix() : _rows(0), _cols(0) {}
+
+  /// Construct an @a m x @a n matrix filled with @a a.
+  dense_matrix(std::size_t m, std::size_t n, const _K &a = _K(0))
+      : _rows(m), _cols(n), _a(m * n, a) {}
+
+  /// Return the number of rows.
+  std::size_t rows() const noexcept { return _rows; }
+
+  /// Return the number of columns.
+  std::size_t cols() const noexcept { return _cols; }
+
+  /// Return the element (@a i, @a j).
+  _K &operator()(std::size_t i, std::size_t j) {
+    assert(i < _rows && j < _cols);
+    return _a[i * _cols + j];
+  }
+
+  /// Return the element (@a i, @a j).
+  const _K &operator()(std::size_t i, std::size_t j) const {
+    assert(i < _rows && j < _cols);
+    return _a[i * _cols + j];
+  }
+
+  /// Return the row @a i.
+  _K *row(std::size_t i) { return _a.data() + i * _cols; }
+
+  /// Return the row @a i.
+  const _K *row(std::size_t i) const { return _a.data() + i * _cols; }
+
+  /// Exchange the rows @a i and @a j.
+  void swap_rows(std::size_t i, std::size_t j) {
+    if (i != j)
+      std::swap_ranges(row(i), row(i) + _cols, row(j));
+  }
+
+private:
+  std::size_t _rows;
+  std::size_t _cols;
+  std::vector<_K> _a;
+};
+
+/**
+ *  Dense matrix over GF(2), each row packed into 64-bit words (bit j % 64
+ *  of word j / 64 is the column j).
+ */
+class gf2_matrix {
+public:
+  /// Default constructor (empty).
+  gf2_matrix() : _rows(0), _cols(0), _words(0) {}
+
+  /// Construct an @a m x @a n zero matrix.
+  gf2_matrix(std::size_t m, std::size_t n)
+      : _rows(m), _cols(n), _words((n + 63) / 64), _a(m * _words) {}
+
+  /// Return the number of rows.
+  std::size_t rows() const noexcept { return _rows; }
+
+  /// Return the number of columns.
+  std::size_t cols() const noexcept { return _cols; }
+
+  /// Return the number of words per row.
+  std::size_t words() const noexcept { return _words; }
+
+  /// Return the element (@a i, @a j).
+  bool operator()(std::size_t i, std::size_t j) const {
+    assert(i < _rows && j < _cols);
+    return ((row(i)[j / 64] >> (j % 64)) & 1U) != 0;
+  }
+
+  /// Set the element (@a i, @a j) to @a b.
+  void set(std::size_t i, std::size_t j, bool b) {
+    assert(i < _rows && j < _cols);
+    const std::uint64_t m = std::uint64_t(1) << (j % 64);
+    row(i)[j / 64] = b ? row(i)[j / 64] | m : row(i)[j / 64] & ~m;
+  }
+
+  /// Return the row @a i.
+  std::uint64_t *row(std::size_t i) { return _a.data() + i * _words; }
+
+  /// Return the row @a i.
+  const std::uint64_t *row(std::size_t i) const {
+    return _a.data() + i * _words;
+  }
+
+  /// Exchange the rows @a i and @a j.
+  void swap_rows(std::size_t i, std::size_t j) {
+    if (i != j)
+      std::swap_ranges(row(i), row(i) + _words, row(j));
+  }
+
+private:
+  std::size_t _rows;
+  std::size_t _cols;
+  std::size_t _words;
+  std::vector<std::uint64_t> _a;
+};
+
+namespace detail {
+
+/// Width of the column panels of the blocked elimination
+constexpr std::size_t gauss_panel = 32;
+
+/// Width of the column tiles of the trailing update
+constexpr std::size_t gauss_tile = 256;
+
+/// Rows per thread below which the update stays in the calling thread
+constexpr std::size_t gauss_min_rows = 64;
+
+/// Number of columns reduced at once by M4RI
+constexpr unsigned m4ri_k = 8;
+
+/**
+ *  Call @a f(lo, hi) on row panels covering [@a first, @a last), on up
+ *  to @a threads threads (the calling thread takes the last panel).
+ */
+template <class _F>
+inline void for_row_panels(std::size_t first, std::size_t last,
+                           unsigned threads, _F f) {
+  const std::size_t n = last - first;
+  std::size_t t = std::min<std::size_t>(threads, n / gauss_min_rows);
+  if (t <= 1) {
+    f(first, last);
+    return;
+  }
+  std::vector<std::thread> pool;
+  const std::size_t step = (n + t - 1) / t;
+  for (; first + step < last; first += step)
+    pool.emplace_back(f, first, first + step);
+  f(first, last);
+  for (auto &th : pool)
+    th.join();
+}
+
+/**
+ *  Trailing update of the blocked elimination: pi[j] -= sum_t f[t] *
+ *  pr[t * stride + j] for j in [@a j0, @a j1).
+ */
+template <typename _K, class = void> struct gauss_update {
+  static void apply(_K *pi, const _K *pr, std::size_t stride, const _K *f,
+                    std::size_t k, std::size_t j0, std::size_t j1) {
+    const _K zero(0);
+    for (std::size_t t = 0; t != k; ++t, pr += stride)
+      if (f[t] != zero)
+        for (std::size_t j = j0; j != j1; ++j)
+          pi[j] -= f[t] * pr[j];
+  }
+};
+
+/**
+ *  Trailing update over GF(p), p < 2^32: the products are summed in 64
+ *  bits and reduced only when the sum could overflow, i.e. once per row
+ *  and panel for p < 2^27 (p = 65521: once per 2^32 products).
+ */
+template <std::uint64_t _p>
+struct gauss_update<GF<_p>, typename std::enable_if<(_p >> 32) == 0>::type> {
+  static constexpr std::uint64_t terms =
+      (~std::uint64_t(0) - _p) / ((_p - 1) * (_p - 1));
+
+  static void apply(GF<_p> *pi, const GF<_p> *pr, std::size_t stride,
+                    const GF<_p> *f, std::size_t k, std::size_t j0,
+                    std::size_t j1) {
+    typedef typename GF<_p>::value_type _V;
+    std::uint64_t acc[gauss_tile];
+    for (std::size_t j = j0; j != j1; ++j)
+      acc[j - j0] = pi[j].value();
+    std::uint64_t count = 0;
+    for (std::size_t t = 0; t != k; ++t, pr += stride) {
+      if (f[t].value() == 0)
+        continue;
+      if (count++ == terms) {
+        for (std::size_t j = j0; j != j1; ++j)
+          acc[j - j0] %= _p;
+        count = 1;
+      }
+      const std::uint64_t g = _p - f[t].value(); // -f
+      for (std::size_t j = j0; j != j1; ++j)
+        acc[j - j0] += g * pr[j].value();
+    }
+    for (std::size_t j = j0; j != j1; ++j)
+      pi[j] = GF<_p>(_V(acc[j - j0] % _p));
+  }
+};
+
+/// Elements to which the fraction-free elimination applies
+template <typename _K>
+struct use_bareiss
+    : std::integral_constant<bool, std::numeric_limits<_K>::is_integer> {};
+
+} // namespace detail
+
+/**
+ *  Transform @a A into its reduced row echelon form over the field _K and
+ *  return the pivot columns; the pivot rows come first, in order.
+ *
+ *  For each panel of columns, Gauss elimination on a copy of the panel
+ *  selects the pivot rows S and columns J. With M = A[S, J], the pivot
+ *  rows become M^-1 A[S, :] and every other row i loses A[i, J] times
+ *  them, a rank-|J| update that is applied in column tiles.
+ */
+template <typename _K>
+std::vector<std::size_t> rref(dense_matrix<_K> &A, unsigned threads = 1) {
+  const std::size_t m = A.rows(), n = A.cols();
+  const _K zero(0), one(1);
+  std::vector<std::size_t> piv;
+  std::size_t r = 0; // rank so far
+  for (std::size_t c0 = 0; c0 < n && r < m; c0 += detail::gauss_panel) {
+    const std::size_t w = std::min(n - c0, detail::gauss_panel);
+
+    // 1. Pivots of the panel among the rows r, r + 1, ...
+    dense_matrix<_K> P(m - r, w);
+    for (std::size_t i = r; i != m; ++i)
+      std::copy(A.row(i) + c0, A.row(i) + c0 + w, P.row(i - r));
+    std::vector<std::size_t> pcol;
+    std::size_t k = 0;
+    for (std::size_t c = 0; c != w && r + k != m; ++c) {
+      std::size_t i = k;
+      while (i != m - r && P(i, c) == zero)
+        ++i;
+      if (i == m - r)
+        continue;
+      P.swap_rows(i, k);
+      A.swap_rows(r + i, r + k);
+      const _K s = one / P(k, c);
+      for (std::size_t j = c; j != w; ++j)
+        P(k, j) *= s;
+      for (i = k + 1; i != m - r; ++i) {
+        const _K f = P(i, c);
+        if (f != zero)
+          for (std::size_t j = c; j != w; ++j)
+            P(i, j) -= f * P(k, j);
+      }
+      pcol.push_back(c0 + c);
+      ++k;
+    }
+    if (k == 0)
+      continue;
+
+    // 2. Pivot rows: Gauss-Jordan on A[r:r+k, c0:] with the known pivots
+    //    (the columns before c0 are zero in these rows)
+    for (std::size_t t = 0; t != k; ++t) {
+      _K *pt = A.row(r + t);
+      const _K s = one / pt[pcol[t]];
+      for (std::size_t j = c0; j != n; ++j)
+        pt[j] *= s;
+      for (std::size_t u = 0; u != k; ++u) {
+        _K *pu = A.row(r + u);
+        const _K f = pu[pcol[t]];
+        if (u != t && f != zero)
+          for (std::size_t j = c0; j != n; ++j)
+            pu[j] -= f * pt[j];
+      }
+    }
+
+    // 3. Other rows: row_i -= sum_t A[i, J_t] * row_{r+t}, tile by tile
+    auto update = [&A, &pcol, r, k, c0, n](std::size_t lo, std::size_t hi) {
+      std::vector<_K> coef((hi - lo) * k);
+      for (std::size_t i = lo; i != hi; ++i)
+        for (std::size_t t = 0; t != k; ++t)
+          coef[(i - lo) * k + t] = A(i, pcol[t]);
+      for (std::size_t j0 = c0; j0 < n; j0 += detail::gauss_tile) {
+        const std::size_t j1 = std::min(n, j0 + detail::gauss_tile);
+        for (std::size_t i = lo; i != hi; ++i)
+          detail::gauss_update<_K>::apply(A.row(i), A.row(r), n,
+                                          &coef[(i - lo) * k], k, j0, j1);
+      }
+    };
+    detail::for_row_panels(0, r, threads, update);
+    detail::for_row_panels(r + k, m, threads, update);
+    piv.insert(piv.end(), pcol.begin(), pcol.end());
+    r += k;
+  }
+  return piv;
+}
+
+/**
+ *  Transform @a A by fraction-free Gauss-Jordan elimination (Bareiss)
+ *  into D times its reduced row echelon form, D the determinant of the
+ *  pivot minor, and return the pivot columns; the pivot rows come first,
+ *  in order, and all their pivots equal D.
+ *
+ *  Every entry stays a minor of @a A, so that the divisions are exact
+ *  over the integers, and the entries grow linearly in the bit length.
+ */
+template <typename _Z>
+std::vector<std::size_t> bareiss(dense_matrix<_Z> &A, unsigned threads = 1) {
+  const std::size_t m = A.rows(), n = A.cols();
+  const _Z zero(0);
+  std::vector<std::size_t> piv;
+  _Z prev(1);
+  std::size_t r = 0;
+  for (std::size_t c = 0; c != n && r != m; ++c) {
+    std::size_t i = r;
+    while (i != m && A(i, c) == zero)
+      ++i;
+    if (i == m)
+      continue;
+    A.swap_rows(i, r);
+    const _Z p = A(r, c);
+    auto update = [&A, &prev, &p, r, c, n, &zero](std::size_t lo,
+                                                  std::size_t hi) {
+      const _Z *pr = A.row(r);
+      for (std::size_t i = lo; i != hi; ++i) {
+        if (i == r)
+          continue;
+        _Z *pi = A.row(i);
+        const _Z f = pi[c];
+        // below r, the columns before c are zero
+        for (std::size_t j = i < r ? 0 : c + 1; j != n; ++j)
+          if (j != c)
+            pi[j] = (p * pi[j] - f * pr[j]) / prev; // exact
+        pi[c] = zero;
+      }
+    };
+    detail::for_row_panels(0, m, threads, update);
+    prev = p;
+    piv.push_back(c);
+    ++r;
+  }
+  return piv;
+}
+
+/// Return the rank of @a A.
+template <typename _K>
+std::size_t rank(dense_matrix<_K> A, unsigned threads = 1) {
+  if constexpr (detail::use_bareiss<_K>::value)
+    return bareiss(A, threads).size();
+  else
+    return rref(A, threads).size();
+}
+
+/**
+ *  Return a basis of the (right) nullspace of @a A as the rows of a
+ *  matrix, one per free column; over the integers the basis is integral.
+ */
+template <typename _K>
+dense_matrix<_K> nullspace(dense_matrix<_K> A, unsigned threads = 1) {
+  std::vector<std::size_t> piv;
+  _K d(1);
+  if constexpr (detail::use_bareiss<_K>::value) {
+    piv = bareiss(A, threads);
+    if (!piv.empty())
+      d = A(0, piv[0]);
+  } else {
+    piv = rref(A, threads);
+  }
+  const std::size_t n = A.cols();
+  dense_matrix<_K> N(n - piv.size(), n);
+  std::size_t f = 0, t = 0;
+  for (std::size_t c = 0; c != n; ++c) {
+    if (t != piv.size() && piv[t] == c) {
+      ++t;
+      continue;
+    }
+    N(f, c) = d;
+    for (std::size_t s = 0; s != piv.size(); ++s)
+      N(f, piv[s]) = -A(s, c);
+    ++f;
+  }
+  return N;
+}
+
+/**
+ *  Solve A x = b over the field _K; return false if there is no solution.
+ *  The free variables of @a x are set to zero.
+ */
+template <typename _K>
+bool solve(const dense_matrix<_K> &A, const std::vector<_K> &b,
+           std::vector<_K> &x, unsigned threads = 1) {
+  static_assert(!detail::use_bareiss<_K>::value,
+                "over the integers, use solve(A, b, x, d)");
+  assert(b.size() == A.rows());
+  const std::size_t m = A.rows(), n = A.cols();
+  dense_matrix<_K> Ab(m, n + 1);
+  for (std::size_t i = 0; i != m; ++i) {
+    std::copy(A.row(i), A.row(i) + n, Ab.row(i));
+    Ab(i, n) = b[i];
+  }
+  const std::vector<std::size_t> piv = rref(Ab, threads);
+  if (!piv.empty() && piv.back() == n)
+    return false;
+  x.assign(n, _K(0));
+  for (std::size_t t = 0; t != piv.size(); ++t)
+    x[piv[t]] = Ab(t, n);
+  return true;
+}
+
+/**
+ *  Solve A x = d b over the integers for x and d != 0 (i.e. x / d solves
+ *  A x = b); return false if there is no rational solution. The free
+ *  variables of @a x are set to zero.
+ */
+template <typename _Z>
+bool solve(const dense_matrix<_Z> &A, const std::vector<_Z> &b,
+           std::vector<_Z> &x, _Z &d, unsigned threads = 1) {
+  assert(b.size() == A.rows());
+  const std::size_t m = A.rows(), n = A.cols();
+  dense_matrix<_Z> Ab(m, n + 1);
+  for (std::size_t i = 0; i != m; ++i) {
+    std::copy(A.row(i), A.row(i) + n, Ab.row(i));
+    Ab(i, n) = b[i];
+  }
+  const std::vector<std::size_t> piv = bareiss(Ab, threads);
+  if (!piv.empty() && piv.back() == n)
+    return false;
+  d = piv.empty() ? _Z(1) : Ab(0, piv[0]);
+  x.assign(n, _Z(0));
+  for (std::size_t t = 0; t != piv.size(); ++t)
+    x[piv[t]] = Ab(t, n);
+  return true;
+}
+
+/**
+ *  Transform @a A into its reduced row echelon form over GF(2) and return
+ *  the pivot columns; the pivot rows come first, in order.
+ *
+ *  Method of Four Russians: for each strip of k = 8 columns, the pivots
+ *  are found on the bits of the strip only, the (at most k) pivot rows
+ *  are reduced among themselves, and the XOR of every combination of
+ *  them is tabulated in Gray code order, one column tile at a time, so
+ *  that every other row is cleared on the strip by one table lookup.
+ */
+inline std::vector<std::size_t> rref(gf2_matrix &A, unsigned threads = 1) {
+  const std::size_t m = A.rows(), n = A.cols(), nw = A.words();
+  const unsigned K = detail::m4ri_k;
+  std::vector<std::size_t> piv;
+  std::vector<unsigned> strip(m), idx(m);
+  std::vector<std::uint64_t> table;
+  std::size_t r = 0;
+  for (std::size_t c0 = 0; c0 < n && r < m; c0 += K) {
+    const unsigned w = unsigned(std::min<std::size_t>(n - c0, K));
+    const std::size_t w0 = c0 / 64;
+    auto bits = [&A, c0, w0, nw, w](std::size_t i) {
+      const std::uint64_t *pi = A.row(i);
+      std::uint64_t v = pi[w0] >> (c0 % 64);
+      if (c0 % 64 != 0 && w0 + 1 != nw)
+        v |= pi[w0 + 1] << (64 - c0 % 64);
+      return unsigned(v & ((1U << w) - 1));
+    };
+
+    // 1. Pivots of the strip among the rows r, r + 1, ...
+    for (std::size_t i = r; i != m; ++i)
+      strip[i] = bits(i);
+    std::vector<unsigned> pcol; // relative to c0
+    std::size_t k = 0;
+    for (unsigned c = 0; c != w && r + k != m; ++c) {
+      std::size_t i = r + k;
+      while (i != m && ((strip[i] >> c) & 1U) == 0)
+        ++i;
+      if (i == m)
+        continue;
+      std::swap(strip[i], strip[r + k]);
+      A.swap_rows(i, r + k);
+      for (i = r + k + 1; i != m; ++i)
+        if ((strip[i] >> c) & 1U)
+          strip[i] ^= strip[r + k];
+      pcol.push_back(c);
+      ++k;
+    }
+    if (k == 0)
+      continue;
+
+    // 2. Pivot rows: Gauss-Jordan among themselves
+    for (std::size_t t = 0; t != k; ++t) {
+      const std::size_t j = c0 + pcol[t];
+      for (std::size_t u = 0; u != k; ++u)
+        if (u != t && A(r + u, j)) {
+          std::uint64_t *pu = A.row(r + u);
+          const std::uint64_t *pt = A.row(r + t);
+          for (std::size_t v = w0; v != nw; ++v)
+            pu[v] ^= pt[v];
+        }
+    }
+
+    // 3. Other rows: one table lookup per strip and tile
+    auto index = [&](std::size_t lo, std::size_t hi) {
+      for (std::size_t i = lo; i != hi; ++i) {
+        const unsigned s = bits(i);
+        unsigned x = 0;
+        for (std::size_t t = 0; t != k; ++t)
+          x |= ((s >> pcol[t]) & 1U) << t;
+        idx[i] = x;
+      }
+    };
+    detail::for_row_panels(0, r, threads, index);
+    detail::for_row_panels(r + k, m, threads, index);
+    const std::size_t tile = 8; // words: a table of 256 x 64 bytes
+    table.resize((std::size_t(1) << k) * tile);
+    for (std::size_t v0 = w0; v0 < nw; v0 += tile) {
+      const std::size_t tw = std::min(nw - v0, tile);
+      std::fill(table.begin(), table.begin() + tw, 0);
+      for (unsigned g = 1; g != (1U << k); ++g) {
+        const unsigned cur = g ^ (g >> 1), old = (g - 1) ^ ((g - 1) >> 1);
+        const std::uint64_t *pt = A.row(r + detail::ctz64(cur ^ old));
+        for (std::size_t v = 0; v != tw; ++v)
+          table[cur * tile + v] = table[old * tile + v] ^ pt[v0 + v];
+      }
+      auto update = [&](std::size_t lo, std::size_t hi) {
+        for (std::size_t i = lo; i != hi; ++i) {
+          if (idx[i] == 0)
+            continue;
+          std::uint64_t *pi = A.row(i) + v0;
+          const std::uint64_t *pt = &table[idx[i] * tile];
+          for (std::size_t v = 0; v != tw; ++v)
+            pi[v] ^= pt[v];
+        }
+      };
+      detail::for_row_panels(0, r, threads, update);
+      detail::for_row_panels(r + k, m, threads, update);
+    }
+    for (std::size_t t = 0; t != k; ++t)
+      piv.push_back(c0 + pcol[t]);
+    r += k;
+  }
+  return piv;
+}
+
+/// Return the rank of @a A over GF(2).
+inline std::size_t rank(gf2_matrix A, unsigned threads = 1) {
+  return rref(A, threads).size();
+}
+
+/// Return a basis of the (right) nullspace of @a A over GF(2) as the rows
+/// of a matrix, one per free column.
+inline gf2_matrix nullspace(gf2_matrix A, unsigned threads = 1) {
+  const std::vector<std::size_t> piv = rref(A, threads);
+  const std::size_t n = A.cols();
+  gf2_matrix N(n - piv.size(), n);
+  std::size_t f = 0, t = 0;
+  for (std::size_t c = 0; c != n; ++c) {
+    if (t != piv.size() && piv[t] == c) {
+      ++t;
+      continue;
+    }
+    N.set(f, c, true);
+    for (std::size_t s = 0; s != piv.size(); ++s)
+      N.set(f, piv[s], A(s, c));
+    ++f;
+  }
+  return N;
+}
+
+/**
+ *  Solve A x = b over GF(2); return false if there is no solution. The
+ *  free variables of @a x are set to zero.
+ */
+inline bool solve(const gf2_matrix &A, const std::vector<bool> &b,
+                  std::vector<bool> &x, unsigned threads = 1) {
+  assert(b.size() == A.rows());
+  const std::size_t m = A.rows(), n = A.cols();
+  gf2_matrix Ab(m, n + 1);
+  for (std::size_t i = 0; i != m; ++i) {
+    std::copy(A.row(i), A.row(i) + A.words(), Ab.row(i));
+    Ab.set(i, n, b[i]);
+  }
+  const std::vector<std::size_t> piv = rref(Ab, threads);
+  if (!piv.empty() && piv.back() == n)
+    return false;
+  x.assign(n, false);
+  for (std::size_t t = 0; t != piv.size(); ++t)
+    x[piv[t]] = Ab(t, n);
+  return true;
+}
+
+/** @} */
+} // namespace fun
+
+#endif
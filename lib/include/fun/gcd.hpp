@@ -0,0 +1,245 @@
+// The template and inlines for the -*- C++ -*- greatest common divisor.
+// Initially implemented by Wai-Shing Luk <luk036@gmail.com>
+//
+
+/** @file include/gcd.hpp
+ *  This is a C++ Library header.
+ */
+
+#ifndef FUN_GCD_HPP
+#define FUN_GCD_HPP 1
+
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility> // for std::swap
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h> // for _BitScanForward64, _BitScanReverse64
+#endif
+
+#if defined(__SIZEOF_INT128__)
+#define FUN_HAS_INT128 1
+#endif
+
+namespace fun {
+/**
+ * @defgroup gcd Greatest Common Divisor
+ * @ingroup arithmetic
+ *
+ * Shared gcd engine for the rational number classes:
+ *  - Stein's binary gcd (count-trailing-zeros) for machine words,
+ *  - Lehmer's gcd for wide integers (128-bit and beyond),
+ *  - Euclid's algorithm for anything else.
+ * @{
+ */
+
+#ifdef FUN_HAS_INT128
+__extension__ typedef __int128 int128_t;
+__extension__ typedef unsigned __int128 uint128_t;
+#endif
+
+namespace detail {
+
+/// Return the number of trailing zero bits of @a x (x != 0)
+inline constexpr int ctz64(std::uint64_t x) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+  return __builtin_ctzll(x);
+#elif defined(_MSC_VER) && defined(_M_X64)
+  unsigned long i;
+  _BitScanForward64(&i, x);
+  return int(i);
+#else
+  int n = 0;
+  for (; (x & 1U) == 0; x >>= 1)
+    ++n;
+  return n;
+#endif
+}
+
+/// Return the number of leading zero bits of @a x (x != 0)
+inline constexpr int clz64(std::uint64_t x) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+  return __builtin_clzll(x);
+#elif defined(_MSC_VER) && defined(_M_X64)
+  unsigned long i;
+  _BitScanReverse64(&i, x);
+  return 63 - int(i);
+#else
+  int n = 0;
+  for (; (x & (std::uint64_t(1) << 63)) == 0; x <<= 1)
+    ++n;
+  return n;
+#endif
+}
+
+/// Return the number of one bits of @a x
+inline constexpr int popcount64(std::uint64_t x) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+  return __builtin_popcountll(x);
+#else
+  x -= (x >> 1) & 0x5555555555555555ULL; // SWAR
+  x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+  x = (x + (x >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+  return int((x * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+/// Unsigned counterpart of an integer type (also for 128-bit types)
+template <typename _Z> struct make_unsigned : std::make_unsigned<_Z> {};
+#ifdef FUN_HAS_INT128
+template <> struct make_unsigned<int128_t> { typedef uint128_t type; };
+template <> struct make_unsigned<uint128_t> { typedef uint128_t type; };
+#endif
+
+/// Return |a| as an unsigned value (well defined for the minimum value)
+template <typename _Z>
+inline constexpr typename make_unsigned<_Z>::type uabs(const _Z &a) noexcept {
+  typedef typename make_unsigned<_Z>::type _U;
+  return a < _Z(0) ? _U(0) - _U(a) : _U(a);
+}
+
+/// Integer-like types that provide bit_length() and conversions from/to
+/// std::uint64_t, so that fast_gcd() may use lehmer_gcd() for them
+template <typename _Z> struct use_lehmer_gcd : std::false_type {};
+
+} // namespace detail
+
+/// Return the number of significant bits of @a x
+inline constexpr int bit_length(std::uint64_t x) noexcept {
+  return x == 0 ? 0 : 64 - detail::clz64(x);
+}
+
+#ifdef FUN_HAS_INT128
+/// Return the number of significant bits of @a x
+inline constexpr int bit_length(uint128_t x) noexcept {
+  return (x >> 64) != 0 ? 128 - detail::clz64(std::uint64_t(x >> 64))
+                        : bit_length(std::uint64_t(x));
+}
+#endif
+
+/**
+ *  Stein's binary gcd for machine words.
+ *
+ *  Replaces the division of Euclid's algorithm by shifts and subtractions;
+ *  the trailing zeros are removed in one step with count-trailing-zeros.
+ */
+template <typename _U>
+inline constexpr _U binary_gcd(_U a, _U b) noexcept {
+  static_assert(std::is_unsigned<_U>::value && sizeof(_U) <= 8,
+                "binary_gcd() requires an unsigned machine word");
+  if (a == 0)
+    return b;
+  if (b == 0)
+    return a;
+  const int shift = detail::ctz64(std::uint64_t(a | b));
+  a >>= detail::ctz64(std::uint64_t(a));
+  b >>= detail::ctz64(std::uint64_t(b));
+  // Both odd from here on; written so that the compiler emits cmov's
+  while (a != b) {
+    const _U d = a > b ? _U(a - b) : _U(b - a);
+    b = a < b ? a : b;
+    a = _U(d >> detail::ctz64(std::uint64_t(d)));
+  }
+  return _U(a << shift);
+}
+
+/**
+ *  Lehmer's gcd for wide unsigned integers.
+ *
+ *  The quotient sequence is simulated on the leading 62 bits of @a a and
+ *  @a b (Knuth, TAOCP vol. 2, Algorithm 4.5.2L), so that most of the
+ *  multi-word divisions are replaced by a few word-by-multiword products.
+ *  Once @a b fits in a machine word the gcd is finished by binary_gcd().
+ *
+ *  @param  _W  Unsigned wide integer type supporting <, >>, %, * and -,
+ *              conversion from/to std::uint64_t and bit_length().
+ */
+template <typename _W> _W lehmer_gcd(_W a, _W b) {
+  const _W word_max(std::numeric_limits<std::uint64_t>::max());
+  if (a < b)
+    std::swap(a, b);
+  while (word_max < b) {
+    const int n = bit_length(a);
+    const int s = n > 62 ? n - 62 : 0;
+    std::int64_t x = std::int64_t(static_cast<std::uint64_t>(a >> s));
+    std::int64_t y = std::int64_t(static_cast<std::uint64_t>(b >> s));
+    std::int64_t A = 1, B = 0, C = 0, D = 1;
+    while (y + C != 0 && y + D != 0) {
+      const std::int64_t q = (x + A) / (y + C);
+      if (q != (x + B) / (y + D))
+        break;
+      std::int64_t t = A - q * C;
+      A = C;
+      C = t;
+      t = B - q * D;
+      B = D;
+      D = t;
+      t = x - q * y;
+      x = y;
+      y = t;
+    }
+    if (B == 0) {
+      // No progress on the leading digits: one full-precision Euclid step
+      _W r = a % b;
+      a = b;
+      b = r;
+      continue;
+    }
+    // The cosequences alternate in sign, and P*u + Q*v >= 0 always holds;
+    // accumulate the positive and the negative terms separately.
+    auto combine = [](const _W &u, std::int64_t P, const _W &v,
+                      std::int64_t Q) -> _W {
+      _W pos(0), neg(0);
+      (P >= 0 ? pos : neg) += _W(std::uint64_t(P >= 0 ? P : -P)) * u;
+      (Q >= 0 ? pos : neg) += _W(std::uint64_t(Q >= 0 ? Q : -Q)) * v;
+      return pos - neg;
+    };
+    _W a1 = combine(a, A, b, B);
+    _W b1 = combine(a, C, b, D);
+    a = a1;
+    b = b1;
+  }
+  if (b == _W(0))
+    return a;
+  const std::uint64_t r = static_cast<std::uint64_t>(a % b);
+  return _W(binary_gcd(static_cast<std::uint64_t>(b), r));
+}
+
+/**
+ *  Greatest common divisor dispatcher, always non-negative.
+ *
+ *  Machine words go to binary_gcd(), 128-bit integers (and the types
+ *  marked by detail::use_lehmer_gcd) to lehmer_gcd(), and any other
+ *  integer-like type to Euclid's algorithm.
+ */
+template <typename _Z>
+inline constexpr _Z fast_gcd(const _Z &a, const _Z &b) noexcept {
+  if constexpr (std::is_integral<_Z>::value && sizeof(_Z) <= 8) {
+    return _Z(binary_gcd(detail::uabs(a), detail::uabs(b)));
+  }
+#ifdef FUN_HAS_INT128
+  else if constexpr (std::is_same<_Z, int128_t>::value ||
+                     std::is_same<_Z, uint128_t>::value) {
+    return _Z(lehmer_gcd(detail::uabs(a), detail::uabs(b)));
+  }
+#endif
+  else if constexpr (detail::use_lehmer_gcd<_Z>::value) {
+    return lehmer_gcd(_Z(a < _Z(0) ? -a : a), _Z(b < _Z(0) ? -b : b));
+  }
+  else {
+    _Z x = a < _Z(0) ? -a : a;
+    _Z y = b < _Z(0) ? -b : b;
+    while (!(y == _Z(0))) {
+      _Z r = x % y;
+      x = y;
+      y = r;
+    }
+    return x;
+  }
+}
+
+/** @} */
+} // namespace fun
+
+#endif
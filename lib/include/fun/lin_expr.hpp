@@ -0,0 +1,355 @@
+// The template and inlines for the -*- C++ -*- lazy vector expressions.
+// Initially implemented by Wai-Shing Luk <luk036@gmail.com>
+//
+
+/** @file include/lin_expr.hpp
+ *  This is a C++ Library header.
+ */
+
+#ifndef FUN_LIN_EXPR_HPP
+#define FUN_LIN_EXPR_HPP 1
+
+#include <functional>  // for std::plus, std::minus, std::negate
+#include <tuple>       // for std::tuple, std::apply
+#include <type_traits> // for std::conjunction, std::enable_if
+#include <utility>     // for std::forward, std::index_sequence
+
+#include "mat.hpp"
+
+namespace fun {
+/**
+ * @addtogroup vec
+ * @{
+ */
+
+// Forward declarations.
+template <class _Op, class... _Args> class lin_expr;
+
+namespace detail {
+
+template <typename _K, std::size_t _N>
+inline constexpr std::size_t lin_size(const vec<_K, _N> *) noexcept {
+  return _N;
+}
+
+template <typename _K, std::size_t _R, std::size_t _C>
+inline constexpr std::size_t lin_size(const mat<_K, _R, _C> *) noexcept {
+  return _R * _C;
+}
+
+//@{
+/// Return the element @a k of a vector, or of a matrix in row-major order
+template <typename _K, std::size_t _N>
+inline constexpr const _K &lin_at(const vec<_K, _N> &v, std::size_t k) {
+  return v[k];
+}
+
+template <typename _K, std::size_t _N>
+inline constexpr _K &lin_at(vec<_K, _N> &v, std::size_t k) {
+  return v[k];
+}
+
+template <typename _K, std::size_t _R, std::size_t _C>
+inline constexpr const _K &lin_at(const mat<_K, _R, _C> &A, std::size_t k) {
+  return A(k / _C, k % _C);
+}
+
+template <typename _K, std::size_t _R, std::size_t _C>
+inline constexpr _K &lin_at(mat<_K, _R, _C> &A, std::size_t k) {
+  return A(k / _C, k % _C);
+}
+//@}
+
+/// Rebind the element type of a leaf class template
+template <class _W> struct lin_rebind;
+
+template <template <typename> class _W, typename _K>
+struct lin_rebind<_W<_K>> {
+  template <typename _Up> using type = _W<_Up>;
+};
+
+/**
+ *  Operand traits. Leaves are the classes naming themselves leaf_type
+ *  (vector3, matrix3, matrix3d and their public descendants), nodes are
+ *  lin_expr; anything else is a scalar.
+ */
+template <class _T, class = void> struct lin_traits {
+  static constexpr bool is_operand = false, is_expr = false;
+};
+
+template <class _T>
+struct lin_traits<_T, std::void_t<typename _T::leaf_type>> {
+  static constexpr bool is_operand = true, is_expr = false;
+  typedef typename _T::leaf_type leaf_type;
+  typedef typename leaf_type::value_type value_type;
+  static constexpr std::size_t size =
+      lin_size(static_cast<const leaf_type *>(nullptr));
+  template <typename _Up>
+  using result = typename lin_rebind<leaf_type>::template type<_Up>;
+};
+
+template <class _Op, class... _Args>
+struct lin_traits<lin_expr<_Op, _Args...>> {
+  static constexpr bool is_operand = true, is_expr = true;
+  typedef typename lin_expr<_Op, _Args...>::value_type value_type;
+  static constexpr std::size_t size = lin_expr<_Op, _Args...>::size;
+  template <typename _Up>
+  using result = typename lin_expr<_Op, _Args...>::template result<_Up>;
+};
+
+template <class _T>
+struct lin_is_operand : std::bool_constant<lin_traits<_T>::is_operand> {};
+
+/// Neither a vector/matrix nor a vec or mat (a scalar)
+template <class _T, class = void> struct lin_is_scalar : std::true_type {};
+
+template <class _T>
+struct lin_is_scalar<_T, std::void_t<decltype(lin_size(
+                             std::declval<const _T *>()))>>
+    : std::false_type {};
+
+template <class _T>
+struct lin_is_expr : std::bool_constant<lin_traits<_T>::is_expr> {};
+
+template <template <typename> class _W, class _T>
+struct lin_family_is
+    : std::is_same<typename lin_traits<_T>::template result<int>, _W<int>> {};
+
+template <class _T, class _U>
+struct lin_same_family
+    : std::is_same<typename lin_traits<_T>::template result<int>,
+                   typename lin_traits<_U>::template result<int>> {};
+
+/// Both @a _A and @a _B are vectors/matrices of the same kind
+template <class _A, class _B>
+using if_lin_pair = std::enable_if_t<std::conjunction<
+    lin_is_operand<std::decay_t<_A>>, lin_is_operand<std::decay_t<_B>>,
+    lin_same_family<std::decay_t<_A>, std::decay_t<_B>>>::value>;
+
+/// @a _A is a vector/matrix and @a _S is a scalar
+template <class _A, class _S>
+using if_lin_scalar = std::enable_if_t<
+    lin_is_operand<std::decay_t<_A>>::value &&
+    !lin_is_operand<std::decay_t<_S>>::value &&
+    lin_is_scalar<std::decay_t<_S>>::value>;
+
+/// @a _A is a vector/matrix
+template <class _A>
+using if_lin = std::enable_if_t<lin_is_operand<std::decay_t<_A>>::value>;
+
+/// All @a _T are of the family @a _W and at least one is an expression
+template <template <typename> class _W, class... _T>
+using if_lin_family = std::enable_if_t<std::conjunction<
+    std::conjunction<lin_is_operand<std::decay_t<_T>>,
+                     lin_family_is<_W, std::decay_t<_T>>>...,
+    std::disjunction<lin_is_expr<std::decay_t<_T>>...>>::value>;
+
+/// @a _A is of the family @a _W, @a _B of the family @a _X, and at least
+/// one is an expression
+template <template <typename> class _W, class _A, template <typename> class _X,
+          class _B>
+using if_lin_families = std::enable_if_t<std::conjunction<
+    lin_is_operand<std::decay_t<_A>>, lin_is_operand<std::decay_t<_B>>,
+    lin_family_is<_W, std::decay_t<_A>>, lin_family_is<_X, std::decay_t<_B>>,
+    std::disjunction<lin_is_expr<std::decay_t<_A>>,
+                     lin_is_expr<std::decay_t<_B>>>>::value>;
+
+/// How an operand is held: nodes and scalars by value, leaves by reference
+/// unless they are temporaries
+template <class _A, class _T = std::decay_t<_A>, class = void>
+struct lin_store {
+  typedef _T type;
+};
+
+template <class _A, class _T>
+struct lin_store<_A, _T, std::void_t<typename _T::leaf_type>> {
+  typedef std::conditional_t<std::is_lvalue_reference<_A>::value,
+                             const typename _T::leaf_type &,
+                             typename _T::leaf_type>
+      type;
+};
+
+template <class _A> using lin_store_t = typename lin_store<_A>::type;
+
+/// Return the element @a k of the operand @a x (a scalar is itself)
+template <class _T>
+inline constexpr decltype(auto) lin_elem(const _T &x, std::size_t k) {
+  if constexpr (lin_traits<_T>::is_expr)
+    return x.at(k);
+  else if constexpr (lin_traits<_T>::is_operand)
+    return lin_at(static_cast<const typename lin_traits<_T>::leaf_type &>(x),
+                  k);
+  else
+    return (x);
+}
+
+/// Return the leaf @a x itself, or the value of the expression @a x
+template <class _T> inline constexpr decltype(auto) lin_value(const _T &x) {
+  if constexpr (lin_traits<_T>::is_expr)
+    return x.eval();
+  else
+    return static_cast<const typename lin_traits<_T>::leaf_type &>(x);
+}
+
+template <class... _Args> struct lin_first { typedef void type; };
+
+/// Traits of the first vector/matrix operand
+template <class _A, class... _Rest> struct lin_first<_A, _Rest...> {
+  typedef std::conditional_t<lin_traits<std::decay_t<_A>>::is_operand,
+                             lin_traits<std::decay_t<_A>>,
+                             typename lin_first<_Rest...>::type>
+      type;
+};
+
+/// Unary plus
+struct lin_pos {
+  template <class _T> constexpr auto operator()(const _T &a) const {
+    return +a;
+  }
+};
+
+template <class _Op, class... _A>
+inline constexpr lin_expr<_Op, lin_store_t<_A>...> make_lin(_A &&... a) {
+  return lin_expr<_Op, lin_store_t<_A>...>(
+      std::tuple<lin_store_t<_A>...>(std::forward<_A>(a)...));
+}
+
+template <class _Base, class _E, std::size_t... _I>
+inline constexpr _Base lin_eval(const _E &e, std::index_sequence<_I...>) {
+  return _Base(lin_elem(e, _I)...);
+}
+
+/// Evaluate the expression @a e into the vec or mat @a _Base in one pass
+template <class _Base, class _E> inline constexpr _Base lin_eval(const _E &e) {
+  return lin_eval<_Base>(e, std::make_index_sequence<lin_traits<_E>::size>{});
+}
+
+/// Apply @a op(b[k], e[k]) in place, for all elements of the vec or mat @a b
+template <class _Base, class _E, class _Op>
+inline constexpr void lin_assign(_Base &b, const _E &e, _Op op) {
+  unroll<lin_traits<_E>::size>(
+      [&](auto k) { op(lin_at(b, k), lin_elem(e, k)); });
+}
+
+} // namespace detail
+
+/**
+ *  Lazy element-wise expression of vectors or matrices: element k is
+ *  @a _Op applied to element k of every operand (scalars pass through).
+ *
+ *  Nothing is computed until the expression is assigned to a vector3,
+ *  matrix3 or matrix3d, which evaluates the whole tree in a single
+ *  unrolled pass, without a temporary per operator; this matters when
+ *  the elements are rationals or big integers. Operands that are
+ *  temporaries are held by value, so an expression may outlive them.
+ *
+ *  @param  Op    Element-wise operation
+ *  @param  Args  Operands: nodes, leaves (by reference or value), scalars
+ */
+template <class _Op, class... _Args> class lin_expr {
+  typedef typename detail::lin_first<_Args...>::type _Shape;
+
+public:
+  /// Value typedef.
+  typedef decltype(_Op()(detail::lin_elem(
+      std::declval<const std::decay_t<_Args> &>(), 0)...)) value_type;
+
+  /// Number of elements.
+  static constexpr std::size_t size = _Shape::size;
+
+  /// Type of the value, with the elements of type @a Up.
+  template <typename _Up> using result = typename _Shape::template result<_Up>;
+
+  /// Construct from the operands @a a
+  explicit constexpr lin_expr(std::tuple<_Args...> a) : _a(std::move(a)) {}
+
+  /// Return the element @a k.
+  constexpr value_type at(std::size_t k) const {
+    return std::apply(
+        [k](const auto &... a) { return _Op()(detail::lin_elem(a, k)...); },
+        _a);
+  }
+
+  /// Return the value of this expression.
+  constexpr result<value_type> eval() const {
+    return result<value_type>(*this);
+  }
+
+private:
+  std::tuple<_Args...> _a;
+};
+
+// Operators:
+///  Return @a a plus @a b (lazy).
+template <class _A, class _B, detail::if_lin_pair<_A, _B> * = nullptr>
+inline constexpr auto operator+(_A &&a, _B &&b) {
+  return detail::make_lin<std::plus<>>(std::forward<_A>(a),
+                                       std::forward<_B>(b));
+}
+
+///  Return @a a minus @a b (lazy).
+template <class _A, class _B, detail::if_lin_pair<_A, _B> * = nullptr>
+inline constexpr auto operator-(_A &&a, _B &&b) {
+  return detail::make_lin<std::minus<>>(std::forward<_A>(a),
+                                        std::forward<_B>(b));
+}
+
+//@{
+///  Return @a a times the scalar @a s (lazy).
+template <class _A, class _S, detail::if_lin_scalar<_A, _S> * = nullptr>
+inline constexpr auto operator*(_A &&a, _S &&s) {
+  return detail::make_lin<std::multiplies<>>(std::forward<_A>(a),
+                                             std::forward<_S>(s));
+}
+
+template <class _S, class _A, detail::if_lin_scalar<_A, _S> * = nullptr>
+inline constexpr auto operator*(_S &&s, _A &&a) {
+  return detail::make_lin<std::multiplies<>>(std::forward<_S>(s),
+                                             std::forward<_A>(a));
+}
+//@}
+
+///  Return @a a divided by the scalar @a s (lazy).
+template <class _A, class _S, detail::if_lin_scalar<_A, _S> * = nullptr>
+inline constexpr auto operator/(_A &&a, _S &&s) {
+  return detail::make_lin<std::divides<>>(std::forward<_A>(a),
+                                          std::forward<_S>(s));
+}
+
+/// Return @a a (lazy).
+template <class _A, detail::if_lin<_A> * = nullptr>
+inline constexpr auto operator+(_A &&a) {
+  return detail::make_lin<detail::lin_pos>(std::forward<_A>(a));
+}
+
+/// Return negation of @a a (lazy).
+template <class _A, detail::if_lin<_A> * = nullptr>
+inline constexpr auto operator-(_A &&a) {
+  return detail::make_lin<std::negate<>>(std::forward<_A>(a));
+}
+
+/// Return true if @a a is equal to @a b, element by element.
+template <class _A, class _B, detail::if_lin_pair<_A, _B> * = nullptr>
+inline constexpr bool operator==(const _A &a, const _B &b) {
+  for (std::size_t k = 0; k != detail::lin_traits<_A>::size; ++k)
+    if (!(detail::lin_elem(a, k) == detail::lin_elem(b, k)))
+      return false;
+  return true;
+}
+
+/// Return false if @a a is equal to @a b.
+template <class _A, class _B, detail::if_lin_pair<_A, _B> * = nullptr>
+inline constexpr bool operator!=(const _A &a, const _B &b) {
+  return !(a == b);
+}
+
+///  Insertion operator for expressions (prints the value).
+template <class _Stream, class _Op, class... _Args>
+_Stream &operator<<(_Stream &os, const lin_expr<_Op, _Args...> &e) {
+  return os << e.eval();
+}
+
+/** @} */
+} // namespace fun
+
+#endif
@@ -0,0 +1,410 @@
+// The template and inlines for the -*- C++ -*- fixed-size matrix classes.
+// Initially implemented by Wai-Shing Luk <luk036@gmail.com>
+//
+
+/** @file include/mat.hpp
+ *  This is a C++ Library header.
+ */
+
+#ifndef FUN_MAT_HPP
+#define FUN_MAT_HPP 1
+
+#include <array>   // for std::array
+#include <cassert>
+#include <utility> // for std::pair
+#include <vector>
+
+#include "vec.hpp"
+
+namespace fun {
+/**
+ * @addtogroup vec
+ * @{
+ */
+
+/**
+ *  Fixed-size @a R x @a C matrix, stored as @a R rows of vec<K, C>, so
+ *  that each row is register-aligned and the products are row kernels.
+ *
+ *  @param  K  Type of matrix elements
+ *  @param  R  Number of rows
+ *  @param  C  Number of columns
+ */
+template <typename _K, std::size_t _R, std::size_t _C> struct mat {
+  /// Value typedef.
+  typedef _K value_type;
+
+  /// Row typedef.
+  typedef vec<_K, _C> row_type;
+
+  /// Return the number of rows.
+  static constexpr std::size_t rows() noexcept { return _R; }
+
+  /// Return the number of columns.
+  static constexpr std::size_t cols() noexcept { return _C; }
+
+  /// Default constructor (all zeros).
+  constexpr mat() noexcept : _r{} {}
+
+  ///  Construct with its @a R * @a C elements (row-major)
+  template <typename... _Args,
+            typename = std::enable_if_t<
+                sizeof...(_Args) == _R * _C &&
+                (std::is_convertible<const _Args &, _K>::value && ...)>>
+  constexpr mat(const _Args &... a) noexcept
+      : mat(std::array<_K, _R * _C>{{_K(a)...}},
+            std::make_index_sequence<_R>{}) {}
+
+  /// Construct from the matrix @a B of another element type
+  template <typename _Up>
+  constexpr mat(const mat<_Up, _R, _C> &B) noexcept
+      : mat(B, std::make_index_sequence<_R>{}) {}
+
+  /// Return the element (@a i, @a j).
+  constexpr const _K &operator()(std::size_t i, std::size_t j) const noexcept {
+    return _r[i][j];
+  }
+
+  /// Return the element (@a i, @a j).
+  constexpr _K &operator()(std::size_t i, std::size_t j) noexcept {
+    return _r[i][j];
+  }
+
+  /// Return the row @a i.
+  constexpr const row_type &row(std::size_t i) const noexcept { return _r[i]; }
+
+  /// Return the row @a i.
+  constexpr row_type &row(std::size_t i) noexcept { return _r[i]; }
+
+  // Lets the compiler synthesize the assignment operator
+  /// Assign this matrix to matrix @a B.
+  template <typename _Up> constexpr mat &operator=(const mat<_Up, _R, _C> &B) {
+    detail::unroll<_R>([&](auto i) { _r[i] = B.row(i); });
+    return *this;
+  }
+
+  /// Add @a B to this matrix.
+  template <typename _Up>
+  constexpr mat &operator+=(const mat<_Up, _R, _C> &B) {
+    detail::unroll<_R>([&](auto i) { _r[i] += B.row(i); });
+    return *this;
+  }
+
+  /// Subtract @a B from this matrix.
+  template <typename _Up>
+  constexpr mat &operator-=(const mat<_Up, _R, _C> &B) {
+    detail::unroll<_R>([&](auto i) { _r[i] -= B.row(i); });
+    return *this;
+  }
+
+  /// Multiply this matrix by @a a.
+  template <typename _Up> constexpr mat &operator*=(const _Up &a) {
+    detail::unroll<_R>([&](auto i) { _r[i] *= a; });
+    return *this;
+  }
+
+  /// Divide this matrix by @a a.
+  template <typename _Up> constexpr mat &operator/=(const _Up &a) {
+    detail::unroll<_R>([&](auto i) { _r[i] /= a; });
+    return *this;
+  }
+
+  /// Return transpose of this matrix
+  constexpr mat<_K, _C, _R> transpose() const noexcept {
+    mat<_K, _C, _R> T;
+    detail::unroll<_R>([&](auto i) {
+      detail::unroll<_C>([&](auto j) { T(j, i) = _r[i][j]; });
+    });
+    return T;
+  }
+
+  /// Return determinant of this matrix (up to 4x4)
+  constexpr _K det() const noexcept {
+    static_assert(_R == _C && _R <= 4, "det() requires a square matrix <= 4x4");
+    const mat &A = *this;
+    if constexpr (_R == 1) {
+      return A(0, 0);
+    } else if constexpr (_R == 2) {
+      return A(0, 0) * A(1, 1) - A(0, 1) * A(1, 0);
+    } else if constexpr (_R == 3) {
+      return A(0, 0) * (A(1, 1) * A(2, 2) - A(1, 2) * A(2, 1)) -
+             A(0, 1) * (A(1, 0) * A(2, 2) - A(1, 2) * A(2, 0)) +
+             A(0, 2) * (A(1, 0) * A(2, 1) - A(1, 1) * A(2, 0));
+    } else { // Laplace expansion by the 2x2 minors of the top two rows
+      auto minor = [&A](std::size_t r, std::size_t j, std::size_t k) {
+        return A(r, j) * A(r + 1, k) - A(r, k) * A(r + 1, j);
+      };
+      return minor(0, 0, 1) * minor(2, 2, 3) - minor(0, 0, 2) * minor(2, 1, 3) +
+             minor(0, 0, 3) * minor(2, 1, 2) + minor(0, 1, 2) * minor(2, 0, 3) -
+             minor(0, 1, 3) * minor(2, 0, 2) + minor(0, 2, 3) * minor(2, 0, 1);
+    }
+  }
+
+  /// Return adjoint of this matrix (2x2 or 3x3, WildLinAlg8)
+  constexpr mat adj() const noexcept {
+    static_assert(_R == _C && (_R == 2 || _R == 3),
+                  "adj() requires a 2x2 or 3x3 matrix");
+    const mat &A = *this;
+    if constexpr (_R == 2) {
+      return mat(A(1, 1), -A(0, 1), -A(1, 0), A(0, 0));
+    } else {
+      return mat(A(1, 1) * A(2, 2) - A(1, 2) * A(2, 1),
+                 -(A(0, 1) * A(2, 2) - A(0, 2) * A(2, 1)),
+                 A(0, 1) * A(1, 2) - A(0, 2) * A(1, 1),
+                 -(A(1, 0) * A(2, 2) - A(1, 2) * A(2, 0)),
+                 A(0, 0) * A(2, 2) - A(0, 2) * A(2, 0),
+                 -(A(0, 0) * A(1, 2) - A(0, 2) * A(1, 0)),
+                 A(1, 0) * A(2, 1) - A(1, 1) * A(2, 0),
+                 -(A(0, 0) * A(2, 1) - A(0, 1) * A(2, 0)),
+                 A(0, 0) * A(1, 1) - A(0, 1) * A(1, 0));
+    }
+  }
+
+  /// Return the adjoint and the determinant of this matrix (2x2 or 3x3),
+  /// sharing the 2x2 minors: the determinant is the first row times the
+  /// first column of the adjoint (3 more products instead of 9).
+  constexpr std::pair<mat, _K> adj_det() const {
+    const mat B = adj();
+    _K d = _r[0][0] * B(0, 0);
+    for (std::size_t j = 1; j != _C; ++j)
+      d += _r[0][j] * B(j, 0);
+    return {B, d};
+  }
+
+private:
+  template <std::size_t... _I>
+  constexpr mat(const std::array<_K, _R * _C> &a,
+                std::index_sequence<_I...>) noexcept
+      : _r{make_row(a, _I * _C, std::make_index_sequence<_C>{})...} {}
+
+  template <typename _Up, std::size_t... _I>
+  constexpr mat(const mat<_Up, _R, _C> &B, std::index_sequence<_I...>) noexcept
+      : _r{row_type(B.row(_I))...} {}
+
+  template <std::size_t... _J>
+  static constexpr row_type make_row(const std::array<_K, _R * _C> &a,
+                                     std::size_t k,
+                                     std::index_sequence<_J...>) noexcept {
+    return row_type(a[k + _J]...);
+  }
+
+  row_type _r[_R];
+};
+
+// Operators:
+///  Return new matrix @a A plus @a B.
+template <typename _K, std::size_t _R, std::size_t _C>
+inline constexpr mat<_K, _R, _C> operator+(mat<_K, _R, _C> A,
+                                           const mat<_K, _R, _C> &B) {
+  return A += B;
+}
+
+///  Return new matrix @a A minus @a B.
+template <typename _K, std::size_t _R, std::size_t _C>
+inline constexpr mat<_K, _R, _C> operator-(mat<_K, _R, _C> A,
+                                           const mat<_K, _R, _C> &B) {
+  return A -= B;
+}
+
+//@{
+///  Return new matrix @a A times @a a.
+template <typename _K, std::size_t _R, std::size_t _C>
+inline constexpr mat<_K, _R, _C> operator*(mat<_K, _R, _C> A,
+                                           const detail::identity_t<_K> &a) {
+  return A *= a;
+}
+
+template <typename _K, std::size_t _R, std::size_t _C>
+inline constexpr mat<_K, _R, _C> operator*(const detail::identity_t<_K> &a,
+                                           mat<_K, _R, _C> A) {
+  return A *= a;
+}
+//@}
+
+///  Return new matrix @a A divided by @a a.
+template <typename _K, std::size_t _R, std::size_t _C>
+inline constexpr mat<_K, _R, _C> operator/(mat<_K, _R, _C> A,
+                                           const detail::identity_t<_K> &a) {
+  return A /= a;
+}
+
+/// Return @a A.
+template <typename _K, std::size_t _R, std::size_t _C>
+inline constexpr mat<_K, _R, _C> operator+(const mat<_K, _R, _C> &A) noexcept {
+  return A;
+}
+
+/// Return negation of @a A.
+template <typename _K, std::size_t _R, std::size_t _C>
+inline constexpr mat<_K, _R, _C> operator-(mat<_K, _R, _C> A) noexcept {
+  detail::unroll<_R>([&](auto i) { A.row(i) = -A.row(i); });
+  return A;
+}
+
+/**
+ *  Return new matrix @a A times @a B: row i of the product accumulates
+ *  A(i, k) * row k of @a B, one vector kernel per term.
+ */
+template <typename _K, std::size_t _R, std::size_t _M, std::size_t _C>
+inline constexpr mat<_K, _R, _C> operator*(const mat<_K, _R, _M> &A,
+                                           const mat<_K, _M, _C> &B) noexcept {
+  mat<_K, _R, _C> P;
+  detail::unroll<_R>([&](auto i) {
+    detail::unroll<_M>([&](auto k) { P.row(i).add_scaled(A(i, k), B.row(k)); });
+  });
+  return P;
+}
+
+namespace detail {
+
+template <typename _K, std::size_t _R, std::size_t _C, std::size_t... _I>
+inline constexpr vec<_K, _R> mat_vec(const mat<_K, _R, _C> &A,
+                                     const vec<_K, _C> &v,
+                                     std::index_sequence<_I...>) noexcept {
+  return vec<_K, _R>(dot(A.row(_I), v)...);
+}
+
+} // namespace detail
+
+/// Return new matrix @a A times a vector @a v.
+template <typename _K, std::size_t _R, std::size_t _C>
+inline constexpr vec<_K, _R> operator*(const mat<_K, _R, _C> &A,
+                                       const vec<_K, _C> &v) noexcept {
+  return detail::mat_vec(A, v, std::make_index_sequence<_R>{});
+}
+
+/// Return true if @a A is equal to @a B.
+template <typename _K, std::size_t _R, std::size_t _C>
+inline constexpr bool operator==(const mat<_K, _R, _C> &A,
+                                 const mat<_K, _R, _C> &B) noexcept {
+  bool equal = true;
+  detail::unroll<_R>([&](auto i) { equal = equal && A.row(i) == B.row(i); });
+  return equal;
+}
+
+/// Return false if @a A is equal to @a B.
+template <typename _K, std::size_t _R, std::size_t _C>
+inline constexpr bool operator!=(const mat<_K, _R, _C> &A,
+                                 const mat<_K, _R, _C> &B) noexcept {
+  return !(A == B);
+}
+
+/// Return transpose of the matrix @a A
+template <typename _K, std::size_t _R, std::size_t _C>
+inline constexpr mat<_K, _C, _R>
+transpose(const mat<_K, _R, _C> &A) noexcept {
+  return A.transpose();
+}
+
+/// Return determinant of the matrix @a A
+template <typename _K, std::size_t _N>
+inline constexpr _K det(const mat<_K, _N, _N> &A) noexcept {
+  return A.det();
+}
+
+namespace detail {
+/// Enable for a 2x2 or 3x3 matrix type @a _M (mat or a wrapper of it, e.g.
+/// matrix3 or matrix3d)
+template <class _M, typename _K = typename _M::value_type>
+using if_adj_mat =
+    std::enable_if_t<std::is_base_of<mat<_K, 2, 2>, _M>::value ||
+                     std::is_base_of<mat<_K, 3, 3>, _M>::value>;
+
+/// Return @a v with its elements converted to @a _Q
+template <typename _Q, typename _K, std::size_t _N>
+inline constexpr vec<_Q, _N> rebind(const vec<_K, _N> &v) {
+  return vec<_Q, _N>(v);
+}
+} // namespace detail
+
+///  Return (adj(A), det(A)): the inverse of @a A is adj(A) / det(A) if
+///  det(A) != 0. No division, so that it is exact for integers, bigint and
+///  GF(p); entries of magnitude M give |det| <= 6 M^3 for a 3x3.
+template <class _M, detail::if_adj_mat<_M> * = nullptr>
+inline constexpr std::pair<_M, typename _M::value_type>
+inverse_exact(const _M &A) {
+  const auto r = A.adj_det();
+  return {_M(r.first), r.second};
+}
+
+///  Return (adj(A) b, det(A)): the solution of A x = @a b is
+///  adj(A) b / det(A) (Cramer's rule), exact as inverse_exact.
+template <class _M, class _V, detail::if_adj_mat<_M> * = nullptr>
+inline constexpr std::pair<_V, typename _M::value_type>
+solve_exact(const _M &A, const _V &b) {
+  typedef typename _M::value_type _K;
+  constexpr std::size_t _N = _M::row_type::size();
+  const auto r = A.adj_det();
+  return {_V(static_cast<const mat<_K, _N, _N> &>(r.first) *
+             static_cast<const vec<_K, _N> &>(b)),
+          r.second};
+}
+
+///  Return the inverse of the nonsingular @a A over the field @a _Q, e.g.
+///  rat<_Tp>, or _Tp itself for GF(p): one reciprocal of det(A).
+template <typename _Q, template <typename> class _M, typename _Tp,
+          detail::if_adj_mat<_M<_Tp>> * = nullptr>
+inline constexpr _M<_Q> inverse_over(const _M<_Tp> &A) {
+  const auto r = A.adj_det();
+  _M<_Q> B(r.first);
+  B *= _Q(1) / _Q(r.second);
+  return B;
+}
+
+///  Return the solution of A x = @a b over the field @a _Q (see above).
+template <typename _Q, template <typename> class _M,
+          template <typename> class _V, typename _Tp,
+          detail::if_adj_mat<_M<_Tp>> * = nullptr>
+inline constexpr _V<_Q> solve_over(const _M<_Tp> &A, const _V<_Tp> &b) {
+  const auto r = solve_exact(A, b);
+  _V<_Q> x(detail::rebind<_Q>(r.first));
+  x *= _Q(1) / _Q(r.second);
+  return x;
+}
+
+///  Batched inverse_exact: @a adj[k] and @a det[k] of the matrices
+///  @a A[k].
+template <class _M, detail::if_adj_mat<_M> * = nullptr>
+inline void inverse_exact(const std::vector<_M> &A, std::vector<_M> &adj,
+                          std::vector<typename _M::value_type> &det) {
+  adj.resize(A.size());
+  det.resize(A.size());
+  for (std::size_t k = 0; k != A.size(); ++k) {
+    const auto r = A[k].adj_det();
+    adj[k] = r.first;
+    det[k] = r.second;
+  }
+}
+
+///  Batched solve_exact: @a x[k] / @a det[k] solves A[k] x = @a b[k].
+///  @a x may be @a b.
+template <class _M, class _V, detail::if_adj_mat<_M> * = nullptr>
+inline void solve_exact(const std::vector<_M> &A, const std::vector<_V> &b,
+                        std::vector<_V> &x,
+                        std::vector<typename _M::value_type> &det) {
+  assert(b.size() == A.size());
+  if (&x != &b)
+    x = b; // sizes x (vector3d has no default constructor)
+  det.resize(A.size());
+  for (std::size_t k = 0; k != A.size(); ++k) {
+    const auto r = solve_exact(A[k], b[k]);
+    x[k] = r.first;
+    det[k] = r.second;
+  }
+}
+
+///  Insertion operator for matrix values.
+template <typename _K, std::size_t _R, std::size_t _C, class _Stream>
+_Stream &operator<<(_Stream &os, const mat<_K, _R, _C> &A) {
+  os << '(';
+  for (std::size_t i = 0; i != _R; ++i)
+    for (std::size_t j = 0; j != _C; ++j)
+      os << (j != 0 ? "," : i != 0 ? ";" : "") << A(i, j);
+  os << ')';
+  return os;
+}
+
+/** @} */
+} // namespace fun
+
+#endif
@@ -10,6 +10,7 @@
 #define FUN_MATRIX2_HPP 1
 
 #include <sstream>
+#include "mat.hpp"
 #include "vector2.hpp"
 
 namespace fun 
@@ -26,105 +27,84 @@ namespace fun
   template<typename _Tp> struct matrix2;
 
   /** 
-   *  2x2 matrix. (a c; 
-   *               b d)
+   *  2x2 matrix, a thin wrapper of mat<Tp, 2, 2>.
+   *               (a b; 
+   *                c d)
    *
    *  @param  Tp  Type of matrix elements
    */
   template <typename _Tp>
-  struct matrix2
+  struct matrix2 : mat<_Tp, 2, 2>
   {
     /// Value typedef.
     typedef _Tp value_type;
  
     /// Default constructor.
     constexpr matrix2() 
-      : _a(0), _b(0), 
-	_c(0), _d(0) { }
+      : _Base(_Tp(0), _Tp(0), 
+	      _Tp(0), _Tp(0)) { }
 
     ///  Unspecified parameters default to 0.
     constexpr matrix2(const _Tp& a, const _Tp& b,
 		      const _Tp& c, const _Tp& d) 
-      : _a(a), _b(b), 
-	_c(c), _d(d) { }
+      : _Base(a, b, 
+	      c, d) { }
 
     // Lets the compiler synthesize the copy constructor
     // matrix2 (const matrix2<_Tp>&);
-    /// Copy constructor
+    /// Copy constructor (also from mat<Up, 2, 2>)
     template<typename _Up>
-    matrix2(const matrix2<_Up>& B) 
-      : _a(B.a()), _b(B.b()), 
-	_c(B.c()), _d(B.d()) { }
+    constexpr matrix2(const mat<_Up, 2, 2>& B) 
+      : _Base(B) { }
 
-    /// Construct from vectors
+    /// Construct from (column) vectors
     template<typename _Up>
-    matrix2(const vector2<_Up>& v1, const vector2<_Up>& v2) 
-      : _a(v1.e1()), _b(v2.e1()), 
-	_c(v1.e2()), _d(v2.e2()) { }
+    constexpr matrix2(const vector2<_Up>& v1, const vector2<_Up>& v2) 
+      : _Base(v1.e1(), v2.e1(), 
+	      v1.e2(), v2.e2()) { }
 
     /// Return first element of matrix.
-    constexpr _Tp a() { return _a; }
+    constexpr _Tp a() const { return (*this)(0, 0); }
 
     /// Return second element of matrix.
-    constexpr _Tp b() { return _b; }
+    constexpr _Tp b() const { return (*this)(0, 1); }
 
     /// Return first element of matrix.
-    constexpr _Tp c() { return _c; }
+    constexpr _Tp c() const { return (*this)(1, 0); }
 
     /// Return second element of matrix.
-    constexpr _Tp d() { return _d; }
+    constexpr _Tp d() const { return (*this)(1, 1); }
 
     // Lets the compiler synthesize the assignment operator
     // matrix2<_Tp>& operator= (const matrix2<_Tp>&);
     /// Assign this matrix to matrix @a B.
     template<typename _Up>
     matrix2<_Tp>& operator=(const matrix2<_Up>& B)
-    { 
-      _a = B.a(); _b = B.b(); 
-      _c = B.c(); _d = B.d(); 
-      return *this; 
-    }
+    { _Base::operator=(B); return *this; }
 
     /// Add @a w to this matrix.
     template<typename _Up>
     matrix2<_Tp>& operator+=(const matrix2<_Up>& B)
-    { 
-      _a += B.a(); _b += B.b(); 
-      _c += B.c(); _d += B.d();       
-      return *this;
-    }
+    { _Base::operator+=(B); return *this; }
 
     /// Subtract @a w from this matrix.
     template<typename _Up>
     matrix2<_Tp>& operator-=(const matrix2<_Up>& B)
-    { 
-      _a -= B.a(); _b -= B.b(); 
-      _c -= B.c(); _d -= B.d();       
-      return *this;
-    }
+    { _Base::operator-=(B); return *this; }
 
     /// Multiply this matrix by @a a.
     matrix2<_Tp>& operator*=(const _Tp& a) 
-    { 
-      _a *= a; _b *= a; 
-      _c *= a; _d *= a;       
-      return *this;
-    }
+    { _Base::operator*=(a); return *this; }
 
     /// Divide this matrix by @a a.
     matrix2<_Tp>& operator/=(const _Tp& a) 
-    { 
-      _a /= a; _b /= a; 
-      _c /= a; _d /= a;       
-      return *this;
-    }
+    { _Base::operator/=(a); return *this; }
 
     /// Return determinant of this matrix
-    _Tp det() { return _a * _d - _b * _c; }
+    constexpr _Tp det() const { return _Base::det(); }
 
   private:
-    _Tp _a; _Tp _b;
-    _Tp _c; _Tp _d;
+    typedef mat<_Tp, 2, 2> _Base;
   
   };
 
@@ -190,15 +170,13 @@ namespace fun
   template<typename _Tp>
   inline matrix2<_Tp>
   operator-(const matrix2<_Tp>& A)
-  { return matrix2<_Tp>(-A.a(), -A.b(),
-			-A.c(), -A.d()); }
+  { return -static_cast<const mat<_Tp, 2, 2>&>(A); }
 
   /// Return true if @a A is equal to @a B.
   template<typename _Tp>
   inline constexpr bool
   operator==(const matrix2<_Tp>& A, const matrix2<_Tp>& B)
-  { return A.a() == B.a() && A.b() == B.b() 
-      && A.c() == B.c() && A.d() == B.d(); }
+  { return static_cast<const mat<_Tp, 2, 2>&>(A) == B; }
 
   /// Return false if @a A is equal to @a B.
   template<typename _Tp>
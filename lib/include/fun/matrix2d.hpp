@@ -9,6 +9,7 @@
 #ifndef FUN_MATRIX2D_HPP
 #define FUN_MATRIX2D_HPP 1
 
+#include "mat.hpp"
 #include "vector2d.hpp"
 
 namespace fun {
@@ -24,112 +25,95 @@ namespace fun {
 template <typename _Tp> struct matrix2d;
 
 /**
- *  2x2 matrix. (a c;
- *               b d)
+ *  2x2 matrix, a thin wrapper of mat<Tp, 2, 2>.
+ *               (a b;
+ *                c d)
  *
  *  @param  Tp  Type of matrix elements
  */
-template <typename _Tp> struct matrix2d {
+template <typename _Tp> struct matrix2d : mat<_Tp, 2, 2> {
   /// Value typedef.
   typedef _Tp value_type;
 
   /// Default constructor.
-  constexpr matrix2d() noexcept : _a{0}, _b{0}, _c{0}, _d(0) {}
+  constexpr matrix2d() noexcept : _Base{} {}
 
   ///  Unspecified parameters default to 0.
   constexpr matrix2d(const _Tp &a, const _Tp &b, const _Tp &c,
                      const _Tp &d) noexcept
-      : _a{a}, _b{b}, _c{c}, _d{d} {}
+      : _Base{a, b, c, d} {}
 
   // Lets the compiler synthesize the copy constructor
   // matrix2d (const matrix2d<_Tp>&);
-  /// Copy constructor
+  /// Copy constructor (also from mat<Up, 2, 2>)
   template <typename _Up>
-  constexpr matrix2d(const matrix2d<_Up> &B) noexcept
-      : _a{B.a()}, _b{B.b()}, _c{B.c()}, _d{B.d()} {}
+  constexpr matrix2d(const mat<_Up, 2, 2> &B) noexcept : _Base{B} {}
 
-  /// Construct from vectors
+  /// Construct from (column) vectors
   template <typename _Up>
   constexpr matrix2d(const vector2d<_Up> &v1, const vector2d<_Up> &v2) noexcept
-      : _a{v1.e1()}, _b{v2.e1()}, _c{v1.e2()}, _d{v2.e2()} {}
+      : _Base{v1.e1(), v2.e1(), v1.e2(), v2.e2()} {}
 
   /// Return first element of matrix.
-  constexpr _Tp a() const noexcept { return _a; }
+  constexpr _Tp a() const noexcept { return (*this)(0, 0); }
 
   /// Return second element of matrix.
-  constexpr _Tp b() const noexcept { return _b; }
+  constexpr _Tp b() const noexcept { return (*this)(0, 1); }
 
   /// Return first element of matrix.
-  constexpr _Tp c() const noexcept { return _c; }
+  constexpr _Tp c() const noexcept { return (*this)(1, 0); }
 
   /// Return second element of matrix.
-  constexpr _Tp d() const noexcept { return _d; }
+  constexpr _Tp d() const noexcept { return (*this)(1, 1); }
 
   // Lets the compiler synthesize the assignment operator
   // matrix2d<_Tp>& operator= (const matrix2d<_Tp>&);
   /// Assign this matrix to matrix @a B.
-  template <typename _Up> matrix2d<_Tp> &operator=(const matrix2d<_Up> &B) {
-    _a = B.a();
-    _b = B.b();
-    _c = B.c();
-    _d = B.d();
+  template <typename _Up>
+  constexpr matrix2d<_Tp> &operator=(const matrix2d<_Up> &B) {
+    _Base::operator=(B);
     return *this;
   }
 
   /// Add @a w to this matrix.
-  template <typename _Up> matrix2d<_Tp> &operator+=(const matrix2d<_Up> &B) {
-    _a += B.a();
-    _b += B.b();
-    _c += B.c();
-    _d += B.d();
+  template <typename _Up>
+  constexpr matrix2d<_Tp> &operator+=(const matrix2d<_Up> &B) {
+    _Base::operator+=(B);
     return *this;
   }
 
   /// Subtract @a w from this matrix.
-  template <typename _Up> matrix2d<_Tp> &operator-=(const matrix2d<_Up> &B) {
-    _a -= B.a();
-    _b -= B.b();
-    _c -= B.c();
-    _d -= B.d();
+  template <typename _Up>
+  constexpr matrix2d<_Tp> &operator-=(const matrix2d<_Up> &B) {
+    _Base::operator-=(B);
     return *this;
   }
 
   /// Multiply this matrix by @a a.
-  matrix2d<_Tp> &operator*=(const _Tp &a) {
-    _a *= a;
-    _b *= a;
-    _c *= a;
-    _d *= a;
+  constexpr matrix2d<_Tp> &operator*=(const _Tp &a) {
+    _Base::operator*=(a);
     return *this;
   }
 
   /// Divide this matrix by @a a.
-  matrix2d<_Tp> &operator/=(const _Tp &a) {
-    _a /= a;
-    _b /= a;
-    _c /= a;
-    _d /= a;
+  constexpr matrix2d<_Tp> &operator/=(const _Tp &a) {
+    _Base::operator/=(a);
     return *this;
   }
 
   /// Return adjoint of this matrix
-  constexpr matrix2d<_Tp> adj() const noexcept {
-    return matrix2d<_Tp>(d(), -b(), -c(), a());
-  }
+  constexpr matrix2d<_Tp> adj() const noexcept { return _Base::adj(); }
 
   /// Return transpose of this matrix
   constexpr matrix2d<_Tp> transpose() const noexcept {
-    return matrix2d<_Tp>(a(), c(), b(), d());
+    return _Base::transpose();
   }
 
   /// Return determinant of this matrix
-  constexpr _Tp det() const noexcept { return _a * _d - _b * _c; }
+  constexpr _Tp det() const noexcept { return _Base::det(); }
 
 private:
-  _Tp _a;
-  _Tp _b;
-  _Tp _c;
-  _Tp _d;
+  typedef mat<_Tp, 2, 2> _Base;
 };
 
 // Operators:
@@ -177,14 +161,14 @@ inline constexpr matrix2d<_Tp> operator+(const matrix2d<_Tp> &A) noexcept {
 /// Return negation of @a A.
 template <typename _Tp>
 inline constexpr matrix2d<_Tp> operator-(const matrix2d<_Tp> &A) noexcept {
-  return matrix2d<_Tp>(-A.a(), -A.b(), -A.c(), -A.d());
+  return -static_cast<const mat<_Tp, 2, 2> &>(A);
 }
 
 /// Return true if @a A is equal to @a B.
 template <typename _Tp>
 inline constexpr bool operator==(const matrix2d<_Tp> &A,
                                  const matrix2d<_Tp> &B) noexcept {
-  return A.a() == B.a() && A.b() == B.b() && A.c() == B.c() && A.d() == B.d();
+  return static_cast<const mat<_Tp, 2, 2> &>(A) == B;
 }
 
 /// Return false if @a A is equal to @a B.
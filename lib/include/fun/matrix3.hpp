@@ -9,6 +9,7 @@
 #ifndef FUN_MATRIX3_HPP
 #define FUN_MATRIX3_HPP 1
 
+#include "lin_expr.hpp"
 #include "vector3.hpp"
 
 namespace fun {
@@ -24,249 +25,205 @@ namespace fun {
 template <typename _Tp> struct matrix3;
 
 /**
- *  3x3 matrix. (a b c;
- *               d e f;
- *               g h i)
+ *  3x3 matrix, a thin wrapper of mat<Tp, 3, 3>, with lazy element-wise
+ *  arithmetic (see lin_expr).
+ *               (a b c;
+ *                d e f;
+ *                g h i)
  *
  *  @param  Tp  Type of matrix elements
  */
-template <typename _Tp> struct matrix3 {
+template <typename _Tp> struct matrix3 : mat<_Tp, 3, 3> {
   /// Value typedef.
   typedef _Tp value_type;
 
+  /// Expression operand typedef (see lin_expr).
+  typedef matrix3<_Tp> leaf_type;
+
   /// Default constructor.
-  constexpr matrix3() noexcept
-      : _a{0}, _b{0}, _c{0}, _d{0}, _e{0}, _f{0}, _g{0}, _h{0}, _i{0} {}
+  constexpr matrix3() noexcept : _Base{} {}
 
   ///  Construct with its elements
   constexpr matrix3(const _Tp &a, const _Tp &b, const _Tp &c, const _Tp &d,
                     const _Tp &e, const _Tp &f, const _Tp &g, const _Tp &h,
                     const _Tp &i) noexcept
-      : _a{a}, _b{b}, _c{c}, _d{d}, _e{e}, _f{f}, _g{g}, _h{h}, _i{i} {}
+      : _Base{a, b, c, d, e, f, g, h, i} {}
 
   // Lets the compiler synthesize the copy constructor
   // matrix3 (const matrix3<_Tp>&);
-  /// Copy constructor
+  /// Copy constructor (also from mat<Up, 3, 3>)
   template <typename _Up>
-  constexpr matrix3(const matrix3<_Up> &B) noexcept
-      : _a{B.a()}, _b{B.b()}, _c{B.c()}, _d{B.d()}, _e{B.e()}, _f{B.f()},
-        _g{B.g()}, _h{B.h()}, _i{B.i()} {}
+  constexpr matrix3(const mat<_Up, 3, 3> &B) noexcept : _Base{B} {}
+
+  /// Construct from the value of the matrix expression @a E
+  template <class _Op, class... _Args,
+            detail::if_lin_family<matrix3, lin_expr<_Op, _Args...>> * = nullptr>
+  constexpr matrix3(const lin_expr<_Op, _Args...> &E)
+      : _Base{detail::lin_eval<_Base>(E)} {}
 
   /// Construct from vectors
   template <typename _Up>
   constexpr matrix3(const vector3<_Up> &v1, const vector3<_Up> &v2,
                     const vector3<_Up> &v3) noexcept
-      : _a{v1.e1()}, _b{v2.e1()}, _c{v3.e1()}, _d{v1.e2()}, _e{v2.e2()},
-        _f{v3.e2()}, _g{v1.e3()}, _h{v2.e3()}, _i{v3.e3()} {}
+      : _Base{v1.e1(), v2.e1(), v3.e1(), v1.e2(), v2.e2(),
+              v3.e2(), v1.e3(), v2.e3(), v3.e3()} {}
 
   /// Construct from outer_product of @a v1 and @a v2
   template <typename _Up>
   constexpr matrix3(const vector3<_Up> &v1, const vector3<_Up> &v2) noexcept
-      : _a{v1.e1() * v2.e1()}, _b{v1.e1() * v2.e2()}, _c{v1.e1() * v2.e3()},
-        _d{v1.e2() * v2.e1()}, _e{v1.e2() * v2.e2()}, _f{v1.e2() * v2.e3()},
-        _g{v1.e3() * v2.e1()}, _h{v1.e3() * v2.e2()}, _i{v1.e3() * v2.e3()} {}
+      : _Base{v1.e1() * v2.e1(), v1.e1() * v2.e2(), v1.e1() * v2.e3(),
+              v1.e2() * v2.e1(), v1.e2() * v2.e2(), v1.e2() * v2.e3(),
+              v1.e3() * v2.e1(), v1.e3() * v2.e2(), v1.e3() * v2.e3()} {}
 
   /// Return first element of matrix.
-  constexpr _Tp a() const noexcept { return _a; }
+  constexpr _Tp a() const noexcept { return (*this)(0, 0); }
 
   /// Return second element of matrix.
-  constexpr _Tp b() const noexcept { return _b; }
+  constexpr _Tp b() const noexcept { return (*this)(0, 1); }
 
   /// Return third element of matrix.
-  constexpr _Tp c() const noexcept { return _c; }
+  constexpr _Tp c() const noexcept { return (*this)(0, 2); }
 
   /// Return fourth element of matrix.
-  constexpr _Tp d() const noexcept { return _d; }
+  constexpr _Tp d() const noexcept { return (*this)(1, 0); }
 
   /// Return fifth element of matrix.
-  constexpr _Tp e() const noexcept { return _e; }
+  constexpr _Tp e() const noexcept { return (*this)(1, 1); }
 
   /// Return sixth element of matrix.
-  constexpr _Tp f() const noexcept { return _f; }
+  constexpr _Tp f() const noexcept { return (*this)(1, 2); }
 
   /// Return seventh element of matrix.
-  constexpr _Tp g() const noexcept { return _g; }
+  constexpr _Tp g() const noexcept { return (*this)(2, 0); }
 
   /// Return eighth element of matrix.
-  constexpr _Tp h() const noexcept { return _h; }
+  constexpr _Tp h() const noexcept { return (*this)(2, 1); }
 
   /// Return ninth element of matrix.
-  constexpr _Tp i() const noexcept { return _i; }
+  constexpr _Tp i() const noexcept { return (*this)(2, 2); }
 
   // Lets the compiler synthesize the assignment operator
   // matrix3<_Tp>& operator= (const matrix3<_Tp>&);
   /// Assign this matrix to matrix @a B.
-  template <typename _Up> matrix3<_Tp> &operator=(const matrix3<_Up> &B) {
-    _a = B.a();
-    _b = B.b();
-    _c = B.c();
-    _d = B.d();
-    _e = B.e();
-    _f = B.f();
-    _g = B.g();
-    _h = B.h();
-    _i = B.i();
+  template <typename _Up>
+  constexpr matrix3<_Tp> &operator=(const matrix3<_Up> &B) {
+    _Base::operator=(B);
+    return *this;
+  }
+
+  /// Assign this matrix to the value of the expression @a E.
+  template <class _Op, class... _Args,
+            detail::if_lin_family<matrix3, lin_expr<_Op, _Args...>> * = nullptr>
+  constexpr matrix3<_Tp> &operator=(const lin_expr<_Op, _Args...> &E) {
+    detail::lin_assign(static_cast<_Base &>(*this), E,
+                       [](_Tp &a, const auto &b) { a = b; });
     return *this;
   }
 
   /// Add @a w to this matrix.
-  template <typename _Up> matrix3<_Tp> &operator+=(const matrix3<_Up> &B) {
-    _a += B.a();
-    _b += B.b();
-    _c += B.c();
-    _d += B.d();
-    _e += B.e();
-    _f += B.f();
-    _g += B.g();
-    _h += B.h();
-    _i += B.i();
+  template <typename _Up>
+  constexpr matrix3<_Tp> &operator+=(const matrix3<_Up> &B) {
+    _Base::operator+=(B);
+    return *this;
+  }
+
+  /// Add the value of the expression @a E to this matrix.
+  template <class _Op, class... _Args,
+            detail::if_lin_family<matrix3, lin_expr<_Op, _Args...>> * = nullptr>
+  constexpr matrix3<_Tp> &operator+=(const lin_expr<_Op, _Args...> &E) {
+    detail::lin_assign(static_cast<_Base &>(*this), E,
+                       [](_Tp &a, const auto &b) { a += b; });
     return *this;
   }
 
   /// Subtract @a w from this matrix.
-  template <typename _Up> matrix3<_Tp> &operator-=(const matrix3<_Up> &B) {
-    _a -= B.a();
-    _b -= B.b();
-    _c -= B.c();
-    _d -= B.d();
-    _e -= B.e();
-    _f -= B.f();
-    _g -= B.g();
-    _h -= B.h();
-    _i -= B.i();
+  template <typename _Up>
+  constexpr matrix3<_Tp> &operator-=(const matrix3<_Up> &B) {
+    _Base::operator-=(B);
+    return *this;
+  }
+
+  /// Subtract the value of the expression @a E from this matrix.
+  template <class _Op, class... _Args,
+            detail::if_lin_family<matrix3, lin_expr<_Op, _Args...>> * = nullptr>
+  constexpr matrix3<_Tp> &operator-=(const lin_expr<_Op, _Args...> &E) {
+    detail::lin_assign(static_cast<_Base &>(*this), E,
+                       [](_Tp &a, const auto &b) { a -= b; });
     return *this;
   }
 
   /// Multiply this matrix by @a a.
-  matrix3<_Tp> &operator*=(const _Tp &a) {
-    _a *= a;
-    _b *= a;
-    _c *= a;
-    _d *= a;
-    _e *= a;
-    _f *= a;
-    _g *= a;
-    _h *= a;
-    _i *= a;
+  constexpr matrix3<_Tp> &operator*=(const _Tp &a) {
+    _Base::operator*=(a);
     return *this;
   }
 
   /// Divide this matrix by @a a.
-  matrix3<_Tp> &operator/=(const _Tp &a) {
-    _a /= a;
-    _b /= a;
-    _c /= a;
-    _d /= a;
-    _e /= a;
-    _f /= a;
-    _g /= a;
-    _h /= a;
-    _i /= a;
+  constexpr matrix3<_Tp> &operator/=(const _Tp &a) {
+    _Base::operator/=(a);
     return *this;
   }
 
   /// Return adjoint of this matrix (WildLinAlg8)
-  constexpr matrix3<_Tp> adj() const noexcept {
-    return matrix3<_Tp>(e() * i() - f() * h(), -(b() * i() - c() * h()),
-                        b() * f() - c() * e(), -(d() * i() - f() * g()),
-                        a() * i() - c() * g(), -(a() * f() - c() * d()),
-                        d() * h() - e() * g(), -(a() * h() - b() * g()),
-                        a() * e() - b() * d());
-  }
+  constexpr matrix3<_Tp> adj() const noexcept { return _Base::adj(); }
 
   /// Return transpose of this matrix (WildLinAlg8)
   constexpr matrix3<_Tp> transpose() const noexcept {
-    return matrix3<_Tp>(a(), d(), g(), b(), e(), h(), c(), f(), i());
+    return _Base::transpose();
   }
 
   /// Return determinant of this matrix (WildLinAlg8)
-  constexpr _Tp det() const noexcept {
-    return a() * (e() * i() - f() * h()) - b() * (d() * i() - f() * g()) +
-           c() * (d() * h() - e() * g());
+  constexpr _Tp det() const noexcept { return _Base::det(); }
+
+  /// Return adjoint and determinant of this matrix, sharing the 2x2 minors
+  /// (see also inverse_exact and solve_exact in mat.hpp)
+  constexpr std::pair<matrix3<_Tp>, _Tp> adj_det() const {
+    const auto r = _Base::adj_det();
+    return {r.first, r.second};
   }
 
 private:
-  _Tp _a, _b, _c;
-  _Tp _d, _e, _f;
-  _Tp _g, _h, _i;
+  typedef mat<_Tp, 3, 3> _Base;
 };
 
 // Operators:
-///  Return new matrix @a A plus @a B.
-template <typename _Tp>
-inline matrix3<_Tp> operator+(matrix3<_Tp> A, const matrix3<_Tp> &B) {
-  return A += B;
-}
-
-///  Return new matrix @a A minus @a B.
-template <typename _Tp>
-inline matrix3<_Tp> operator-(matrix3<_Tp> A, const matrix3<_Tp> &B) {
-  return A -= B;
-}
-
-//@{
-///  Return new matrix @a A times @a a.
-template <typename _Tp>
-inline matrix3<_Tp> operator*(matrix3<_Tp> A, const _Tp &a) {
-  return A *= a;
-}
-
-template <typename _Tp>
-inline matrix3<_Tp> operator*(const _Tp &a, matrix3<_Tp> A) {
-  return A *= a;
-}
-//@}
-
-///  Return new matrix @a A divided by @a a.
-template <typename _Tp>
-inline matrix3<_Tp> operator/(matrix3<_Tp> A, const _Tp &a) {
-  return A /= a;
-}
-
-/// Return @a A.
-template <typename _Tp>
-inline constexpr matrix3<_Tp> operator+(const matrix3<_Tp> &A) noexcept {
-  return A;
-}
-
-/// Return negation of @a A.
-template <typename _Tp>
-inline constexpr matrix3<_Tp> operator-(const matrix3<_Tp> &A) noexcept {
-  return matrix3<_Tp>(-A.a(), -A.b(), -A.c(), -A.d(), -A.e(), -A.f(), -A.g(),
-                      -A.h(), -A.i());
-}
+// The arithmetic operators +, -, * and / by scalars are the lazy ones of
+// lin_expr.
 
 /// Return new matrix @a A times @a B.
 template <typename _Tp>
 inline constexpr matrix3<_Tp> operator*(const matrix3<_Tp> &A,
                                         const matrix3<_Tp> &B) noexcept {
-  return matrix3<_Tp>(A.a() * B.a() + A.b() * B.d() + A.c() * B.g(),
-                      A.a() * B.b() + A.b() * B.e() + A.c() * B.h(),
-                      A.a() * B.c() + A.b() * B.f() + A.c() * B.i(),
-                      A.d() * B.a() + A.e() * B.d() + A.f() * B.g(),
-                      A.d() * B.b() + A.e() * B.e() + A.f() * B.h(),
-                      A.d() * B.c() + A.e() * B.f() + A.f() * B.i(),
-                      A.g() * B.a() + A.h() * B.d() + A.i() * B.g(),
-                      A.g() * B.b() + A.h() * B.e() + A.i() * B.h(),
-                      A.g() * B.c() + A.h() * B.f() + A.i() * B.i());
+  return static_cast<const mat<_Tp, 3, 3> &>(A) * B;
 }
 
 /// Return new matrix @a A times a vector @a v.
 template <typename _Tp>
 inline constexpr vector3<_Tp> operator*(const matrix3<_Tp> &A,
                                         const vector3<_Tp> &v) noexcept {
-  return vector3<_Tp>(A.a() * v.e1() + A.b() * v.e2() + A.c() * v.e3(),
-                      A.d() * v.e1() + A.e() * v.e2() + A.f() * v.e3(),
-                      A.g() * v.e1() + A.h() * v.e2() + A.i() * v.e3());
+  return static_cast<const mat<_Tp, 3, 3> &>(A) *
+         static_cast<const vec<_Tp, 3> &>(v);
+}
+
+/// Return new matrix @a A times @a B, where either is an expression.
+template <class _A, class _B,
+          detail::if_lin_family<matrix3, _A, _B> * = nullptr>
+inline constexpr auto operator*(const _A &A, const _B &B) {
+  return detail::lin_value(A) * detail::lin_value(B);
+}
+
+/// Return new matrix @a A times a vector @a v, where either is an expression.
+template <class _A, class _V,
+          detail::if_lin_families<matrix3, _A, vector3, _V> * = nullptr>
+inline constexpr auto operator*(const _A &A, const _V &v) {
+  return detail::lin_value(A) * detail::lin_value(v);
 }
 
 /// Return true if @a A is equal to @a B.
 template <typename _Tp>
 inline constexpr bool operator==(const matrix3<_Tp> &A,
                                  const matrix3<_Tp> &B) noexcept {
-  return A.a() == B.a() && A.b() == B.b() && A.c() == B.c() && A.d() == B.d() &&
-         A.e() == B.e() && A.f() == B.f() && A.g() == B.g() && A.h() == B.h() &&
-         A.i() == B.i();
+  return static_cast<const mat<_Tp, 3, 3> &>(A) == B;
 }
 
 /// Return false if @a A is equal to @a B.
@@ -277,9 +234,9 @@ inline constexpr bool operator!=(const matrix3<_Tp> &A,
 }
 
 /// Return transpose of this matrix (WildLinAlg8)
-template <typename _Tp> matrix3<_Tp> transpose(const matrix3<_Tp> &A) noexcept {
-  return matrix3<_Tp>(A.a(), A.d(), A.g(), A.b(), A.e(), A.h(), A.c(), A.f(),
-                      A.i());
+template <typename _Tp>
+constexpr matrix3<_Tp> transpose(const matrix3<_Tp> &A) noexcept {
+  return A.transpose();
 }
 
 /// Return determinant of this matrix (WildLinAlg8)
@@ -287,6 +244,20 @@ template <typename _Tp> constexpr _Tp det(const matrix3<_Tp> &A) noexcept {
   return A.det();
 }
 
+/// Return transpose of the matrix expression @a E
+template <class _Op, class... _Args,
+          detail::if_lin_family<matrix3, lin_expr<_Op, _Args...>> * = nullptr>
+constexpr auto transpose(const lin_expr<_Op, _Args...> &E) {
+  return E.eval().transpose();
+}
+
+/// Return determinant of the matrix expression @a E
+template <class _Op, class... _Args,
+          detail::if_lin_family<matrix3, lin_expr<_Op, _Args...>> * = nullptr>
+constexpr auto det(const lin_expr<_Op, _Args...> &E) {
+  return E.eval().det();
+}
+
 ///  Insertion operator for matrix values.
 template <typename _Tp, class _Stream>
 _Stream &operator<<(_Stream &os, const matrix3<_Tp> &A) {
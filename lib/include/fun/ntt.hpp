@@ -0,0 +1,384 @@
+// The template and inlines for the -*- C++ -*- number-theoretic transform.
+// Initially implemented by Wai-Shing Luk <luk036@gmail.com>
+//
+
+/** @file include/ntt.hpp
+ *  This is a C++ Library header.
+ */
+
+#ifndef FUN_NTT_HPP
+#define FUN_NTT_HPP 1
+
+#include <algorithm> // for std::min, std::max, std::reverse
+#include <cassert>
+#include <cstddef> // for std::size_t
+#include <cstdint> // for std::uint32_t, std::uint64_t
+#include <utility> // for std::pair
+#include <vector>
+
+#include "GF.hpp"        // for fun::GF
+#include "GF_mont.hpp"   // for detail::montgomery
+#include "GF_traits.hpp" // for gf_traits, detail::pow_mod64
+
+namespace fun {
+/**
+ * @defgroup ntt Number-theoretic Transform
+ * @ingroup arithmetic
+ *
+ * Polynomials over GF(p), as vectors of coefficients (lowest degree
+ * first): product, power-series inverse, division with remainder and
+ * multipoint evaluation, on top of a number-theoretic transform (NTT).
+ *
+ * The NTT of length 2^k needs 2^k | p - 1 (NTT-friendly primes, e.g.
+ * 998244353 = 119 * 2^23 + 1). Short products, and products too long
+ * for the 2-adic order of p - 1, fall back to schoolbook multiplication.
+ * @{
+ */
+
+namespace detail {
+
+/**
+ *  Radix-2 NTT over GF(p), p odd and < 2^32, on arrays of values (< p).
+ *
+ *  The forward transform (Cooley-Tukey, natural order in, bit-reversed
+ *  order out) uses the twiddle w_k = r^brv(k) for the k-th block of every
+ *  level, r a primitive root of unity of the transform length, so that
+ *  one table of n / 2 twiddles serves all levels and all lengths up to n.
+ *  The inverse (Gentleman-Sande) undoes it step by step, so that no
+ *  bit-reversal permutation is ever needed for convolutions.
+ *
+ *  The twiddles are kept in Montgomery form, so that a butterfly costs a
+ *  single REDC and the data stays in normal form. The levels with a
+ *  stride of at least a block are done over the whole array, the others
+ *  block by block while the block is in cache.
+ */
+template <std::uint64_t _p> struct ntt_engine {
+  static_assert(_p % 2 == 1 && (_p >> 32) == 0,
+                "the NTT requires an odd prime p < 2^32");
+
+  typedef std::uint32_t word;
+  typedef montgomery<_p> _Mont;
+
+  /// log2 of the longest transform, the 2-adic order of p - 1
+  static constexpr int max_log = gf_traits<_p>::two_adicity;
+
+  /// Elements per cache block
+  static constexpr std::size_t block = 1 << 12;
+
+  /// Products shorter than this are computed by schoolbook
+  static constexpr std::size_t schoolbook = 128;
+
+  static word add(word a, word b) noexcept {
+    const word t = word(_p - b);
+    return a >= t ? a - t : a + b;
+  }
+
+  static word sub(word a, word b) noexcept {
+    return a >= b ? a - b : word(a + (_p - b));
+  }
+
+  /// Return a * b, with @a b_mont = b * R mod p
+  static word mul(word a, word b_mont) noexcept {
+    return _Mont::redc(std::uint64_t(a) * b_mont);
+  }
+
+  /// Return @a a in Montgomery form
+  static word to_mont(word a) noexcept {
+    return _Mont::redc(std::uint64_t(a) * _Mont::r2);
+  }
+
+  /**
+   *  Return the twiddles of the transforms of length up to @a n (a power
+   *  of 2) in Montgomery form: w[k] = r^brv(k), r of order n (of its
+   *  inverse for @a inverse).
+   */
+  static std::vector<word> twiddles(std::size_t n, bool inverse) {
+    std::vector<word> w(std::max<std::size_t>(n / 2, 1));
+    w[0] = to_mont(1);
+    // r = root of unity of order n
+    word r = word(pow_mod64(gf_traits<_p>::root_of_unity,
+                            (std::uint64_t(1) << max_log) / n, _p));
+    if (inverse)
+      r = word(pow_mod64(r, _p - 2, _p));
+    // rh[j] = root of order 4 * 2^j; then w[h + k] = w[k] * rh[log2 h]
+    int l = 0;
+    while ((std::size_t(4) << l) < n)
+      ++l;
+    std::vector<word> rh(l + 1);
+    for (int j = l; j >= 0; --j, r = word(std::uint64_t(r) * r % _p))
+      rh[j] = to_mont(r);
+    for (std::size_t h = 1, j = 0; h < n / 2; h *= 2, ++j)
+      for (std::size_t k = 0; k != h; ++k)
+        w[h + k] = mul(w[k], rh[j]);
+    return w;
+  }
+
+  static void forward_level(word *a, std::size_t first, std::size_t last,
+                            std::size_t len, const word *w) {
+    for (std::size_t st = first; st != last; st += 2 * len) {
+      const word wk = w[st / (2 * len)];
+      for (std::size_t i = st; i != st + len; ++i) {
+        const word u = a[i], v = mul(a[i + len], wk);
+        a[i] = add(u, v);
+        a[i + len] = sub(u, v);
+      }
+    }
+  }
+
+  static void inverse_level(word *a, std::size_t first, std::size_t last,
+                            std::size_t len, const word *w) {
+    for (std::size_t st = first; st != last; st += 2 * len) {
+      const word wk = w[st / (2 * len)];
+      for (std::size_t i = st; i != st + len; ++i) {
+        const word u = a[i], v = a[i + len];
+        a[i] = add(u, v);
+        a[i + len] = mul(sub(u, v), wk);
+      }
+    }
+  }
+
+  /// In-place forward transform of length @a n, bit-reversed output
+  static void forward(word *a, std::size_t n, const word *w) {
+    const std::size_t c = std::min(n, block);
+    for (std::size_t len = n / 2; 2 * len > c; len /= 2)
+      forward_level(a, 0, n, len, w);
+    for (std::size_t c0 = 0; c0 != n; c0 += c)
+      for (std::size_t len = c / 2; len != 0; len /= 2)
+        forward_level(a, c0, c0 + c, len, w);
+  }
+
+  /// In-place inverse of forward(), times n
+  static void inverse(word *a, std::size_t n, const word *w) {
+    const std::size_t c = std::min(n, block);
+    for (std::size_t c0 = 0; c0 != n; c0 += c)
+      for (std::size_t len = 1; len < c; len *= 2)
+        inverse_level(a, c0, c0 + c, len, w);
+    for (std::size_t len = c; len < n; len *= 2)
+      inverse_level(a, 0, n, len, w);
+  }
+
+  /// Return the product of @a a and @a b (schoolbook, delayed reduction)
+  static std::vector<word> schoolbook_mul(const std::vector<word> &a,
+                                          const std::vector<word> &b) {
+    constexpr std::uint64_t terms =
+        (~std::uint64_t(0) - _p) / ((_p - 1) * (_p - 1));
+    std::vector<std::uint64_t> acc(a.size() + b.size() - 1);
+    std::uint64_t count = 0;
+    for (std::size_t i = 0; i != a.size(); ++i) {
+      if (count++ == terms) {
+        for (auto &c : acc)
+          c %= _p;
+        count = 1;
+      }
+      for (std::size_t j = 0; j != b.size(); ++j)
+        acc[i + j] += std::uint64_t(a[i]) * b[j];
+    }
+    std::vector<word> c(acc.size());
+    for (std::size_t k = 0; k != acc.size(); ++k)
+      c[k] = word(acc[k] % _p);
+    return c;
+  }
+
+  /// Return the product of @a a and @a b (non-empty)
+  static std::vector<word> multiply(std::vector<word> a, std::vector<word> b) {
+    const std::size_t m = a.size() + b.size() - 1;
+    std::size_t n = 1;
+    while (n < m)
+      n *= 2;
+    if (std::min(a.size(), b.size()) < schoolbook ||
+        n > (std::size_t(1) << std::min(max_log, 30)))
+      return schoolbook_mul(a, b);
+    const std::vector<word> w = twiddles(n, false), iw = twiddles(n, true);
+    a.resize(n);
+    b.resize(n);
+    forward(a.data(), n, w.data());
+    forward(b.data(), n, w.data());
+    // c = a * b / n: the first REDC divides by R, the second multiplies
+    // by R^2 / n
+    const word s = to_mont(to_mont(word(pow_mod64(n, _p - 2, _p))));
+    for (std::size_t k = 0; k != n; ++k)
+      a[k] = mul(mul(a[k], b[k]), s);
+    inverse(a.data(), n, iw.data());
+    a.resize(m);
+    return a;
+  }
+};
+
+/// Return the values of the polynomial @a f
+template <std::uint64_t _p>
+inline std::vector<std::uint32_t> poly_words(const std::vector<GF<_p>> &f) {
+  std::vector<std::uint32_t> a(f.size());
+  for (std::size_t k = 0; k != f.size(); ++k)
+    a[k] = std::uint32_t(f[k].value());
+  return a;
+}
+
+/// Return the polynomial of the values @a a
+template <std::uint64_t _p>
+inline std::vector<GF<_p>> poly_from_words(const std::vector<std::uint32_t> &a) {
+  std::vector<GF<_p>> f;
+  f.reserve(a.size());
+  for (std::uint32_t v : a)
+    f.emplace_back(typename GF<_p>::value_type(v));
+  return f;
+}
+
+/// Remove the leading zero coefficients of @a f
+template <std::uint64_t _p> inline void poly_trim(std::vector<GF<_p>> &f) {
+  while (!f.empty() && f.back() == GF<_p>())
+    f.pop_back();
+}
+
+} // namespace detail
+
+/**
+ *  Return the product of the polynomials @a f and @a g, by NTT above a
+ *  size threshold and by schoolbook below it.
+ */
+template <std::uint64_t _p>
+std::vector<GF<_p>> poly_multiply(const std::vector<GF<_p>> &f,
+                                  const std::vector<GF<_p>> &g) {
+  if (f.empty() || g.empty())
+    return {};
+  return detail::poly_from_words<_p>(detail::ntt_engine<_p>::multiply(
+      detail::poly_words(f), detail::poly_words(g)));
+}
+
+/**
+ *  Return the first @a n coefficients of the power series 1 / @a f
+ *  (f[0] != 0), by Newton's iteration g <- g (2 - f g).
+ */
+template <std::uint64_t _p>
+std::vector<GF<_p>> series_inverse(const std::vector<GF<_p>> &f,
+                                   std::size_t n) {
+  assert(!f.empty() && f[0] != GF<_p>());
+  std::vector<GF<_p>> g{inv(f[0])};
+  for (std::size_t k = 1; k < n; k *= 2) {
+    // e = f g - 1 vanishes below x^k; g <- g - g e mod x^2k
+    std::vector<GF<_p>> fk(f.begin(), f.begin() + std::min(f.size(), 2 * k));
+    std::vector<GF<_p>> e = poly_multiply(fk, g);
+    e.resize(2 * k);
+    e.erase(e.begin(), e.begin() + k); // e / x^k
+    std::vector<GF<_p>> ge = poly_multiply(g, e);
+    g.resize(2 * k);
+    for (std::size_t i = k; i != 2 * k; ++i)
+      g[i] = -ge[i - k];
+  }
+  g.resize(n);
+  return g;
+}
+
+/**
+ *  Divide the polynomial @a f by @a g (with a nonzero leading
+ *  coefficient): f = q g + r, deg r < deg g.
+ */
+template <std::uint64_t _p>
+void poly_divmod(const std::vector<GF<_p>> &f, const std::vector<GF<_p>> &g,
+                 std::vector<GF<_p>> &q, std::vector<GF<_p>> &r) {
+  assert(!g.empty() && g.back() != GF<_p>());
+  if (f.size() < g.size()) {
+    q.clear();
+    r = f;
+    return;
+  }
+  const std::size_t m = f.size() - g.size() + 1; // length of q
+  if (std::min(m, g.size()) < detail::ntt_engine<_p>::schoolbook) {
+    r = f;
+    q.assign(m, GF<_p>());
+    const GF<_p> s = inv(g.back());
+    for (std::size_t i = m; i-- != 0;) {
+      const GF<_p> c = r[i + g.size() - 1] * s;
+      q[i] = c;
+      if (c != GF<_p>())
+        for (std::size_t j = 0; j != g.size(); ++j)
+          r[i + j] -= c * g[j];
+    }
+  } else {
+    // rev(q) = rev(f) / rev(g) mod x^m
+    std::vector<GF<_p>> rf(f.rbegin(), f.rbegin() + m), rg(g.rbegin(), g.rend());
+    q = poly_multiply(rf, series_inverse(rg, m));
+    q.resize(m);
+    std::reverse(q.begin(), q.end());
+    const std::vector<GF<_p>> qg = poly_multiply(q, g);
+    r.assign(f.begin(), f.begin() + (g.size() - 1));
+    for (std::size_t j = 0; j != r.size(); ++j)
+      r[j] -= qg[j];
+  }
+  r.resize(g.size() - 1);
+  detail::poly_trim(r);
+}
+
+/**
+ *  Return the values of the polynomial @a f at the points @a x.
+ *
+ *  The remainders of f by the products of (X - x_i) are taken down a
+ *  subproduct tree, O(M(n) log n); small nodes are evaluated by Horner.
+ */
+template <std::uint64_t _p>
+std::vector<GF<_p>> multipoint_eval(const std::vector<GF<_p>> &f,
+                                    const std::vector<GF<_p>> &x) {
+  typedef std::vector<GF<_p>> _Poly;
+  const std::size_t n = x.size(), leaf = 32;
+  std::vector<GF<_p>> y(n);
+  if (n == 0)
+    return y;
+
+  // tree[v] = prod (X - x_i) over the points [lo, hi) of the node v
+  std::vector<_Poly> tree;
+  std::vector<std::size_t> lo, hi, left, right;
+  auto build = [&](auto &&self, std::size_t l, std::size_t h) -> std::size_t {
+    const std::size_t v = tree.size();
+    tree.emplace_back();
+    lo.push_back(l);
+    hi.push_back(h);
+    left.push_back(0);
+    right.push_back(0);
+    if (h - l <= leaf) {
+      _Poly p{GF<_p>(1U)};
+      for (std::size_t i = l; i != h; ++i) { // p *= X - x_i
+        p.push_back(p.back());
+        for (std::size_t k = p.size() - 2; k != 0; --k)
+          p[k] = p[k - 1] - x[i] * p[k];
+        p[0] = -x[i] * p[0];
+      }
+      tree[v] = std::move(p);
+    } else {
+      const std::size_t mid = l + (h - l) / 2;
+      const std::size_t a = self(self, l, mid), b = self(self, mid, h);
+      left[v] = a;
+      right[v] = b;
+      tree[v] = poly_multiply(tree[a], tree[b]);
+    }
+    return v;
+  };
+  build(build, 0, n);
+
+  // Remainders down the tree, f mod tree[v] at each node v
+  std::vector<std::pair<std::size_t, _Poly>> stack;
+  stack.emplace_back(0, f);
+  while (!stack.empty()) {
+    std::size_t v = stack.back().first;
+    _Poly g = std::move(stack.back().second);
+    stack.pop_back();
+    _Poly q, r;
+    poly_divmod(g, tree[v], q, r);
+    if (hi[v] - lo[v] <= leaf) {
+      for (std::size_t i = lo[v]; i != hi[v]; ++i) {
+        GF<_p> s;
+        for (std::size_t j = r.size(); j-- != 0;)
+          s = s * x[i] + r[j];
+        y[i] = s;
+      }
+      continue;
+    }
+    const std::size_t a = left[v], b = right[v];
+    stack.emplace_back(a, r);
+    stack.emplace_back(b, std::move(r));
+  }
+  return y;
+}
+
+/** @} */
+} // namespace fun
+
+#endif
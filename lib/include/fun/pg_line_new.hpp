@@ -0,0 +1,122 @@
+// The template and inlines for the -*- C++ -*- 3d line classes.
+// Initially implemented by Wai-Shing Luk <luk036@gmail.com>
+//
+
+/** @file include/pg_line_new.hpp
+ *  This is a C++ Library header.
+ */
+
+#ifndef FUN_PG_LINE_NEW_HPP
+#define FUN_PG_LINE_NEW_HPP 1
+
+#ifdef FUN_PG_LINE_HPP
+#error "pg_line_new.hpp redefines the classes of pg_line.hpp"
+#endif
+
+#include "pg_point_new.hpp"
+#include "vector3d_new.hpp"
+
+namespace fun {
+
+/**
+ * @defgroup 3d_line 3d Line in projective geometry
+ * @ingroup geometry
+ *
+ * Classes and functions for 3d line.
+ * @{
+ */
+
+// Forward declarations.
+template <typename _K> class pg_point;
+
+/**
+ *  Projective line represented by homogenous coordinates, stored inline
+ *  (no heap allocation).
+ *
+ *  @param  Tp  Type of line elements
+ */
+template <typename _K = int> class pg_line : public vec<_K, 3> {
+  /// Value typedef.
+  typedef _K value_type;
+  typedef vec<_K, 3> _Base;
+
+public:
+  typedef pg_point<_K> dual;
+
+  /// Default constructor.
+  ///  Unspecified parameters default to 0 (line at Infinity).
+  constexpr pg_line(const _K &a = _K(0), const _K &b = _K(0),
+                    const _K &c = _K(1)) noexcept
+      : _Base{a, b, c} {}
+
+  /// Construct from the base class @a v
+  constexpr pg_line(const _Base &v) noexcept : _Base{v} {}
+
+  /// Return the base class
+  constexpr _Base base() const noexcept { return *this; }
+
+  /// Construct by join of two points @a p and @a q (p. 53)
+  constexpr pg_line(const dual &p, const dual &q) noexcept
+      : _Base{cross(p, q)} {}
+
+  /// Return first element of line.
+  constexpr _K a() const noexcept { return (*this)[0]; }
+
+  /// Return second element of line.
+  constexpr _K b() const noexcept { return (*this)[1]; }
+
+  /// Return third element of line.
+  constexpr _K c() const noexcept { return (*this)[2]; }
+
+  /// Return true if a point @a p incident with line @a l
+  constexpr bool incident(const dual &p) const noexcept {
+    return dot(p, *this) == _K(0);
+  }
+};
+
+// Operators:
+
+/// Return true if @a l is equivalent to @a m (in projective sense).
+template <typename _K>
+inline constexpr bool operator==(const pg_line<_K> &l,
+                                 const pg_line<_K> &m) noexcept {
+  return is_zero(cross(l, m));
+}
+
+///  Return new point meet @a l and @a m (p. 53)
+template <typename _K>
+inline constexpr pg_point<_K> meet(const pg_line<_K> &l,
+                                   const pg_line<_K> &m) noexcept {
+  return cross(l, m);
+}
+
+/// Return incident of @a l and @a p
+template <typename _K>
+inline constexpr bool I(const pg_line<_K> &l, const pg_point<_K> &p) noexcept {
+  return l.incident(p);
+}
+
+///  Return new line join @a p and @a q (p. 53)
+template <typename _K>
+inline constexpr pg_line<_K> aux1(const pg_line<_K> &p,
+                                  const pg_line<_K> &q) noexcept {
+  return pg_line<_K>{p + q};
+}
+
+///  Return new line join @a p and @a q (p. 53)
+template <typename _K>
+inline constexpr pg_point<_K> aux2(const pg_line<_K> &p) noexcept {
+  return pg_point<_K>{p.base()};
+}
+
+///  Insertion operator for line values.
+template <typename _K, class _Stream>
+_Stream &operator<<(_Stream &os, const pg_line<_K> &l) {
+  os << '<' << l.a() << ':' << l.b() << ':' << l.c() << '>';
+  return os;
+}
+
+/** @} */
+} // namespace fun
+
+#endif
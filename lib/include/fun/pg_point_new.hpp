@@ -2,15 +2,19 @@
 // Initially implemented by Wai-Shing Luk <luk036@gmail.com>
 //
 
-/** @file include/pg_point.hpp
+/** @file include/pg_point_new.hpp
  *  This is a C++ Library header.
  */
 
-#ifndef FUN_PG_POINT_HPP
-#define FUN_PG_POINT_HPP 1
+#ifndef FUN_PG_POINT_NEW_HPP
+#define FUN_PG_POINT_NEW_HPP 1
 
-#include "vector3d.hpp"
-//#include "pg_line.hpp"
+#ifdef FUN_PG_POINT_HPP
+#error "pg_point_new.hpp redefines the classes of pg_point.hpp"
+#endif
+
+#include "pg_line_new.hpp"
+#include "vector3d_new.hpp"
 
 namespace fun {
 
@@ -26,15 +30,16 @@ namespace fun {
 template <typename _K> class pg_line;
 
 /**
- *  Projective poiny: one dimensional subspace of K^3
+ *  Projective poiny: one dimensional subspace of K^3, stored inline
+ *  (no heap allocation).
  *
  *  @param  _K  Type of point elements
  */
-template <typename _K = int> class pg_point : public std::valarray<_K> {
+template <typename _K = int> class pg_point : public vec<_K, 3> {
   /// Value typedef.
   typedef _K value_type;
   typedef pg_point<_K> _Self;
-  typedef std::valarray<_K> _Base;
+  typedef vec<_K, 3> _Base;
 
 public:
   typedef pg_line<_K> dual;
@@ -45,12 +50,12 @@ public:
       : _Base{a, b, c} {}
 
   /// Construct from base class.
-  constexpr pg_point(_Base v) noexcept : _Base{v} {}
+  constexpr pg_point(const _Base &v) noexcept : _Base{v} {}
 
   // Lets the compiler synthesize the copy constructor
   // pg_point (const pg_point<_K>&);
   /// Return the base class.
-  constexpr _Base base() noexcept { return *this; }
+  constexpr _Base base() const noexcept { return *this; }
 
   /// Construct by meet of two points @a l and @a m. (p. 53)
   constexpr pg_point(const dual &l, const dual &m) noexcept
@@ -60,13 +65,15 @@ public:
 // Operators:
 /// Return true if a point @a l incident with tttkkk @a p
 template <typename _K>
-inline bool operator==(const pg_point<_K> &p, const pg_point<_K> &q) noexcept {
+inline constexpr bool operator==(const pg_point<_K> &p,
+                                 const pg_point<_K> &q) noexcept {
   return is_zero(cross(p, q));
 }
 
 /// Return true if a point @a l incident with tttkkk @a p
 template <typename _K>
-inline bool incident(const pg_point<_K> &p, const pg_line<_K> &l) noexcept {
+inline constexpr bool incident(const pg_point<_K> &p,
+                               const pg_line<_K> &l) noexcept {
   return dot(p, l) == _K(0);
 }
 
@@ -0,0 +1,493 @@
+// The template and inlines for the -*- C++ -*- arrays of 3d points and lines.
+// Initially implemented by Wai-Shing Luk <luk036@gmail.com>
+//
+
+/** @file include/point3_array.hpp
+ *  This is a C++ Library header.
+ */
+
+#ifndef FUN_POINT3_ARRAY_HPP
+#define FUN_POINT3_ARRAY_HPP 1
+
+#include <algorithm> // for std::min
+#include <array>
+#include <boost/iterator/iterator_facade.hpp>
+#include <cassert>
+#include <cstddef> // for std::size_t
+#include <new>     // for std::align_val_t
+#include <vector>
+
+#include "GF_array.hpp" // for detail::gf_kernel
+#include "line3.hpp"
+#include "point3.hpp"
+#include "vec.hpp" // for detail::vec_simd
+
+namespace fun {
+/**
+ * @defgroup 3d_array Arrays of 3d points and lines
+ * @ingroup geometry
+ *
+ * Structure-of-arrays containers of points and lines, with batched
+ * incidence kernels.
+ * @{
+ */
+
+namespace detail {
+
+/**
+ *  Allocator of storage aligned to @a _Align bytes. Elements constructed
+ *  without arguments are default-initialized, so that the outputs of the
+ *  kernels below are not zeroed before being overwritten.
+ */
+template <typename _Tp, std::size_t _Align = 64> struct aligned_allocator {
+  typedef _Tp value_type;
+
+  template <typename _Up> struct rebind {
+    typedef aligned_allocator<_Up, _Align> other;
+  };
+
+  aligned_allocator() = default;
+
+  template <typename _Up>
+  constexpr aligned_allocator(const aligned_allocator<_Up, _Align> &) noexcept {}
+
+  _Tp *allocate(std::size_t n) {
+    return static_cast<_Tp *>(
+        ::operator new(n * sizeof(_Tp), std::align_val_t(_Align)));
+  }
+
+  void deallocate(_Tp *p, std::size_t) noexcept {
+    ::operator delete(p, std::align_val_t(_Align));
+  }
+
+  template <typename _Up> void construct(_Up *p) {
+    ::new (static_cast<void *>(p)) _Up;
+  }
+
+  template <typename _Up, typename... _Args>
+  void construct(_Up *p, _Args &&... a) {
+    ::new (static_cast<void *>(p)) _Up(std::forward<_Args>(a)...);
+  }
+
+  friend bool operator==(const aligned_allocator &,
+                         const aligned_allocator &) noexcept {
+    return true;
+  }
+
+  friend bool operator!=(const aligned_allocator &,
+                         const aligned_allocator &) noexcept {
+    return false;
+  }
+};
+
+/// One lane of @a _K: the scalar counterpart of vec_simd
+template <typename _K> struct coord3_one {
+  typedef _K reg;
+  static constexpr std::size_t lanes = 1;
+  static const _K &load(const _K *p) noexcept { return *p; }
+  static void store(_K *p, const _K &a) { *p = a; }
+  static _K add(const _K &a, const _K &b) { return a + b; }
+  static _K sub(const _K &a, const _K &b) { return a - b; }
+  static _K mul(const _K &a, const _K &b) { return a * b; }
+};
+
+template <class _S> constexpr bool simd_has_mul() noexcept {
+  if constexpr (_S::lanes != 0)
+    return _S::has_mul;
+  else
+    return false;
+}
+
+/// The widest SIMD registers of @a _K with a multiplication, if any
+template <typename _K>
+using coord3_simd = std::conditional_t<
+    simd_has_mul<vec_simd<_K, 32>>(), vec_simd<_K, 32>,
+    std::conditional_t<simd_has_mul<vec_simd<_K, 16>>(), vec_simd<_K, 16>,
+                       coord3_one<_K>>>;
+
+/**
+ *  Batched kernels of triples stored by coordinates (a[0][i], a[1][i],
+ *  a[2][i]): the bulk runs on coord3_simd (8 lanes of float or int32 or
+ *  4 of double or int64 with AVX2), the remainder, and any K without
+ *  SIMD, one lane at a time. Each lane loads all its inputs before it
+ *  stores, so that the output may alias an input.
+ */
+template <typename _K, class = void> struct coord3_kernel {
+  typedef _K word;
+  typedef coord3_simd<_K> _Vec;
+  typedef coord3_one<_K> _One;
+
+  static const word &to_word(const _K &a) noexcept { return a; }
+  static const _K &from_word(const word &w) noexcept { return w; }
+
+  /// Apply @a f(B, i) to the lanes i, i + 1, ... of [0, n)
+  template <class _F> static void for_each(std::size_t n, _F f) {
+    std::size_t i = 0;
+    if constexpr (_Vec::lanes > 1)
+      for (; i + _Vec::lanes <= n; i += _Vec::lanes)
+        f(_Vec(), i);
+    for (; i != n; ++i)
+      f(_One(), i);
+  }
+
+  /// r = a x b, lane-wise
+  static void cross(const word *const a[3], const word *const b[3],
+                    word *const r[3], std::size_t n) {
+    for_each(n, [=](auto B, std::size_t i) {
+      const auto x1 = B.load(a[0] + i), x2 = B.load(a[1] + i),
+                 x3 = B.load(a[2] + i);
+      const auto y1 = B.load(b[0] + i), y2 = B.load(b[1] + i),
+                 y3 = B.load(b[2] + i);
+      B.store(r[0] + i, B.sub(B.mul(x2, y3), B.mul(x3, y2)));
+      B.store(r[1] + i, B.sub(B.mul(x3, y1), B.mul(x1, y3)));
+      B.store(r[2] + i, B.sub(B.mul(x1, y2), B.mul(x2, y1)));
+    });
+  }
+
+  /// r = dot(a, b), lane-wise
+  static void dot3(const word *const a[3], const word *const b[3], _K *r,
+                   std::size_t n) {
+    for_each(n, [=](auto B, std::size_t i) {
+      const auto t = B.add(B.mul(B.load(a[0] + i), B.load(b[0] + i)),
+                           B.mul(B.load(a[1] + i), B.load(b[1] + i)));
+      B.store(r + i, B.add(t, B.mul(B.load(a[2] + i), B.load(b[2] + i))));
+    });
+  }
+
+  /// r = det(a, b, c) = dot(a, b x c), lane-wise
+  static void det3(const word *const a[3], const word *const b[3],
+                   const word *const c[3], _K *r, std::size_t n) {
+    for_each(n, [=](auto B, std::size_t i) {
+      const auto y1 = B.load(b[0] + i), y2 = B.load(b[1] + i),
+                 y3 = B.load(b[2] + i);
+      const auto z1 = B.load(c[0] + i), z2 = B.load(c[1] + i),
+                 z3 = B.load(c[2] + i);
+      const auto t =
+          B.add(B.mul(B.load(a[0] + i), B.sub(B.mul(y2, z3), B.mul(y3, z2))),
+                B.mul(B.load(a[1] + i), B.sub(B.mul(y3, z1), B.mul(y1, z3))));
+      B.store(r + i, B.add(t, B.mul(B.load(a[2] + i),
+                                    B.sub(B.mul(y1, z2), B.mul(y2, z1)))));
+    });
+  }
+};
+
+/**
+ *  Kernels of GF(p), p odd and < 2^31: the coordinates are stored as
+ *  32-bit words (< p) and processed by the kernels of gf_array.
+ */
+template <std::uint64_t _p>
+struct coord3_kernel<GF<_p>,
+                     std::enable_if_t<_p % 2 == 1 && _p < (1U << 31)>> {
+  typedef std::uint32_t word;
+  typedef gf_kernel<_p> _Gf;
+  static constexpr std::size_t block = 256;
+
+  static word to_word(const GF<_p> &a) noexcept { return word(a.value()); }
+  static GF<_p> from_word(word w) noexcept { return GF<_p>(w); }
+
+  static void cross(const word *const a[3], const word *const b[3],
+                    word *const r[3], std::size_t n) {
+    _Gf::cross(a, b, r, n);
+  }
+
+  static void dot3(const word *const a[3], const word *const b[3],
+                   GF<_p> *r, std::size_t n) {
+    word t[block];
+    for (std::size_t i = 0; i < n; i += block) {
+      const std::size_t m = std::min(block, n - i);
+      const word *a1[3] = {a[0] + i, a[1] + i, a[2] + i};
+      const word *b1[3] = {b[0] + i, b[1] + i, b[2] + i};
+      _Gf::dot3(a1, b1, t, m);
+      for (std::size_t j = 0; j != m; ++j)
+        r[i + j] = from_word(t[j]);
+    }
+  }
+
+  static void det3(const word *const a[3], const word *const b[3],
+                   const word *const c[3], GF<_p> *r, std::size_t n) {
+    word u[3][block];
+    for (std::size_t i = 0; i < n; i += block) {
+      const std::size_t m = std::min(block, n - i);
+      const word *b1[3] = {b[0] + i, b[1] + i, b[2] + i};
+      const word *c1[3] = {c[0] + i, c[1] + i, c[2] + i};
+      word *const u1[3] = {u[0], u[1], u[2]};
+      _Gf::cross(b1, c1, u1, m);
+      const word *a1[3] = {a[0] + i, a[1] + i, a[2] + i};
+      const word *u2[3] = {u[0], u[1], u[2]};
+      dot3(a1, u2, r + i, m);
+    }
+  }
+};
+
+} // namespace detail
+
+/// Contiguous storage of @a K aligned to a cache line
+template <typename _K>
+using aligned_vector = std::vector<_K, detail::aligned_allocator<_K>>;
+
+/**
+ *  Array of points (or lines) of the projective plane, stored as a
+ *  structure of arrays: the coordinates x, y and z are three separate
+ *  aligned arrays, so that the batched join, meet, dot, incident and det
+ *  below process several elements per SIMD instruction (AVX2, SSE or
+ *  NEON) for float, double, int32 and int64, and run the gf_array
+ *  kernels for GF<p>; any other K is processed one element at a time.
+ *  The elements are read as values of point3<K> (or line3<K>).
+ *
+ *  @param  K  Type of coordinates
+ *  @param  P  Class template of the elements (point3 or line3)
+ */
+template <typename _K, template <typename> class _P> class coord3_array {
+  typedef detail::coord3_kernel<_K> _Kernel;
+
+public:
+  /// Element typedef (read by value).
+  typedef _P<_K> value_type;
+
+  /// Coordinate typedef.
+  typedef _K coord_type;
+
+  /// Storage typedef of the coordinates.
+  typedef typename _Kernel::word word;
+
+  /// Random access iterator yielding the elements by value.
+  class const_iterator
+      : public boost::iterator_facade<const_iterator, value_type,
+                                      boost::random_access_traversal_tag,
+                                      value_type> {
+  public:
+    const_iterator() = default;
+
+  private:
+    friend class boost::iterator_core_access;
+    friend class coord3_array;
+
+    const_iterator(const coord3_array *a, std::size_t i) : _a(a), _i(i) {}
+
+    value_type dereference() const { return (*_a)[_i]; }
+    bool equal(const const_iterator &it) const { return _i == it._i; }
+    void increment() { ++_i; }
+    void decrement() { --_i; }
+    void advance(std::ptrdiff_t n) { _i += n; }
+    std::ptrdiff_t distance_to(const const_iterator &it) const {
+      return std::ptrdiff_t(it._i) - std::ptrdiff_t(_i);
+    }
+
+    const coord3_array *_a = nullptr;
+    std::size_t _i = 0;
+  };
+
+  /// Default constructor (empty).
+  coord3_array() = default;
+
+  /// Construct @a n copies of @a p.
+  explicit coord3_array(std::size_t n, const value_type &p = value_type())
+      : _c{_Store(n, _Kernel::to_word(p[0])), _Store(n, _Kernel::to_word(p[1])),
+           _Store(n, _Kernel::to_word(p[2]))} {}
+
+  /// Construct from the elements of [@a first, @a last).
+  template <class _InputIterator>
+  coord3_array(_InputIterator first, _InputIterator last) {
+    for (; first != last; ++first)
+      push_back(*first);
+  }
+
+  /// Return the number of elements.
+  std::size_t size() const noexcept { return _c[0].size(); }
+
+  /// Return true if there is no element.
+  bool empty() const noexcept { return _c[0].empty(); }
+
+  /// Reserve the storage of @a n elements.
+  void reserve(std::size_t n) {
+    for (auto &c : _c)
+      c.reserve(n);
+  }
+
+  /// Resize to @a n elements; the new ones are unspecified.
+  void resize(std::size_t n) {
+    for (auto &c : _c)
+      c.resize(n);
+  }
+
+  /// Remove all elements.
+  void clear() noexcept {
+    for (auto &c : _c)
+      c.clear();
+  }
+
+  /// Return the element @a i.
+  value_type operator[](std::size_t i) const {
+    return value_type(_Kernel::from_word(_c[0][i]),
+                      _Kernel::from_word(_c[1][i]),
+                      _Kernel::from_word(_c[2][i]));
+  }
+
+  /// Set the element @a i to @a p.
+  void set(std::size_t i, const vector3<_K> &p) {
+    for (std::size_t k = 0; k != 3; ++k)
+      _c[k][i] = _Kernel::to_word(p[k]);
+  }
+
+  /// Append @a p.
+  void push_back(const vector3<_K> &p) {
+    for (std::size_t k = 0; k != 3; ++k)
+      _c[k].push_back(_Kernel::to_word(p[k]));
+  }
+
+  /// Return an iterator to the first element.
+  const_iterator begin() const noexcept { return const_iterator(this, 0); }
+
+  /// Return an iterator past the last element.
+  const_iterator end() const noexcept { return const_iterator(this, size()); }
+
+  /// Return the coordinates @a k of all elements.
+  const word *data(std::size_t k) const noexcept { return _c[k].data(); }
+
+  /// Return the coordinates @a k of all elements.
+  word *data(std::size_t k) noexcept { return _c[k].data(); }
+
+  /// Return the addresses of the coordinates of the element @a i.
+  std::array<const word *, 3> coords(std::size_t i = 0) const noexcept {
+    return {{_c[0].data() + i, _c[1].data() + i, _c[2].data() + i}};
+  }
+
+  /// Return the addresses of the coordinates of the element @a i.
+  std::array<word *, 3> coords(std::size_t i = 0) noexcept {
+    return {{_c[0].data() + i, _c[1].data() + i, _c[2].data() + i}};
+  }
+
+  /// Return true if @a a is equal to @a b (coordinate-wise).
+  friend bool operator==(const coord3_array &a, const coord3_array &b) {
+    return a._c[0] == b._c[0] && a._c[1] == b._c[1] && a._c[2] == b._c[2];
+  }
+
+  /// Return false if @a a is equal to @a b.
+  friend bool operator!=(const coord3_array &a, const coord3_array &b) {
+    return !(a == b);
+  }
+
+private:
+  typedef std::vector<word, detail::aligned_allocator<word>> _Store;
+
+  _Store _c[3];
+};
+
+/// Array of points of the projective plane (see coord3_array)
+template <typename _K> using point3_array = coord3_array<_K, point3>;
+
+/// Array of lines of the projective plane (see coord3_array)
+template <typename _K> using line3_array = coord3_array<_K, line3>;
+
+namespace detail {
+
+/// Store the element-wise cross products of @a v and @a w into @a r
+template <typename _K, template <typename> class _P,
+          template <typename> class _R>
+inline void cross3(const coord3_array<_K, _P> &v,
+                   const coord3_array<_K, _P> &w, coord3_array<_K, _R> &r) {
+  assert(v.size() == w.size());
+  r.resize(v.size());
+  coord3_kernel<_K>::cross(v.coords().data(), w.coords().data(),
+                           r.coords().data(), v.size());
+}
+
+} // namespace detail
+
+//@{
+///  Return the lines joining @a p[i] and @a q[i] (into @a l, so that its
+///  storage is reused).
+template <typename _K>
+inline void join(const point3_array<_K> &p, const point3_array<_K> &q,
+                 line3_array<_K> &l) {
+  detail::cross3(p, q, l);
+}
+
+template <typename _K>
+inline line3_array<_K> join(const point3_array<_K> &p,
+                            const point3_array<_K> &q) {
+  line3_array<_K> l;
+  join(p, q, l);
+  return l;
+}
+//@}
+
+//@{
+///  Return the points where @a l[i] and @a m[i] meet (into @a p, so that
+///  its storage is reused).
+template <typename _K>
+inline void meet(const line3_array<_K> &l, const line3_array<_K> &m,
+                 point3_array<_K> &p) {
+  detail::cross3(l, m, p);
+}
+
+template <typename _K>
+inline point3_array<_K> meet(const line3_array<_K> &l,
+                             const line3_array<_K> &m) {
+  point3_array<_K> p;
+  meet(l, m, p);
+  return p;
+}
+//@}
+
+//@{
+///  Return the values dot(@a v[i], @a w[i]), e.g. of points and lines
+///  (into @a r, so that its storage is reused).
+template <typename _K, template <typename> class _P,
+          template <typename> class _Q>
+inline void dot(const coord3_array<_K, _P> &v, const coord3_array<_K, _Q> &w,
+                aligned_vector<_K> &r) {
+  assert(v.size() == w.size());
+  r.resize(v.size());
+  detail::coord3_kernel<_K>::dot3(v.coords().data(), w.coords().data(),
+                                  r.data(), v.size());
+}
+
+template <typename _K, template <typename> class _P,
+          template <typename> class _Q>
+inline aligned_vector<_K> dot(const coord3_array<_K, _P> &v,
+                              const coord3_array<_K, _Q> &w) {
+  aligned_vector<_K> r;
+  dot(v, w, r);
+  return r;
+}
+//@}
+
+///  Return the flags of whether @a p[i] is incident with @a l[i].
+template <typename _K>
+inline std::vector<bool> incident(const point3_array<_K> &p,
+                                  const line3_array<_K> &l) {
+  constexpr std::size_t block = 256; // the dot products of a block
+  const std::size_t n = p.size();
+  assert(l.size() == n);
+  std::vector<bool> r(n);
+  alignas(64) _K t[block];
+  for (std::size_t i = 0; i < n; i += block) {
+    const std::size_t m = std::min(block, n - i);
+    detail::coord3_kernel<_K>::dot3(p.coords(i).data(), l.coords(i).data(), t,
+                                    m);
+    for (std::size_t j = 0; j != m; ++j)
+      r[i + j] = t[j] == _K(0);
+  }
+  return r;
+}
+
+/**
+ *  Return the values det(@a a[i], @a b[i], @a c[i]): the zeros are the
+ *  collinear points (or the concurrent lines).
+ */
+template <typename _K, template <typename> class _P>
+inline aligned_vector<_K> det(const coord3_array<_K, _P> &a,
+                              const coord3_array<_K, _P> &b,
+                              const coord3_array<_K, _P> &c) {
+  assert(b.size() == a.size() && c.size() == a.size());
+  aligned_vector<_K> r(a.size());
+  detail::coord3_kernel<_K>::det3(a.coords().data(), b.coords().data(),
+                                  c.coords().data(), r.data(), a.size());
+  return r;
+}
+
+/** @} */
+} // namespace fun
+
+#endif
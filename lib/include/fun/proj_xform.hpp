@@ -1,17 +1,337 @@
-#ifndef _PROJ_XFORM_HPP
-#define _PROJ_XFORM_HPP 1
+// The template and inlines for the -*- C++ -*- projective transforms.
+// Initially implemented by Wai-Shing Luk <luk036@gmail.com>
+//
+
+/** @file include/proj_xform.hpp
+ *  This is a C++ Library header.
+ */
+
+#ifndef FUN_PROJ_XFORM_HPP
+#define FUN_PROJ_XFORM_HPP 1
+
+#include <cstddef> // for std::size_t
+#include <type_traits>
 
-// xxx #include "point3.hpp"
-// xxx #include "line3.hpp"
 #include "matrix3d.hpp"
 #include "point2d.hpp"
+#include "point3_array.hpp" // for point3_array, aligned_vector
 
 namespace fun {
+/**
+ * @defgroup proj_xform Projective transforms
+ * @ingroup geometry
+ *
+ * Homographies of the projective plane given by 3x3 matrices: the
+ * four-point solve, composition of chains and batched application to
+ * arrays of points.
+ * @{
+ */
+
+namespace detail {
 
-/// Create correcting perspective matrix
+/// Return the matrix mapping e1, e2, e3 and (1, 1, 1) to @a A, @a B, @a C
+/// and @a D (up to scale); singular if three of them are collinear.
 template <typename _Tp>
-matrix3d<_Tp> correct_persp(const point2d<_Tp> &A, const point2d<_Tp> &B,
-                            const point2d<_Tp> &C, const point2d<_Tp> &D);
+constexpr matrix3d<_Tp> persp_basis(const point2d<_Tp> &A,
+                                    const point2d<_Tp> &B,
+                                    const point2d<_Tp> &C,
+                                    const point2d<_Tp> &D) {
+  const matrix3d<_Tp> P(A.x(), B.x(), C.x(), A.y(), B.y(), C.y(), _Tp(1),
+                        _Tp(1), _Tp(1));
+  // D = P * l; the adjoint solves it without division, up to det(P)
+  const vec<_Tp, 3> l = P.adj() * vec<_Tp, 3>(D.x(), D.y(), _Tp(1));
+  return matrix3d<_Tp>(A.x() * l[0], B.x() * l[1], C.x() * l[2],
+                       A.y() * l[0], B.y() * l[1], C.y() * l[2], l[0], l[1],
+                       l[2]);
+}
+
+/// One lane of @a _K: coord3_one with the broadcast and division
+template <typename _K> struct xform_one : coord3_one<_K> {
+  static const _K &set1(const _K &a) noexcept { return a; }
+  static _K div(const _K &a, const _K &b) { return a / b; }
+};
+
+template <class _S> constexpr bool simd_has_div() noexcept {
+  if constexpr (_S::lanes != 0)
+    return _S::has_div;
+  else
+    return false;
+}
+
+/// The widest SIMD registers of @a _K with a division, if any
+template <typename _K>
+using xform_simd = std::conditional_t<
+    simd_has_div<vec_simd<_K, 32>>(), vec_simd<_K, 32>,
+    std::conditional_t<simd_has_div<vec_simd<_K, 16>>(), vec_simd<_K, 16>,
+                       xform_one<_K>>>;
+
+/// The widest SIMD registers of @a _K with a multiplication, if any
+template <typename _K>
+using xform_ring_simd = std::conditional_t<
+    simd_has_mul<vec_simd<_K, 32>>(), vec_simd<_K, 32>,
+    std::conditional_t<simd_has_mul<vec_simd<_K, 16>>(), vec_simd<_K, 16>,
+                       xform_one<_K>>>;
+
+/// Apply @a f(B, i) to the lanes i, i + 1, ... of [0, n): the bulk on
+/// @a _Vec, the remainder one lane at a time. The arrays must be aligned
+/// (aligned_vector).
+template <class _Vec, typename _K, class _F>
+inline void xform_for_each(std::size_t n, _F f) {
+  std::size_t i = 0;
+  if constexpr (_Vec::lanes > 1)
+    for (; i + _Vec::lanes <= n; i += _Vec::lanes)
+      f(_Vec(), i);
+  for (; i != n; ++i)
+    f(xform_one<_K>(), i);
+}
+
+/// Return a * x + b * y + c, lane-wise
+template <class _B, class _R>
+inline _R xform_row(_B B, const _R &a, const _R &b, const _R &c, const _R &x,
+                    const _R &y) {
+  return B.add(B.add(B.mul(a, x), B.mul(b, y)), c);
+}
+
+/// Return a * x + b * y + c * z, lane-wise
+template <class _B, class _R>
+inline _R xform_row(_B B, const _R &a, const _R &b, const _R &c, const _R &x,
+                    const _R &y, const _R &z) {
+  return B.add(B.add(B.mul(a, x), B.mul(b, y)), B.mul(c, z));
 }
 
+} // namespace detail
+
+/**
+ *  Array of affine points, stored as a structure of arrays: the
+ *  coordinates x and y are two separate aligned arrays, so that
+ *  transform() below maps several points per SIMD instruction. The
+ *  elements are read as values of point2d<K>.
+ *
+ *  @param  K  Type of coordinates
+ */
+template <typename _K> class point2d_array {
+public:
+  /// Element typedef (read by value).
+  typedef point2d<_K> value_type;
+
+  /// Coordinate typedef.
+  typedef _K coord_type;
+
+  /// Default constructor (empty).
+  point2d_array() = default;
+
+  /// Construct @a n copies of @a p.
+  explicit point2d_array(std::size_t n, const value_type &p = value_type())
+      : _c{aligned_vector<_K>(n, p.x()), aligned_vector<_K>(n, p.y())} {}
+
+  /// Construct from the elements of [@a first, @a last).
+  template <class _InputIterator>
+  point2d_array(_InputIterator first, _InputIterator last) {
+    for (; first != last; ++first)
+      push_back(*first);
+  }
+
+  /// Return the number of elements.
+  std::size_t size() const noexcept { return _c[0].size(); }
+
+  /// Return true if there is no element.
+  bool empty() const noexcept { return _c[0].empty(); }
+
+  /// Reserve the storage of @a n elements.
+  void reserve(std::size_t n) {
+    for (auto &c : _c)
+      c.reserve(n);
+  }
+
+  /// Resize to @a n elements; the new ones are unspecified.
+  void resize(std::size_t n) {
+    for (auto &c : _c)
+      c.resize(n);
+  }
+
+  /// Remove all elements.
+  void clear() noexcept {
+    for (auto &c : _c)
+      c.clear();
+  }
+
+  /// Return the element @a i.
+  value_type operator[](std::size_t i) const {
+    return value_type(_c[0][i], _c[1][i]);
+  }
+
+  /// Set the element @a i to @a p.
+  void set(std::size_t i, const value_type &p) {
+    _c[0][i] = p.x();
+    _c[1][i] = p.y();
+  }
+
+  /// Append @a p.
+  void push_back(const value_type &p) {
+    _c[0].push_back(p.x());
+    _c[1].push_back(p.y());
+  }
+
+  /// Return the coordinates @a k of all elements.
+  const _K *data(std::size_t k) const noexcept { return _c[k].data(); }
+
+  /// Return the coordinates @a k of all elements.
+  _K *data(std::size_t k) noexcept { return _c[k].data(); }
+
+  /// Return true if @a a is equal to @a b (coordinate-wise).
+  friend bool operator==(const point2d_array &a, const point2d_array &b) {
+    return a._c[0] == b._c[0] && a._c[1] == b._c[1];
+  }
+
+  /// Return false if @a a is equal to @a b.
+  friend bool operator!=(const point2d_array &a, const point2d_array &b) {
+    return !(a == b);
+  }
+
+private:
+  aligned_vector<_K> _c[2];
+};
+
+///  Return the homography mapping @a A, @a B, @a C and @a D to @a A1,
+///  @a B1, @a C1 and @a D1, no three of either collinear (otherwise the
+///  matrix is singular). Solved with adjoints only, so that it is exact
+///  for integer and rational @a _Tp; the result is defined up to scale.
+template <typename _Tp>
+constexpr matrix3d<_Tp>
+persp_xform(const point2d<_Tp> &A, const point2d<_Tp> &B,
+            const point2d<_Tp> &C, const point2d<_Tp> &D,
+            const point2d<_Tp> &A1, const point2d<_Tp> &B1,
+            const point2d<_Tp> &C1, const point2d<_Tp> &D1) {
+  return detail::persp_basis(A1, B1, C1, D1) *
+         detail::persp_basis(A, B, C, D).adj();
+}
+
+///  Create correcting perspective matrix: the homography mapping the
+///  quadrilateral @a A, @a B, @a C, @a D onto the unit square (0, 0),
+///  (1, 0), (1, 1), (0, 1), in that order (see persp_xform).
+template <typename _Tp>
+constexpr matrix3d<_Tp> correct_persp(const point2d<_Tp> &A,
+                                      const point2d<_Tp> &B,
+                                      const point2d<_Tp> &C,
+                                      const point2d<_Tp> &D) {
+  return persp_xform(A, B, C, D, point2d<_Tp>(_Tp(0), _Tp(0)),
+                     point2d<_Tp>(_Tp(1), _Tp(0)),
+                     point2d<_Tp>(_Tp(1), _Tp(1)),
+                     point2d<_Tp>(_Tp(0), _Tp(1)));
+}
+
+//@{
+///  Return the transform applying @a H1, then @a H2, ... in turn. A chain
+///  is multiplied out once, so that applying it costs one transform.
+template <typename _Tp>
+constexpr matrix3d<_Tp> compose(const matrix3d<_Tp> &H1) noexcept {
+  return H1;
+}
+
+template <typename _Tp, class... _Ts>
+constexpr matrix3d<_Tp> compose(const matrix3d<_Tp> &H1,
+                                const matrix3d<_Tp> &H2,
+                                const _Ts &... Hs) noexcept {
+  return compose(matrix3d<_Tp>(H2 * H1), Hs...);
+}
+//@}
+
+///  Return the image of the affine point @a p under @a H. A point mapped
+///  to infinity divides by zero.
+template <typename _Tp>
+constexpr point2d<_Tp> transform(const matrix3d<_Tp> &H,
+                                 const point2d<_Tp> &p) {
+  const _Tp r =
+      _Tp(1) / (H(2, 0) * p.x() + H(2, 1) * p.y() + H(2, 2));
+  return point2d<_Tp>((H(0, 0) * p.x() + H(0, 1) * p.y() + H(0, 2)) * r,
+                      (H(1, 0) * p.x() + H(1, 1) * p.y() + H(1, 2)) * r);
+}
+
+///  r[i] = H p[i]: the affine images of @a p under @a H, with the
+///  division by w fused in (one reciprocal and two products per point).
+///  SIMD for float and double; @a r may be @a p.
+template <typename _K>
+inline void transform(const matrix3d<_K> &H, const point2d_array<_K> &p,
+                      point2d_array<_K> &r) {
+  const std::size_t n = p.size();
+  r.resize(n);
+  const _K *x = p.data(0), *y = p.data(1);
+  _K *u = r.data(0), *v = r.data(1);
+  detail::xform_for_each<detail::xform_simd<_K>, _K>(
+      n, [&](auto B, std::size_t i) {
+        const auto X = B.load(x + i), Y = B.load(y + i);
+        const auto R = B.div(
+            B.set1(_K(1)), detail::xform_row(B, B.set1(H(2, 0)),
+                                             B.set1(H(2, 1)), B.set1(H(2, 2)),
+                                             X, Y));
+        B.store(u + i, B.mul(detail::xform_row(B, B.set1(H(0, 0)),
+                                               B.set1(H(0, 1)),
+                                               B.set1(H(0, 2)), X, Y),
+                             R));
+        B.store(v + i, B.mul(detail::xform_row(B, B.set1(H(1, 0)),
+                                               B.set1(H(1, 1)),
+                                               B.set1(H(1, 2)), X, Y),
+                             R));
+      });
+}
+
+///  Return the affine images of @a p under @a H (see above).
+template <typename _K>
+inline point2d_array<_K> transform(const matrix3d<_K> &H,
+                                   const point2d_array<_K> &p) {
+  point2d_array<_K> r;
+  transform(H, p, r);
+  return r;
+}
+
+///  r[i] = H p[i] for the points @a p of the projective plane (no
+///  division). SIMD for float, double, int32 and int64; @a r may be @a p.
+template <typename _K>
+inline void transform(const matrix3d<_K> &H, const point3_array<_K> &p,
+                      point3_array<_K> &r) {
+  static_assert(std::is_same<typename point3_array<_K>::word, _K>::value,
+                "coordinates must be stored as values of K");
+  const std::size_t n = p.size();
+  r.resize(n);
+  const auto a = p.coords();
+  const auto c = r.coords();
+  detail::xform_for_each<detail::xform_ring_simd<_K>, _K>(
+      n, [&](auto B, std::size_t i) {
+        const auto X = B.load(a[0] + i), Y = B.load(a[1] + i),
+                   Z = B.load(a[2] + i);
+        for (std::size_t k = 0; k != 3; ++k)
+          B.store(c[k] + i,
+                  detail::xform_row(B, B.set1(H(k, 0)), B.set1(H(k, 1)),
+                                    B.set1(H(k, 2)), X, Y, Z));
+      });
+}
+
+///  r[i] = H p[i], dehomogenized: the affine images of the points @a p of
+///  the projective plane, with the division by w fused in.
+template <typename _K>
+inline void transform(const matrix3d<_K> &H, const point3_array<_K> &p,
+                      point2d_array<_K> &r) {
+  static_assert(std::is_same<typename point3_array<_K>::word, _K>::value,
+                "coordinates must be stored as values of K");
+  const std::size_t n = p.size();
+  r.resize(n);
+  const auto a = p.coords();
+  _K *u = r.data(0), *v = r.data(1);
+  detail::xform_for_each<detail::xform_simd<_K>, _K>(
+      n, [&](auto B, std::size_t i) {
+        const auto X = B.load(a[0] + i), Y = B.load(a[1] + i),
+                   Z = B.load(a[2] + i);
+        auto row = [&](std::size_t k) {
+          return detail::xform_row(B, B.set1(H(k, 0)), B.set1(H(k, 1)),
+                                   B.set1(H(k, 2)), X, Y, Z);
+        };
+        const auto R = B.div(B.set1(_K(1)), row(2));
+        B.store(u + i, B.mul(row(0), R));
+        B.store(v + i, B.mul(row(1), R));
+      });
+}
+
+/** @} */
+} // namespace fun
+
 #endif
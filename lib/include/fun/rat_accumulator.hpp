@@ -0,0 +1,206 @@
+// The template and inlines for the -*- C++ -*- rational accumulator.
+// Initially implemented by Wai-Shing Luk <luk036@gmail.com>
+//
+
+/** @file include/rat_accumulator.hpp
+ *  This is a C++ Library header.
+ */
+
+#ifndef FUN_RAT_ACCUMULATOR_HPP
+#define FUN_RAT_ACCUMULATOR_HPP 1
+
+#include <algorithm> // for std::sort
+#include <cstddef>   // for std::size_t
+#include <iterator>  // for std::distance
+#include <thread>    // for std::thread
+#include <utility>   // for std::pair
+#include <vector>    // for std::vector
+
+#include "basic_rational.hpp" // for fun::basic_rational
+
+namespace fun {
+/**
+ * @addtogroup rational
+ * @{
+ */
+
+/**
+ *  Exact sum of many rational numbers.
+ *
+ *  Adding N terms one by one with operator+= lets the denominators grow
+ *  with every step. The accumulator instead buffers a block of terms,
+ *  sorts it by denominator and sums the numerators of equal denominators
+ *  directly (no gcd), then adds the group sums in a balanced tree. The
+ *  block sums are combined by a binary counter, so that the whole sum is
+ *  again a balanced tree while the memory stays O(block + log N).
+ *
+ *  @param  _Z       Type of rational number elements
+ *  @param  _Policy  Normalization policy (lazy_normalize<>, as boost::rat)
+ */
+template <typename _Z, class _Policy = lazy_normalize<>>
+class rat_accumulator {
+public:
+  /// Value typedef.
+  typedef basic_rational<_Z, _Policy> value_type;
+
+  /// Construct an empty accumulator buffering @a block terms.
+  explicit rat_accumulator(std::size_t block = 1024)
+      : _block(block < 2 ? 2 : block), _count(0) {
+    _terms.reserve(_block);
+  }
+
+  /// Add the term @a r.
+  rat_accumulator &operator+=(const value_type &r) {
+    _terms.push_back(r);
+    ++_count;
+    if (_terms.size() >= _block)
+      flush();
+    return *this;
+  }
+
+  /// Subtract the term @a r.
+  rat_accumulator &operator-=(const value_type &r) { return *this += -r; }
+
+  /// Add the terms [first, last).
+  template <class _InputIt> rat_accumulator &add(_InputIt first, _InputIt last) {
+    for (; first != last; ++first)
+      *this += value_type(*first);
+    return *this;
+  }
+
+  /// Add the terms collected by @a other (which may be this accumulator).
+  rat_accumulator &merge(const rat_accumulator &other) {
+    if (&other == this) // push() would grow the vectors being read
+      return merge(rat_accumulator(other));
+    for (const auto &p : other._partial)
+      push(p.first, p.second);
+    for (const auto &t : other._terms)
+      _terms.push_back(t);
+    _count += other._count;
+    if (_terms.size() >= _block)
+      flush();
+    return *this;
+  }
+
+  /// Return the number of terms added.
+  std::size_t size() const { return _count; }
+
+  /// Remove all terms.
+  void clear() {
+    _terms.clear();
+    _partial.clear();
+    _count = 0;
+  }
+
+  /// Return the sum of all terms (in lowest terms).
+  value_type sum() const {
+    value_type s(0);
+    if (!_terms.empty()) {
+      std::vector<value_type> t(_terms);
+      s = reduce_block(t);
+    }
+    // The smallest partial sums are on the top of the stack
+    for (auto it = _partial.rbegin(); it != _partial.rend(); ++it)
+      s = it->first + s;
+    if (!_Policy::canonical)
+      s.normalize();
+    return s;
+  }
+
+  /**
+   *  Return the sum of [first, last) computed by @a threads threads (0:
+   *  one per hardware thread), each one summing a contiguous slice.
+   */
+  template <class _RandomIt>
+  static value_type parallel_sum(_RandomIt first, _RandomIt last,
+                                 unsigned threads = 0,
+                                 std::size_t block = 1024) {
+    if (threads == 0)
+      threads = std::thread::hardware_concurrency();
+    const std::size_t n = std::size_t(std::distance(first, last));
+    if (threads > n / block)
+      threads = unsigned(n / block);
+    if (threads <= 1) {
+      rat_accumulator acc(block);
+      acc.add(first, last);
+      return acc.sum();
+    }
+    std::vector<value_type> part(threads);
+    std::vector<std::thread> pool;
+    pool.reserve(threads);
+    for (unsigned k = 0; k != threads; ++k) {
+      const _RandomIt lo = first + std::ptrdiff_t(n * k / threads);
+      const _RandomIt hi = first + std::ptrdiff_t(n * (k + 1) / threads);
+      pool.emplace_back([lo, hi, block, &part, k]() {
+        rat_accumulator acc(block);
+        acc.add(lo, hi);
+        part[k] = acc.sum();
+      });
+    }
+    for (auto &t : pool)
+      t.join();
+    value_type s = tree_reduce(part);
+    if (!_Policy::canonical)
+      s.normalize();
+    return s;
+  }
+
+private:
+  /// Reduce the buffered terms to one partial sum.
+  void flush() {
+    if (_terms.empty())
+      return;
+    push(reduce_block(_terms), 0);
+    _terms.clear();
+  }
+
+  /// Push the partial sum @a x of level @a level (binary counter).
+  void push(value_type x, int level) {
+    while (!_partial.empty() && _partial.back().second == level) {
+      x = _partial.back().first + x;
+      _partial.pop_back();
+      ++level;
+    }
+    _partial.emplace_back(std::move(x), level);
+  }
+
+  /// Sum @a t by grouping equal denominators first (reorders @a t).
+  static value_type reduce_block(std::vector<value_type> &t) {
+    std::sort(t.begin(), t.end(), [](const value_type &a, const value_type &b) {
+      return a.denom() < b.denom();
+    });
+    std::size_t m = 0;
+    for (std::size_t i = 0; i != t.size();) {
+      const _Z den = t[i].denom();
+      _Z num = t[i].num();
+      for (++i; i != t.size() && t[i].denom() == den; ++i)
+        num += t[i].num();
+      t[m++] = value_type(num, den);
+    }
+    t.resize(m);
+    return tree_reduce(t);
+  }
+
+  /// Sum @a v pairwise, level by level (destroys @a v).
+  static value_type tree_reduce(std::vector<value_type> &v) {
+    if (v.empty())
+      return value_type(0);
+    for (std::size_t n = v.size(); n > 1; n = (n + 1) / 2) {
+      for (std::size_t i = 0; i + 1 < n; i += 2)
+        v[i / 2] = v[i] + v[i + 1];
+      if (n % 2 != 0)
+        v[n / 2] = v[n - 1];
+    }
+    return v[0];
+  }
+
+  std::size_t _block;
+  std::size_t _count;
+  std::vector<value_type> _terms;
+  std::vector<std::pair<value_type, int>> _partial;
+};
+
+/** @} */
+} // namespace fun
+
+#endif
@@ -0,0 +1,329 @@
+// The template and inlines for the -*- C++ -*- rational approximations.
+// Initially implemented by Wai-Shing Luk <luk036@gmail.com>
+//
+
+/** @file include/rational_approx.hpp
+ *  This is a C++ Library header.
+ */
+
+#ifndef FUN_RATIONAL_APPROX_HPP
+#define FUN_RATIONAL_APPROX_HPP 1
+
+#include <cassert>     // for assert
+#include <cmath>       // for std::frexp, std::ldexp, std::isnan
+#include <cstdint>     // for std::uint64_t
+#include <iterator>    // for std::iterator_traits
+#include <limits>      // for std::numeric_limits
+#include <type_traits> // for std::conditional
+#include <utility>     // for std::pair
+
+#include "basic_rational.hpp" // for fun::basic_rational
+#include "gcd.hpp"            // for fun::uint128_t, detail::make_unsigned
+
+namespace fun {
+/**
+ * @addtogroup rational
+ * @{
+ *
+ * Best rational approximations. A double converted by scaling (x * 2^k / 2^k)
+ * keeps a power-of-two denominator of up to 2^1074; the functions below
+ * return instead the closest fraction whose denominator does not exceed a
+ * given bound, or the simplest fraction of an interval, so that the exact
+ * computations downstream start from small numbers.
+ */
+
+namespace detail {
+
+/// Unsigned working type of the approximation of basic_rational<_Z>
+template <typename _Z, bool = std::numeric_limits<_Z>::is_bounded>
+struct approx_word {
+  typedef typename make_unsigned<_Z>::type type;
+};
+
+template <typename _Z> struct approx_word<_Z, false> {
+  typedef _Z type; // e.g. bigint
+};
+
+/// Return |a| in the working type
+template <typename _W, typename _Z> inline _W approx_abs(const _Z &a) {
+  if constexpr (std::numeric_limits<_Z>::is_bounded)
+    return _W(uabs(a));
+  else
+    return a < _Z(0) ? _W(-a) : _W(a);
+}
+
+/**
+ *  Best approximation p/q of n/d (n >= 0, d > 0) with q <= N (and p <= P
+ *  if @a bounded), by the continued fraction expansion of n/d.
+ *
+ *  The last convergent p1/q1 is compared with the best semiconvergent
+ *  (p0 + k p1)/(q0 + k q1); with the complete quotient t = n/d of the
+ *  remainder, the semiconvergent is strictly closer to the value iff
+ *  t < 2k + q0/q1, i.e. iff 2k > a, or 2k == a and r q1 < d q0 (a, r:
+ *  quotient and remainder of n/d). Since the original denominator equals
+ *  q1 n + q0 d at every step, these products never overflow.
+ */
+template <typename _W>
+void best_approx_core(_W n, _W d, const _W &N, const _W &P, bool bounded,
+                      _W &p, _W &q) {
+  _W p0(0), q0(1), p1(1), q1(0);
+  while (d != _W(0)) {
+    const _W a = n / d;
+    const bool over_q = q1 != _W(0) && (N - q0) / q1 < a;
+    const bool over_p = bounded && p1 != _W(0) && (P - p0) / p1 < a;
+    if (over_q || over_p) {
+      _W k = a;
+      if (over_q)
+        k = (N - q0) / q1;
+      if (over_p && (P - p0) / p1 < k)
+        k = (P - p0) / p1;
+      if (q1 == _W(0)) { // integer part out of range: saturate
+        p = k;
+        q = _W(1);
+        return;
+      }
+      const _W r = n - a * d;
+      const _W k2 = k + k;
+      if (a < k2 || (k2 == a && r * q1 < d * q0)) {
+        p = p0 + k * p1;
+        q = q0 + k * q1;
+      } else {
+        p = p1;
+        q = q1;
+      }
+      return;
+    }
+    const _W p2 = p0 + a * p1;
+    const _W q2 = q0 + a * q1;
+    p0 = p1;
+    q0 = q1;
+    p1 = p2;
+    q1 = q2;
+    const _W r = n - a * d;
+    n = d;
+    d = r;
+  }
+  p = p1;
+  q = q1;
+}
+
+/// Largest t in [1, limit] with f(t) (f(1) holds, f is monotone)
+template <typename _Z, class _F>
+_Z gallop(_F f, const _Z &limit, bool bounded) {
+  _Z lo(1), step(1);
+  while (!bounded || lo < limit) {
+    const _Z hi = bounded && !(step < limit - lo) ? limit : lo + step;
+    if (!f(hi)) {
+      _Z h = hi;
+      while (_Z(1) < h - lo) {
+        const _Z mid = lo + (h - lo) / _Z(2);
+        if (f(mid))
+          lo = mid;
+        else
+          h = mid;
+      }
+      return lo;
+    }
+    lo = hi;
+    step += step;
+  }
+  return lo;
+}
+
+} // namespace detail
+
+/**
+ *  Return the fraction closest to @a x among those with denominators not
+ *  greater than @a max_den (ties go to the smaller denominator).
+ *
+ *  @param  max_den  Bound of the denominator (>= 1)
+ *  @return  In lowest terms; Inf, -Inf and NaN are returned as such
+ */
+template <typename _Z, class _P>
+basic_rational<_Z, _P> best_approximation(const basic_rational<_Z, _P> &x,
+                                          const _Z &max_den) {
+  typedef typename detail::approx_word<_Z>::type _W;
+  assert(_Z(0) < max_den);
+  if (x.denom() == _Z(0))
+    return x;
+  _W p, q;
+  detail::best_approx_core(detail::approx_abs<_W>(x.num()),
+                           detail::approx_abs<_W>(x.denom()), _W(max_den),
+                           _W(0), false, p, q);
+  const _Z n(p);
+  return basic_rational<_Z, _P>(x.num() < _Z(0) ? -n : n, _Z(q), unnormalized);
+}
+
+/**
+ *  Return the fraction closest to the double @a x among those with
+ *  denominators not greater than @a max_den (ties go to the smaller
+ *  denominator), computed exactly from the binary value of @a x.
+ *  If |x| does not fit in _Z, the result saturates to the largest
+ *  numerator.
+ *
+ *  @param  max_den  Bound of the denominator (>= 1)
+ *  @return  In lowest terms; NaN and infinities map to NaN and +-Inf
+ */
+template <typename _Z, class _P = lazy_normalize<>>
+basic_rational<_Z, _P> best_approximation(double x, const _Z &max_den) {
+  typedef basic_rational<_Z, _P> _R;
+  constexpr bool bounded = std::numeric_limits<_Z>::is_bounded;
+  static_assert(!bounded || sizeof(_Z) <= 8,
+                "best_approximation(double) requires a 64-bit or an "
+                "unbounded integer type");
+#ifdef FUN_HAS_INT128
+  // The power-of-two denominator of |x| >= 2^-67 fits in 128 bits
+  typedef typename std::conditional<bounded, uint128_t, _Z>::type _W;
+#else
+  static_assert(!bounded, "best_approximation(double) of a bounded integer "
+                          "type requires 128-bit integers");
+  typedef _Z _W;
+#endif
+  constexpr int max_shift = 120; // 2^-120 * 2^53 < 1 / (2 * 2^64)
+  assert(_Z(0) < max_den);
+  if (std::isnan(x))
+    return _R(_Z(0), _Z(0), unnormalized);
+  if (std::isinf(x))
+    return _R(_Z(x < 0 ? -1 : 1), _Z(0), unnormalized);
+
+  int e;
+  const double m = std::frexp(x < 0 ? -x : x, &e);
+  _W n(std::uint64_t(std::ldexp(m, 53))), d(1); // |x| = n * 2^(e - 53)
+  e -= 53;
+  const _W pmax = bounded ? _W(std::numeric_limits<_Z>::max()) : _W(0);
+  if (e >= 0) {
+    if (bounded && e + 53 > std::numeric_limits<_Z>::digits)
+      n = pmax;
+    else
+      n = n << e;
+  } else if (bounded && -e > max_shift) {
+    n = _W(0);
+  } else {
+    d = d << -e;
+  }
+  _W p, q;
+  detail::best_approx_core(n, d, _W(max_den), pmax, bounded, p, q);
+  const _Z a(p);
+  return _R(x < 0 ? -a : a, _Z(q), unnormalized);
+}
+
+/**
+ *  Batched best_approximation(): write the approximations of the values
+ *  [first, last) (doubles or rational numbers) to @a out.
+ *
+ *  @return  The end of the output range
+ */
+template <typename _Z, class _P = lazy_normalize<>, class _InputIt,
+          class _OutputIt>
+_OutputIt best_approximation(_InputIt first, _InputIt last, _OutputIt out,
+                             const _Z &max_den) {
+  for (; first != last; ++first, ++out) {
+    if constexpr (std::is_floating_point<
+                      typename std::iterator_traits<_InputIt>::value_type>::value)
+      *out = best_approximation<_Z, _P>(double(*first), max_den);
+    else
+      *out = best_approximation(*first, max_den);
+  }
+  return out;
+}
+
+/**
+ *  Return the simplest fraction (smallest denominator, then smallest
+ *  absolute numerator) in the closed interval [@a lo, @a hi], lo <= hi.
+ *
+ *  The interval is narrowed as in a continued fraction expansion: if it
+ *  contains an integer, the one nearest to zero is the answer; otherwise
+ *  lo and hi share their integer part n and the search continues with
+ *  [1 / (hi - n), 1 / (lo - n)].
+ */
+template <typename _Z, class _P>
+basic_rational<_Z, _P> simplest_rational(const basic_rational<_Z, _P> &lo,
+                                         const basic_rational<_Z, _P> &hi) {
+  typedef basic_rational<_Z, _P> _R;
+  if (is_NaN(lo) || is_NaN(hi))
+    return _R(_Z(0), _Z(0), unnormalized);
+  assert(!(hi < lo));
+  if (!(_R(0) < lo) && !(hi < _R(0)))
+    return _R(0);
+  if (hi < _R(0))
+    return -simplest_rational(-hi, -lo);
+  if (lo.denom() == _Z(0)) // [Inf, Inf]
+    return lo;
+
+  // value = (p1 y + p0) / (q1 y + q0), y the simplest of [a/b, c/d]
+  _Z a(lo.num()), b(lo.denom()), c(hi.num()), d(hi.denom());
+  _Z p0(0), q0(1), p1(1), q1(0);
+  while (true) {
+    const _Z n = a / b;
+    const _Z k = n * b == a ? n : n + _Z(1); // ceil(a/b)
+    if (d == _Z(0) || !(c / d < k)) {
+      return _R(p1 * k + p0, q1 * k + q0, unnormalized);
+    }
+    const _Z p2 = p1 * n + p0, q2 = q1 * n + q0;
+    p0 = p1;
+    q0 = q1;
+    p1 = p2;
+    q1 = q2;
+    const _Z a2 = d, b2 = c - n * d, c2 = b, d2 = a - n * b;
+    a = a2;
+    b = b2;
+    c = c2;
+    d = d2;
+  }
+}
+
+/**
+ *  Stern-Brocot (mediant) search for a real number x >= 0 that is only
+ *  known through the predicate @a le(p, q) == (p/q <= x), e.g.
+ *  p * p <= 2 * q * q for sqrt(2).
+ *
+ *  The mediant of the current bounds replaces the bound on its side of x;
+ *  a run of moves in the same direction is found by galloping, so that
+ *  the predicate is called O(log(max_den)^2) times instead of O(max_den).
+ *
+ *  @return  The neighbours lo <= x < hi in the Farey sequence of order
+ *           @a max_den (hi may be Inf if x is out of range of _Z)
+ */
+template <typename _Z, class _Pred>
+std::pair<basic_rational<_Z, lazy_normalize<>>,
+          basic_rational<_Z, lazy_normalize<>>>
+stern_brocot_search(_Pred le, const _Z &max_den) {
+  typedef basic_rational<_Z, lazy_normalize<>> _R;
+  constexpr bool bounded = std::numeric_limits<_Z>::is_bounded;
+  const _Z pmax = bounded ? std::numeric_limits<_Z>::max() : _Z(0);
+  assert(_Z(0) < max_den && le(_Z(0), _Z(1)));
+  _Z lp(0), lq(1), hp(1), hq(0);
+  while (!(max_den - lq < hq) && (!bounded || !(pmax - lp < hp))) {
+    // The largest run length within the bounds
+    _Z limit(0);
+    bool limited = true;
+    if (le(lp + hp, lq + hq)) {
+      if (hq != _Z(0))
+        limit = (max_den - lq) / hq;
+      else
+        limited = bounded;
+      if (bounded && (pmax - lp) / hp < limit)
+        limit = (pmax - lp) / hp;
+      const _Z t = detail::gallop(
+          [&](const _Z &t) { return le(lp + t * hp, lq + t * hq); }, limit,
+          limited);
+      lp += t * hp;
+      lq += t * hq;
+    } else {
+      limit = (max_den - hq) / lq;
+      if (bounded && lp != _Z(0) && (pmax - hp) / lp < limit)
+        limit = (pmax - hp) / lp;
+      const _Z t = detail::gallop(
+          [&](const _Z &t) { return !le(hp + t * lp, hq + t * lq); }, limit,
+          true);
+      hp += t * lp;
+      hq += t * lq;
+    }
+  }
+  return {_R(lp, lq, unnormalized), _R(hp, hq, unnormalized)};
+}
+
+/** @} */
+} // namespace fun
+
+#endif
@@ -0,0 +1,126 @@
+// The template and inlines for the -*- C++ -*- rational comparison kernel.
+// Initially implemented by Wai-Shing Luk <luk036@gmail.com>
+//
+
+/** @file include/rational_compare.hpp
+ *  This is a C++ Library header.
+ */
+
+#ifndef FUN_RATIONAL_COMPARE_HPP
+#define FUN_RATIONAL_COMPARE_HPP 1
+
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#include "gcd.hpp" // for fun::int128_t, detail::uabs
+
+namespace fun {
+/**
+ * @addtogroup rational
+ * @{
+ */
+
+namespace detail {
+
+template <typename _Z> inline constexpr int sign(const _Z &a) {
+  return a < _Z(0) ? -1 : (_Z(0) < a ? 1 : 0);
+}
+
+template <typename _Z> inline constexpr int compare(const _Z &a, const _Z &b) {
+  return a < b ? -1 : (b < a ? 1 : 0);
+}
+
+/**
+ *  Compare p/q with r/s for non-negative p, r and positive q, s by
+ *  their continued fraction expansions. Only divisions and remainders
+ *  are used, so nothing can overflow.
+ */
+template <typename _U>
+inline int compare_cf(_U p, _U q, _U r, _U s) noexcept {
+  int sgn = 1;
+  while (true) {
+    const _U a = p / q, b = r / s;
+    if (a != b)
+      return a < b ? -sgn : sgn;
+    p -= a * q;
+    r -= b * s;
+    if (p == _U(0))
+      return r == _U(0) ? 0 : -sgn;
+    if (r == _U(0))
+      return sgn;
+    // p/q < r/s  <=>  q/p > s/r
+    _U t = p;
+    p = q;
+    q = t;
+    t = r;
+    r = s;
+    s = t;
+    sgn = -sgn;
+  }
+}
+
+} // namespace detail
+
+/**
+ *  Return the sign of a/b - c/d (b, d >= 0) without overflow.
+ *
+ *  1. cross-multiplication when all magnitudes fit in half a word,
+ *  2. cross-multiplication in the double-width type (64 or 128 bits),
+ *  3. continued fraction comparison otherwise.
+ *
+ *  Unbounded integer types are simply cross-multiplied. Infinities
+ *  (n/0) compare by sign; NaN (0/0) compares equal to everything.
+ */
+template <typename _Z>
+inline int compare_fractions(const _Z &a, const _Z &b, const _Z &c,
+                             const _Z &d) {
+  typedef std::numeric_limits<_Z> _L;
+  if (b == d)
+    return b == _Z(0) ? detail::compare(detail::sign(a), detail::sign(c))
+                      : detail::compare(a, c);
+  if (b == _Z(0))
+    return detail::sign(a);
+  if (d == _Z(0))
+    return -detail::sign(c);
+
+  if constexpr (!_L::is_bounded) {
+    return detail::compare(_Z(a * d), _Z(c * b));
+  } else {
+    typedef typename detail::make_unsigned<_Z>::type _U;
+    const _U ua = detail::uabs(a), ub = _U(b), uc = detail::uabs(c),
+             ud = _U(d);
+
+    // Step 1: the products fit in _Z
+    if (((ua | ub | uc | ud) >> (_L::digits / 2)) == _U(0))
+      return detail::compare(_Z(a * d), _Z(c * b));
+
+    // Step 2: the products fit in the double-width type
+    if constexpr (sizeof(_Z) <= 4) {
+      typedef typename std::conditional<_L::is_signed, std::int64_t,
+                                        std::uint64_t>::type _W;
+      return detail::compare(_W(_W(a) * _W(d)), _W(_W(c) * _W(b)));
+    }
+#ifdef FUN_HAS_INT128
+    else if constexpr (sizeof(_Z) <= 8) {
+      typedef typename std::conditional<_L::is_signed, int128_t,
+                                        uint128_t>::type _W;
+      return detail::compare(_W(_W(a) * _W(d)), _W(_W(c) * _W(b)));
+    }
+#endif
+
+    // Step 3: continued fractions on the magnitudes
+    const int sa = detail::sign(a), sc = detail::sign(c);
+    if (sa != sc)
+      return sa < sc ? -1 : 1;
+    if (sa == 0)
+      return 0;
+    return sa > 0 ? detail::compare_cf(ua, ub, uc, ud)
+                  : detail::compare_cf(uc, ud, ua, ub);
+  }
+}
+
+/** @} */
+} // namespace fun
+
+#endif
@@ -0,0 +1,311 @@
+// The template and inlines for the -*- C++ -*- rational number text I/O.
+// Initially implemented by Wai-Shing Luk <luk036@gmail.com>
+//
+
+/** @file include/rational_io.hpp
+ *  This is a C++ Library header.
+ */
+
+#ifndef FUN_RATIONAL_IO_HPP
+#define FUN_RATIONAL_IO_HPP 1
+
+#include <charconv>     // for std::to_chars, std::from_chars
+#include <cstdio>       // for std::FILE, std::fwrite, std::fread
+#include <cstring>      // for std::memcpy
+#include <string>       // for std::string
+#include <system_error> // for std::errc
+#include <type_traits>  // for std::is_integral
+#include <vector>       // for std::vector
+
+#include "basic_rational.hpp" // for fun::basic_rational
+#include "gcd.hpp"            // for fun::int128_t, detail::uabs
+
+namespace fun {
+/**
+ * @addtogroup rational
+ * @{
+ *
+ * Text conversion without iostreams. The format is the one of
+ * operator<<: "n", "(n/d)", "Inf", "-Inf" and "NaN" for fun::rational,
+ * "n/d" for boost::rat (see basic_rational); the readers accept both,
+ * and "+Inf".
+ */
+
+namespace detail {
+
+/// Copy @a n characters of @a s to [first, last)
+inline std::to_chars_result copy_chars(char *first, char *last,
+                                       const char *s, std::size_t n) {
+  if (std::size_t(last - first) < n)
+    return {last, std::errc::value_too_large};
+  std::memcpy(first, s, n);
+  return {first + n, std::errc()};
+}
+
+/// Write the integer @a x in decimal
+template <typename _Z>
+inline std::to_chars_result int_to_chars(char *first, char *last,
+                                         const _Z &x) {
+  if constexpr (std::is_integral<_Z>::value) {
+    return std::to_chars(first, last, x);
+  }
+#ifdef FUN_HAS_INT128
+  else if constexpr (std::is_same<_Z, int128_t>::value ||
+                     std::is_same<_Z, uint128_t>::value) {
+    char buf[48];
+    char *p = buf + sizeof(buf);
+    uint128_t u = uabs(x);
+    do {
+      *--p = char('0' + int(u % 10));
+      u /= 10;
+    } while (u != 0);
+    if (x < _Z(0))
+      *--p = '-';
+    return copy_chars(first, last, p, std::size_t(buf + sizeof(buf) - p));
+  }
+#endif
+  else { // e.g. bigint
+    const std::string s = x.to_string();
+    return copy_chars(first, last, s.data(), s.size());
+  }
+}
+
+/// Read a decimal integer (with an optional '-') into @a x
+template <typename _Z>
+inline std::from_chars_result int_from_chars(const char *first,
+                                             const char *last, _Z &x) {
+  if constexpr (std::is_integral<_Z>::value) {
+    return std::from_chars(first, last, x);
+  } else {
+    const char *p = first;
+    const bool neg = p != last && *p == '-';
+    if (neg)
+      ++p;
+    const char *digits = p;
+    for (; p != last && *p >= '0' && *p <= '9'; ++p)
+      ;
+    if (p == digits)
+      return {first, std::errc::invalid_argument};
+#ifdef FUN_HAS_INT128
+    if constexpr (std::is_same<_Z, int128_t>::value ||
+                  std::is_same<_Z, uint128_t>::value) {
+      if (neg && std::is_same<_Z, uint128_t>::value)
+        return {first, std::errc::invalid_argument};
+      const uint128_t limit =
+          std::is_same<_Z, int128_t>::value
+              ? (uint128_t(1) << 127) - (neg ? 0 : 1)
+              : ~uint128_t(0);
+      uint128_t u = 0;
+      for (const char *q = digits; q != p; ++q) {
+        const unsigned dgt = unsigned(*q - '0');
+        if (u > (limit - dgt) / 10)
+          return {p, std::errc::result_out_of_range};
+        u = u * 10 + dgt;
+      }
+      x = neg ? _Z(uint128_t(0) - u) : _Z(u);
+      return {p, std::errc()};
+    } else
+#endif
+    {
+      x = _Z(std::string(first, p).c_str());
+      return {p, std::errc()};
+    }
+  }
+}
+
+} // namespace detail
+
+/**
+ *  Write @a r (in lowest terms) to [first, last), like operator<<.
+ *
+ *  @return  {end of the output, errc()} or {last, value_too_large}
+ */
+template <typename _Z, class _P>
+std::to_chars_result to_chars(char *first, char *last,
+                              const basic_rational<_Z, _P> &r) {
+  basic_rational<_Z, _P> c(r);
+  if (!_P::canonical)
+    c.normalize();
+  const _Z &a = c.num(), &b = c.denom();
+  if constexpr (!_P::parenthesized) {
+    auto res = detail::int_to_chars(first, last, a);
+    if (res.ec != std::errc() || res.ptr == last)
+      return {last, std::errc::value_too_large};
+    *res.ptr = '/';
+    return detail::int_to_chars(res.ptr + 1, last, b);
+  }
+  if (b == _Z(1))
+    return detail::int_to_chars(first, last, a);
+  if (b == _Z(0)) {
+    if (a < _Z(0))
+      return detail::copy_chars(first, last, "-Inf", 4);
+    if (_Z(0) < a)
+      return detail::copy_chars(first, last, "Inf", 3);
+    return detail::copy_chars(first, last, "NaN", 3);
+  }
+  if (last - first < 5)
+    return {last, std::errc::value_too_large};
+  *first = '(';
+  auto res = detail::int_to_chars(first + 1, last, a);
+  if (res.ec != std::errc() || res.ptr == last)
+    return {last, std::errc::value_too_large};
+  *res.ptr = '/';
+  res = detail::int_to_chars(res.ptr + 1, last, b);
+  if (res.ec != std::errc() || res.ptr == last)
+    return {last, std::errc::value_too_large};
+  *res.ptr = ')';
+  return {res.ptr + 1, std::errc()};
+}
+
+/**
+ *  Read a rational number from [first, last): "n", "n/d", "(n/d)",
+ *  "Inf", "+Inf", "-Inf" or "NaN". Leading whitespace is not skipped.
+ *  On failure @a r is left unchanged, as with std::from_chars.
+ */
+template <typename _Z, class _P>
+std::from_chars_result from_chars(const char *first, const char *last,
+                                  basic_rational<_Z, _P> &r) {
+  typedef basic_rational<_Z, _P> _R;
+  auto match = [&](const char *s, std::size_t n) {
+    return std::size_t(last - first) >= n &&
+           std::memcmp(first, s, n) == 0;
+  };
+  if (match("NaN", 3)) {
+    r = _R(_Z(0), _Z(0), unnormalized);
+    return {first + 3, std::errc()};
+  }
+  if (match("Inf", 3) || match("+Inf", 4)) {
+    r = _R(_Z(1), _Z(0), unnormalized);
+    return {first + (*first == '+' ? 4 : 3), std::errc()};
+  }
+  if (match("-Inf", 4)) {
+    r = _R(_Z(-1), _Z(0), unnormalized);
+    return {first + 4, std::errc()};
+  }
+  const bool paren = first != last && *first == '(';
+  const char *p = first + (paren ? 1 : 0);
+  _Z n(0), d(1);
+  auto res = detail::int_from_chars(p, last, n);
+  if (res.ec != std::errc())
+    return {first, res.ec};
+  p = res.ptr;
+  if (p != last && *p == '/') {
+    res = detail::int_from_chars(p + 1, last, d);
+    if (res.ec != std::errc())
+      return {first, res.ec};
+    p = res.ptr;
+  } else if (paren) {
+    return {first, std::errc::invalid_argument};
+  }
+  if (paren) {
+    if (p == last || *p != ')')
+      return {first, std::errc::invalid_argument};
+    ++p;
+  }
+  r = _R(n, d);
+  return {p, std::errc()};
+}
+
+/**
+ *  Append the values [first, last) to @a out, each followed by @a sep.
+ */
+template <typename _Z, class _P>
+void write_column(std::string &out, const basic_rational<_Z, _P> *first,
+                  const basic_rational<_Z, _P> *last, char sep = '\n') {
+  std::size_t len = out.size();
+  for (; first != last; ++first) {
+    for (std::size_t room = 64;; room *= 2) {
+      out.resize(len + room);
+      char *buf = &out[0];
+      const auto res = to_chars(buf + len, buf + len + room - 1, *first);
+      if (res.ec == std::errc()) {
+        *res.ptr = sep;
+        len = std::size_t(res.ptr + 1 - buf);
+        break;
+      }
+    }
+  }
+  out.resize(len);
+}
+
+/**
+ *  Write the values [first, last) to @a f, each followed by @a sep,
+ *  through a fixed buffer and std::fwrite().
+ *
+ *  @return  true on success
+ */
+template <typename _Z, class _P>
+bool write_column(std::FILE *f, const basic_rational<_Z, _P> *first,
+                  const basic_rational<_Z, _P> *last, char sep = '\n') {
+  char buf[1 << 16];
+  char *p = buf;
+  char *const end = buf + sizeof(buf) - 1; // room for the separator
+  for (; first != last; ++first) {
+    auto res = to_chars(p, end, *first);
+    if (res.ec != std::errc()) {
+      if (std::fwrite(buf, 1, std::size_t(p - buf), f) != std::size_t(p - buf))
+        return false;
+      p = buf;
+      res = to_chars(p, end, *first);
+      if (res.ec != std::errc()) { // longer than the whole buffer
+        std::string s;
+        write_column(s, first, first + 1, sep);
+        if (std::fwrite(s.data(), 1, s.size(), f) != s.size())
+          return false;
+        continue;
+      }
+    }
+    *res.ptr = sep;
+    p = res.ptr + 1;
+  }
+  return std::fwrite(buf, 1, std::size_t(p - buf), f) == std::size_t(p - buf);
+}
+
+/**
+ *  Parse the values in [first, last), separated by whitespace or commas,
+ *  and append them to @a out.
+ *
+ *  @return  {last, errc()}, or the position and the error of the first
+ *           value that could not be read
+ */
+template <typename _Z, class _P>
+std::from_chars_result read_column(const char *first, const char *last,
+                                   std::vector<basic_rational<_Z, _P>> &out) {
+  auto is_sep = [](char c) {
+    return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == ',';
+  };
+  basic_rational<_Z, _P> r;
+  while (true) {
+    while (first != last && is_sep(*first))
+      ++first;
+    if (first == last)
+      return {last, std::errc()};
+    const auto res = from_chars(first, last, r);
+    if (res.ec != std::errc())
+      return res;
+    if (res.ptr != last && !is_sep(*res.ptr))
+      return {res.ptr, std::errc::invalid_argument};
+    out.push_back(r);
+    first = res.ptr;
+  }
+}
+
+/**
+ *  Read all the values of @a f (see the overload above) into @a out.
+ *
+ *  @return  true if the whole input was read
+ */
+template <typename _Z, class _P>
+bool read_column(std::FILE *f, std::vector<basic_rational<_Z, _P>> &out) {
+  std::string text;
+  char buf[1 << 16];
+  for (std::size_t n; (n = std::fread(buf, 1, sizeof(buf), f)) != 0;)
+    text.append(buf, n);
+  const char *first = text.data();
+  return read_column(first, first + text.size(), out).ec == std::errc();
+}
+
+/** @} */
+} // namespace fun
+
+#endif
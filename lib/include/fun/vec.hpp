@@ -0,0 +1,608 @@
+// The template and inlines for the -*- C++ -*- fixed-size vector classes.
+// Initially implemented by Wai-Shing Luk <luk036@gmail.com>
+//
+
+/** @file include/vec.hpp
+ *  This is a C++ Library header.
+ */
+
+#ifndef FUN_VEC_HPP
+#define FUN_VEC_HPP 1
+
+#include <cstddef>     // for std::size_t
+#include <cstdint>     // for std::int32_t, std::int64_t
+#include <type_traits> // for std::enable_if, std::is_same
+#include <utility>     // for std::index_sequence
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define FUN_VEC_SSE2 1
+#elif defined(__SSE4_1__)
+#include <smmintrin.h>
+#define FUN_VEC_SSE2 1
+#elif defined(__SSE2__) || defined(_M_X64) ||                                  \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define FUN_VEC_SSE2 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define FUN_VEC_NEON 1
+#endif
+
+// True outside of constant evaluation, where the SIMD kernels may run
+#if defined(__has_builtin)
+#if __has_builtin(__builtin_is_constant_evaluated)
+#define FUN_VEC_RUNTIME() (!__builtin_is_constant_evaluated())
+#endif
+#endif
+#if !defined(FUN_VEC_RUNTIME) && defined(_MSC_VER) && _MSC_VER >= 1925
+#define FUN_VEC_RUNTIME() (!__builtin_is_constant_evaluated())
+#endif
+#ifndef FUN_VEC_RUNTIME
+#define FUN_VEC_RUNTIME() false
+#endif
+
+namespace fun {
+/**
+ * @defgroup vec Fixed-size Vector and Matrix
+ * @ingroup linear_alg
+ *
+ * Generic core of the 2d, 3d and 4d vector and matrix classes: vec<K, N>
+ * and mat<K, R, C> (mat.hpp), of which vector2, vector3, matrix3, ... are
+ * thin wrappers. The kernels are unrolled at compile time and stay
+ * constexpr; at run time, the element-wise arithmetic of float, double
+ * and 32/64-bit integers goes through SIMD registers.
+ * @{
+ */
+
+namespace detail {
+
+/// Call @a f(i) for the compile-time indices i of the sequence
+template <class _Fn, std::size_t... _I>
+inline constexpr void unroll(_Fn &&f, std::index_sequence<_I...>) {
+  (f(std::integral_constant<std::size_t, _I>{}), ...);
+}
+
+/// Call @a f(0), ..., f(N - 1) with compile-time indices
+template <std::size_t _N, class _Fn> inline constexpr void unroll(_Fn &&f) {
+  unroll(f, std::make_index_sequence<_N>{});
+}
+
+/// Non-deduced context, so that scalars convert to the element type
+template <typename _K> struct identity { typedef _K type; };
+template <typename _K> using identity_t = typename identity<_K>::type;
+
+template <typename _K>
+using if_int32 =
+    std::enable_if_t<std::is_integral<_K>::value && sizeof(_K) == 4>;
+template <typename _K>
+using if_int64 =
+    std::enable_if_t<std::is_integral<_K>::value && sizeof(_K) == 8>;
+
+/**
+ *  SIMD registers of @a _W bytes holding elements of type @a _K:
+ *  lanes, load/store (aligned), set1, add and sub, and mul/div where
+ *  the instruction set has them. lanes == 0 means no SIMD.
+ */
+template <typename _K, std::size_t _W, class = void> struct vec_simd {
+  static constexpr std::size_t lanes = 0;
+};
+
+#if defined(FUN_VEC_SSE2)
+template <> struct vec_simd<float, 16> {
+  typedef __m128 reg;
+  static constexpr std::size_t lanes = 4;
+  static constexpr bool has_mul = true, has_div = true;
+  static reg load(const float *p) noexcept { return _mm_load_ps(p); }
+  static void store(float *p, reg a) noexcept { _mm_store_ps(p, a); }
+  static reg set1(float a) noexcept { return _mm_set1_ps(a); }
+  static reg add(reg a, reg b) noexcept { return _mm_add_ps(a, b); }
+  static reg sub(reg a, reg b) noexcept { return _mm_sub_ps(a, b); }
+  static reg mul(reg a, reg b) noexcept { return _mm_mul_ps(a, b); }
+  static reg div(reg a, reg b) noexcept { return _mm_div_ps(a, b); }
+};
+
+template <> struct vec_simd<double, 16> {
+  typedef __m128d reg;
+  static constexpr std::size_t lanes = 2;
+  static constexpr bool has_mul = true, has_div = true;
+  static reg load(const double *p) noexcept { return _mm_load_pd(p); }
+  static void store(double *p, reg a) noexcept { _mm_store_pd(p, a); }
+  static reg set1(double a) noexcept { return _mm_set1_pd(a); }
+  static reg add(reg a, reg b) noexcept { return _mm_add_pd(a, b); }
+  static reg sub(reg a, reg b) noexcept { return _mm_sub_pd(a, b); }
+  static reg mul(reg a, reg b) noexcept { return _mm_mul_pd(a, b); }
+  static reg div(reg a, reg b) noexcept { return _mm_div_pd(a, b); }
+};
+
+template <typename _K> struct vec_simd<_K, 16, if_int32<_K>> {
+  typedef __m128i reg;
+  static constexpr std::size_t lanes = 4;
+#ifdef __SSE4_1__
+  static constexpr bool has_mul = true, has_div = false;
+  static reg mul(reg a, reg b) noexcept { return _mm_mullo_epi32(a, b); }
+#else
+  static constexpr bool has_mul = false, has_div = false;
+#endif
+  static reg load(const _K *p) noexcept {
+    return _mm_load_si128(reinterpret_cast<const __m128i *>(p));
+  }
+  static void store(_K *p, reg a) noexcept {
+    _mm_store_si128(reinterpret_cast<__m128i *>(p), a);
+  }
+  static reg set1(_K a) noexcept { return _mm_set1_epi32(int(a)); }
+  static reg add(reg a, reg b) noexcept { return _mm_add_epi32(a, b); }
+  static reg sub(reg a, reg b) noexcept { return _mm_sub_epi32(a, b); }
+};
+
+template <typename _K> struct vec_simd<_K, 16, if_int64<_K>> {
+  typedef __m128i reg;
+  static constexpr std::size_t lanes = 2;
+  static constexpr bool has_mul = true, has_div = false;
+  static reg load(const _K *p) noexcept {
+    return _mm_load_si128(reinterpret_cast<const __m128i *>(p));
+  }
+  static void store(_K *p, reg a) noexcept {
+    _mm_store_si128(reinterpret_cast<__m128i *>(p), a);
+  }
+  static reg set1(_K a) noexcept { return _mm_set1_epi64x((long long)a); }
+  static reg add(reg a, reg b) noexcept { return _mm_add_epi64(a, b); }
+  static reg sub(reg a, reg b) noexcept { return _mm_sub_epi64(a, b); }
+  // a * b mod 2^64 by 32-bit halves: lo*lo + ((hi*lo + lo*hi) << 32)
+  static reg mul(reg a, reg b) noexcept {
+    const reg c = _mm_add_epi64(_mm_mul_epu32(_mm_srli_epi64(a, 32), b),
+                                _mm_mul_epu32(a, _mm_srli_epi64(b, 32)));
+    return _mm_add_epi64(_mm_mul_epu32(a, b), _mm_slli_epi64(c, 32));
+  }
+};
+#endif
+
+#if defined(__AVX__)
+template <> struct vec_simd<float, 32> {
+  typedef __m256 reg;
+  static constexpr std::size_t lanes = 8;
+  static constexpr bool has_mul = true, has_div = true;
+  static reg load(const float *p) noexcept { return _mm256_load_ps(p); }
+  static void store(float *p, reg a) noexcept { _mm256_store_ps(p, a); }
+  static reg set1(float a) noexcept { return _mm256_set1_ps(a); }
+  static reg add(reg a, reg b) noexcept { return _mm256_add_ps(a, b); }
+  static reg sub(reg a, reg b) noexcept { return _mm256_sub_ps(a, b); }
+  static reg mul(reg a, reg b) noexcept { return _mm256_mul_ps(a, b); }
+  static reg div(reg a, reg b) noexcept { return _mm256_div_ps(a, b); }
+};
+
+template <> struct vec_simd<double, 32> {
+  typedef __m256d reg;
+  static constexpr std::size_t lanes = 4;
+  static constexpr bool has_mul = true, has_div = true;
+  static reg load(const double *p) noexcept { return _mm256_load_pd(p); }
+  static void store(double *p, reg a) noexcept { _mm256_store_pd(p, a); }
+  static reg set1(double a) noexcept { return _mm256_set1_pd(a); }
+  static reg add(reg a, reg b) noexcept { return _mm256_add_pd(a, b); }
+  static reg sub(reg a, reg b) noexcept { return _mm256_sub_pd(a, b); }
+  static reg mul(reg a, reg b) noexcept { return _mm256_mul_pd(a, b); }
+  static reg div(reg a, reg b) noexcept { return _mm256_div_pd(a, b); }
+};
+#endif
+
+#if defined(__AVX2__)
+template <typename _K> struct vec_simd<_K, 32, if_int32<_K>> {
+  typedef __m256i reg;
+  static constexpr std::size_t lanes = 8;
+  static constexpr bool has_mul = true, has_div = false;
+  static reg load(const _K *p) noexcept {
+    return _mm256_load_si256(reinterpret_cast<const __m256i *>(p));
+  }
+  static void store(_K *p, reg a) noexcept {
+    _mm256_store_si256(reinterpret_cast<__m256i *>(p), a);
+  }
+  static reg set1(_K a) noexcept { return _mm256_set1_epi32(int(a)); }
+  static reg add(reg a, reg b) noexcept { return _mm256_add_epi32(a, b); }
+  static reg sub(reg a, reg b) noexcept { return _mm256_sub_epi32(a, b); }
+  static reg mul(reg a, reg b) noexcept { return _mm256_mullo_epi32(a, b); }
+};
+
+template <typename _K> struct vec_simd<_K, 32, if_int64<_K>> {
+  typedef __m256i reg;
+  static constexpr std::size_t lanes = 4;
+  static constexpr bool has_mul = true, has_div = false;
+  static reg load(const _K *p) noexcept {
+    return _mm256_load_si256(reinterpret_cast<const __m256i *>(p));
+  }
+  static void store(_K *p, reg a) noexcept {
+    _mm256_store_si256(reinterpret_cast<__m256i *>(p), a);
+  }
+  static reg set1(_K a) noexcept { return _mm256_set1_epi64x((long long)a); }
+  static reg add(reg a, reg b) noexcept { return _mm256_add_epi64(a, b); }
+  static reg sub(reg a, reg b) noexcept { return _mm256_sub_epi64(a, b); }
+  // a * b mod 2^64 by 32-bit halves: lo*lo + ((hi*lo + lo*hi) << 32)
+  static reg mul(reg a, reg b) noexcept {
+    const reg c =
+        _mm256_add_epi64(_mm256_mul_epu32(_mm256_srli_epi64(a, 32), b),
+                         _mm256_mul_epu32(a, _mm256_srli_epi64(b, 32)));
+    return _mm256_add_epi64(_mm256_mul_epu32(a, b), _mm256_slli_epi64(c, 32));
+  }
+};
+#endif
+
+#if defined(FUN_VEC_NEON)
+template <> struct vec_simd<float, 16> {
+  typedef float32x4_t reg;
+  static constexpr std::size_t lanes = 4;
+#if defined(__aarch64__)
+  static constexpr bool has_mul = true, has_div = true;
+  static reg div(reg a, reg b) noexcept { return vdivq_f32(a, b); }
+#else
+  static constexpr bool has_mul = true, has_div = false;
+#endif
+  static reg load(const float *p) noexcept { return vld1q_f32(p); }
+  static void store(float *p, reg a) noexcept { vst1q_f32(p, a); }
+  static reg set1(float a) noexcept { return vdupq_n_f32(a); }
+  static reg add(reg a, reg b) noexcept { return vaddq_f32(a, b); }
+  static reg sub(reg a, reg b) noexcept { return vsubq_f32(a, b); }
+  static reg mul(reg a, reg b) noexcept { return vmulq_f32(a, b); }
+};
+
+#if defined(__aarch64__)
+template <> struct vec_simd<double, 16> {
+  typedef float64x2_t reg;
+  static constexpr std::size_t lanes = 2;
+  static constexpr bool has_mul = true, has_div = true;
+  static reg load(const double *p) noexcept { return vld1q_f64(p); }
+  static void store(double *p, reg a) noexcept { vst1q_f64(p, a); }
+  static reg set1(double a) noexcept { return vdupq_n_f64(a); }
+  static reg add(reg a, reg b) noexcept { return vaddq_f64(a, b); }
+  static reg sub(reg a, reg b) noexcept { return vsubq_f64(a, b); }
+  static reg mul(reg a, reg b) noexcept { return vmulq_f64(a, b); }
+  static reg div(reg a, reg b) noexcept { return vdivq_f64(a, b); }
+};
+#endif
+
+template <typename _K> struct vec_simd<_K, 16, if_int32<_K>> {
+  typedef int32x4_t reg;
+  static constexpr std::size_t lanes = 4;
+  static constexpr bool has_mul = true, has_div = false;
+  static reg load(const _K *p) noexcept {
+    return vld1q_s32(reinterpret_cast<const std::int32_t *>(p));
+  }
+  static void store(_K *p, reg a) noexcept {
+    vst1q_s32(reinterpret_cast<std::int32_t *>(p), a);
+  }
+  static reg set1(_K a) noexcept { return vdupq_n_s32(std::int32_t(a)); }
+  static reg add(reg a, reg b) noexcept { return vaddq_s32(a, b); }
+  static reg sub(reg a, reg b) noexcept { return vsubq_s32(a, b); }
+  static reg mul(reg a, reg b) noexcept { return vmulq_s32(a, b); }
+};
+
+template <typename _K> struct vec_simd<_K, 16, if_int64<_K>> {
+  typedef int64x2_t reg;
+  static constexpr std::size_t lanes = 2;
+  static constexpr bool has_mul = false, has_div = false;
+  static reg load(const _K *p) noexcept {
+    return vld1q_s64(reinterpret_cast<const std::int64_t *>(p));
+  }
+  static void store(_K *p, reg a) noexcept {
+    vst1q_s64(reinterpret_cast<std::int64_t *>(p), a);
+  }
+  static reg set1(_K a) noexcept { return vdupq_n_s64(std::int64_t(a)); }
+  static reg add(reg a, reg b) noexcept { return vaddq_s64(a, b); }
+  static reg sub(reg a, reg b) noexcept { return vsubq_s64(a, b); }
+};
+#endif
+
+/**
+ *  Storage of vec<K, N>: with SIMD, the elements are padded (with zeros)
+ *  to whole registers and aligned to the register width, which is 32
+ *  bytes for 8-byte elements beyond two lanes if available, else 16.
+ */
+template <typename _K, std::size_t _N> struct vec_layout {
+  static constexpr std::size_t width =
+      sizeof(_K) == 8 && _N > 2 && vec_simd<_K, 32>::lanes != 0
+          ? 32
+          : vec_simd<_K, 16>::lanes != 0 ? 16 : 0;
+  typedef vec_simd<_K, width == 0 ? 16 : width> simd;
+  static constexpr std::size_t lanes = width == 0 ? 1 : simd::lanes;
+  static constexpr std::size_t size = (_N + lanes - 1) / lanes * lanes;
+  static constexpr std::size_t align = width == 0 ? alignof(_K) : width;
+};
+
+} // namespace detail
+
+/**
+ *  Fixed-size vector of @a N elements.
+ *
+ *  @param  K  Type of vector elements
+ *  @param  N  Number of elements
+ */
+template <typename _K, std::size_t _N> struct vec {
+  static_assert(_N > 0, "vec<K, N> requires N > 0");
+
+  /// Value typedef.
+  typedef _K value_type;
+
+  /// Return the number of elements.
+  static constexpr std::size_t size() noexcept { return _N; }
+
+  /// Default constructor (all zeros).
+  constexpr vec() noexcept : _e{} {}
+
+  /// Construct with the @a N elements @a e
+  template <typename... _Args,
+            typename = std::enable_if_t<
+                sizeof...(_Args) == _N &&
+                (std::is_convertible<const _Args &, _K>::value && ...)>>
+  constexpr vec(const _Args &... e) noexcept : _e{_K(e)...} {}
+
+  /// Construct from the vector @a w of another element type
+  template <typename _Up>
+  constexpr vec(const vec<_Up, _N> &w) noexcept
+      : vec(w, std::make_index_sequence<_N>{}) {}
+
+  /// Return the element @a i.
+  constexpr const _K &operator[](std::size_t i) const noexcept {
+    return _e[i];
+  }
+
+  /// Return the element @a i.
+  constexpr _K &operator[](std::size_t i) noexcept { return _e[i]; }
+
+  /// Return the elements.
+  constexpr const _K *data() const noexcept { return _e; }
+
+  /// Return the elements.
+  constexpr _K *data() noexcept { return _e; }
+
+  // Lets the compiler synthesize the copy assignment operator
+  /// Assign this vector to vector @a w.
+  template <typename _Up> constexpr vec &operator=(const vec<_Up, _N> &w) {
+    detail::unroll<_N>([&](auto i) { _e[i] = w[i]; });
+    return *this;
+  }
+
+  /// Add @a w to this vector.
+  template <typename _Up> constexpr vec &operator+=(const vec<_Up, _N> &w) {
+    if constexpr (std::is_same<_Up, _K>::value && _Layout::lanes > 1) {
+      if (FUN_VEC_RUNTIME())
+        return simd_map(w._e, [](auto a, auto b) { return _Simd::add(a, b); });
+    }
+    detail::unroll<_N>([&](auto i) { _e[i] += w[i]; });
+    return *this;
+  }
+
+  /// Subtract @a w from this vector.
+  template <typename _Up> constexpr vec &operator-=(const vec<_Up, _N> &w) {
+    if constexpr (std::is_same<_Up, _K>::value && _Layout::lanes > 1) {
+      if (FUN_VEC_RUNTIME())
+        return simd_map(w._e, [](auto a, auto b) { return _Simd::sub(a, b); });
+    }
+    detail::unroll<_N>([&](auto i) { _e[i] -= w[i]; });
+    return *this;
+  }
+
+  /// Multiply this vector by @a a.
+  template <typename _Up> constexpr vec &operator*=(const _Up &a) {
+    if constexpr (std::is_same<_Up, _K>::value && _Layout::lanes > 1) {
+      if constexpr (_Simd::has_mul) {
+        if (FUN_VEC_RUNTIME())
+          return simd_map(a, [](auto x, auto y) { return _Simd::mul(x, y); });
+      }
+    }
+    detail::unroll<_N>([&](auto i) { _e[i] *= a; });
+    return *this;
+  }
+
+  /// Divide this vector by @a a.
+  template <typename _Up> constexpr vec &operator/=(const _Up &a) {
+    if constexpr (std::is_same<_Up, _K>::value && _Layout::lanes > 1) {
+      if constexpr (_Simd::has_div) {
+        if (FUN_VEC_RUNTIME()) { // the zero padding stays 0 for a != 0
+          simd_map(a, [](auto x, auto y) { return _Simd::div(x, y); });
+          detail::unroll<_Layout::size - _N>(
+              [&](auto i) { _e[_N + i] = _K(0); });
+          return *this;
+        }
+      }
+    }
+    detail::unroll<_N>([&](auto i) { _e[i] /= a; });
+    return *this;
+  }
+
+  /// Add @a a times @a w to this vector (the row kernel of mat products).
+  constexpr vec &add_scaled(const _K &a, const vec &w) {
+    if constexpr (_Layout::lanes > 1) {
+      if constexpr (_Simd::has_mul) {
+        if (FUN_VEC_RUNTIME()) {
+          const auto s = _Simd::set1(a);
+          return simd_map(w._e, [s](auto x, auto y) {
+            return _Simd::add(x, _Simd::mul(s, y));
+          });
+        }
+      }
+    }
+    detail::unroll<_N>([&](auto i) { _e[i] += a * w[i]; });
+    return *this;
+  }
+
+private:
+  typedef detail::vec_layout<_K, _N> _Layout;
+  typedef typename _Layout::simd _Simd;
+
+  template <typename _Up, std::size_t... _I>
+  constexpr vec(const vec<_Up, _N> &w, std::index_sequence<_I...>) noexcept
+      : _e{_K(w[_I])...} {}
+
+  /// Apply @a op to the registers of this vector and of @a w
+  template <class _Op> vec &simd_map(const _K *w, _Op op) noexcept {
+    detail::unroll<_Layout::size / _Layout::lanes>([&](auto k) {
+      _K *p = _e + k * _Layout::lanes;
+      _Simd::store(p, op(_Simd::load(p), _Simd::load(w + k * _Layout::lanes)));
+    });
+    return *this;
+  }
+
+  /// Apply @a op to the registers of this vector and the scalar @a a
+  template <class _Op> vec &simd_map(const _K &a, _Op op) noexcept {
+    const auto s = _Simd::set1(a);
+    detail::unroll<_Layout::size / _Layout::lanes>([&](auto k) {
+      _K *p = _e + k * _Layout::lanes;
+      _Simd::store(p, op(_Simd::load(p), s));
+    });
+    return *this;
+  }
+
+  alignas(_Layout::align) _K _e[_Layout::size];
+};
+
+namespace detail {
+
+template <typename _K, std::size_t _N, class _Fn, std::size_t... _I>
+inline constexpr auto vec_map(const vec<_K, _N> &v, _Fn f,
+                              std::index_sequence<_I...>)
+    -> vec<decltype(f(v[0])), _N> {
+  return {f(v[_I])...};
+}
+
+/// Return the vector of @a f(v[i])
+template <typename _K, std::size_t _N, class _Fn>
+inline constexpr auto vec_map(const vec<_K, _N> &v, _Fn f)
+    -> vec<decltype(f(v[0])), _N> {
+  return vec_map(v, f, std::make_index_sequence<_N>{});
+}
+
+template <typename _K, typename _L, std::size_t _N, class _Fn,
+          std::size_t... _I>
+inline constexpr auto vec_zip(const vec<_K, _N> &v, const vec<_L, _N> &w,
+                              _Fn f, std::index_sequence<_I...>)
+    -> vec<decltype(f(v[0], w[0])), _N> {
+  return {f(v[_I], w[_I])...};
+}
+
+/// Return the vector of @a f(v[i], w[i])
+template <typename _K, typename _L, std::size_t _N, class _Fn>
+inline constexpr auto vec_zip(const vec<_K, _N> &v, const vec<_L, _N> &w,
+                              _Fn f) -> vec<decltype(f(v[0], w[0])), _N> {
+  return vec_zip(v, w, f, std::make_index_sequence<_N>{});
+}
+
+template <typename _K, std::size_t _N, std::size_t... _I>
+inline constexpr _K vec_dot(const vec<_K, _N> &v, const vec<_K, _N> &w,
+                            std::index_sequence<_I...>) noexcept {
+  return (... + (v[_I] * w[_I])); // left to right, as written by hand
+}
+
+template <typename _K, std::size_t _N, std::size_t... _I>
+inline constexpr bool vec_equal(const vec<_K, _N> &v, const vec<_K, _N> &w,
+                                std::index_sequence<_I...>) noexcept {
+  return (... && (v[_I] == w[_I]));
+}
+
+} // namespace detail
+
+// Operators:
+///  Return new vector @a v plus @a w.
+template <typename _K, std::size_t _N>
+inline constexpr vec<_K, _N> operator+(vec<_K, _N> v, const vec<_K, _N> &w) {
+  return v += w;
+}
+
+///  Return new vector @a v minus @a w.
+template <typename _K, std::size_t _N>
+inline constexpr vec<_K, _N> operator-(vec<_K, _N> v, const vec<_K, _N> &w) {
+  return v -= w;
+}
+
+//@{
+///  Return new vector @a v times @a a.
+template <typename _K, std::size_t _N>
+inline constexpr vec<_K, _N> operator*(vec<_K, _N> v,
+                                       const detail::identity_t<_K> &a) {
+  return v *= a;
+}
+
+template <typename _K, std::size_t _N>
+inline constexpr vec<_K, _N> operator*(const detail::identity_t<_K> &a,
+                                       vec<_K, _N> v) {
+  return v *= a;
+}
+//@}
+
+///  Return new vector @a v divided by @a a.
+template <typename _K, std::size_t _N>
+inline constexpr vec<_K, _N> operator/(vec<_K, _N> v,
+                                       const detail::identity_t<_K> &a) {
+  return v /= a;
+}
+
+/// Return @a v.
+template <typename _K, std::size_t _N>
+inline constexpr vec<_K, _N> operator+(const vec<_K, _N> &v) noexcept {
+  return v;
+}
+
+/// Return negation of @a v.
+template <typename _K, std::size_t _N>
+inline constexpr vec<_K, _N> operator-(const vec<_K, _N> &v) noexcept {
+  return detail::vec_map(v, [](const _K &a) -> _K { return -a; });
+}
+
+/// Return true if @a v is equal to @a w.
+template <typename _K, std::size_t _N>
+inline constexpr bool operator==(const vec<_K, _N> &v,
+                                 const vec<_K, _N> &w) noexcept {
+  return detail::vec_equal(v, w, std::make_index_sequence<_N>{});
+}
+
+/// Return false if @a v is equal to @a w.
+template <typename _K, std::size_t _N>
+inline constexpr bool operator!=(const vec<_K, _N> &v,
+                                 const vec<_K, _N> &w) noexcept {
+  return !(v == w);
+}
+
+///  Return dot product of @a v and @a w
+template <typename _K, std::size_t _N>
+inline constexpr _K dot(const vec<_K, _N> &v, const vec<_K, _N> &w) noexcept {
+  return detail::vec_dot(v, w, std::make_index_sequence<_N>{});
+}
+
+///  Return the quadrance of @a v
+template <typename _K, std::size_t _N>
+inline constexpr _K quadrance(const vec<_K, _N> &v) noexcept {
+  return dot(v, v);
+}
+
+///  Return new vector @a v x @a w (cross product).
+template <typename _K>
+inline constexpr vec<_K, 3> cross(const vec<_K, 3> &v,
+                                  const vec<_K, 3> &w) noexcept {
+  return vec<_K, 3>(v[1] * w[2] - v[2] * w[1], -v[0] * w[2] + v[2] * w[0],
+                    v[0] * w[1] - v[1] * w[0]);
+}
+
+/// Return determinant of @a v and @a w.
+template <typename _K>
+inline constexpr _K det(const vec<_K, 2> &v, const vec<_K, 2> &w) noexcept {
+  return v[0] * w[1] - v[1] * w[0];
+}
+
+///  Return determinant of @a p, @a q and @a r.
+template <typename _K>
+inline constexpr _K det(const vec<_K, 3> &p, const vec<_K, 3> &q,
+                        const vec<_K, 3> &r) noexcept {
+  return dot(p, cross(q, r)); // Pl\{"}ucker's formula
+}
+
+///  Insertion operator for vector values.
+template <typename _K, std::size_t _N, class _Stream>
+_Stream &operator<<(_Stream &os, const vec<_K, _N> &v) {
+  os << '(' << v[0];
+  for (std::size_t i = 1; i != _N; ++i)
+    os << ',' << v[i];
+  os << ')';
+  return os;
+}
+
+/** @} */
+} // namespace fun
+
+#endif
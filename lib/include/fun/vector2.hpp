@@ -11,6 +11,7 @@
 
 #include <sstream>
 //#include "rational.hpp"
+#include "vec.hpp"
 
 namespace fun 
 {
@@ -26,65 +27,64 @@ namespace fun
   template<typename _K> struct vector2;
 
   /** 
-   *  2-dimensional vector. 
+   *  2-dimensional vector, a thin wrapper of vec<K, 2>.
    *
    *  @param  K  Type of vector elements
    */
   template <typename _K>
-  struct vector2
+  struct vector2 : vec<_K, 2>
   {
     /// Value typedef.
     typedef _K value_type;
  
     /// Default constructor.
-    constexpr vector2() : _e1(_K(0)), _e2(_K(0)) { }
+    constexpr vector2() : _Base(_K(0), _K(0)) { }
 
     /// Construct with two elements @a e1 and @a e2 
     constexpr vector2(const _K& e1, const _K& e2) 
-      : _e1(e1), _e2(e2) { }
+      : _Base(e1, e2) { }
 
     // Lets the compiler synthesize the copy constructor
     // vector2 (const vector2<_K>&);
-    /// Copy constructor
+    /// Copy constructor (also from vec<Up, 2>)
     template<typename _Up>
-    vector2(const vector2<_Up>& w) 
-      : _e1(w.e1()), _e2(w.e2()) { }
+    constexpr vector2(const vec<_Up, 2>& w) 
+      : _Base(w) { }
 
     /// Return first element of vector.
-    constexpr _K e1() { return _e1; }
+    constexpr _K e1() const { return (*this)[0]; }
 
     /// Return second element of vector.
-    constexpr _K e2() { return _e2; }
+    constexpr _K e2() const { return (*this)[1]; }
 
     // Lets the compiler synthesize the assignment operator
     // vector2<_K>& operator= (const vector2<_K>&);
     /// Assign this vector to vector @a w.
     template<typename _Up>
     vector2<_K>& operator=(const vector2<_Up>& w)
-    { _e1 = w.e1(); _e2 = w.e2(); return *this; }
+    { _Base::operator=(w); return *this; }
 
     /// Add @a w to this vector.
     template<typename _Up>
     vector2<_K>& operator+=(const vector2<_Up>& w)
-    { _e1 += w.e1(); _e2 += w.e2(); return *this; }
+    { _Base::operator+=(w); return *this; }
 
     /// Subtract @a w from this vector.
     template<typename _Up>
     vector2<_K>& operator-=(const vector2<_Up>& w)
-    { _e1 -= w.e1(); _e2 -= w.e2(); return *this; }
+    { _Base::operator-=(w); return *this; }
 
     /// Multiply this vector by @a a.
     vector2<_K>& operator*=(const _K& a) 
-    { _e1 *= a; _e2 *= a; return *this; }
+    { _Base::operator*=(a); return *this; }
 
     /// Divide this vector by @a a.
     vector2<_K>& operator/=(const _K& a) 
-    { _e1 /= a; _e2 /= a; return *this; }
+    { _Base::operator/=(a); return *this; }
   
 
   private:
-    _K _e1;
-    _K _e2;
+    typedef vec<_K, 2> _Base;
   
   };
 
@@ -150,13 +150,13 @@ namespace fun
   template<typename _K>
   inline vector2<_K>
   operator-(const vector2<_K>& v)
-  { return vector2<_K>(-v.e1(), -v.e2()); }
+  { return -static_cast<const vec<_K, 2>&>(v); }
 
   /// Return true if @a v is equal to @a w.
   template<typename _K>
   inline constexpr bool
   operator==(const vector2<_K>& v, const vector2<_K>& w)
-  { return v.e1() == w.e1() && v.e2() == w.e2(); }
+  { return static_cast<const vec<_K, 2>&>(v) == w; }
 
   /// Return false if @a v is equal to @a w.
   template<typename _K>
@@ -168,7 +168,7 @@ namespace fun
   template<typename _K>
   inline _K
   dot(const vector2<_K>& v, const vector2<_K>& w)
-  { return v.e1()*w.e1() + v.e2()*w.e2(); }
+  { return dot(static_cast<const vec<_K, 2>&>(v), w); }
 
   /// Return determinant of @a v and @a w/
   template<typename _K>
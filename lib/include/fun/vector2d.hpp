@@ -11,6 +11,7 @@
 
 //#include <sstream>
 //#include "rational.hpp"
+#include "vec.hpp"
 
 namespace fun {
 /**
@@ -25,73 +26,66 @@ namespace fun {
 template <typename _K> struct vector2d;
 
 /**
- *  2-dimensional vector.
+ *  2-dimensional vector, a thin wrapper of vec<K, 2>.
  *
  *  @param  K  Type of vector elements
  */
-template <typename _K> struct vector2d {
+template <typename _K> struct vector2d : vec<_K, 2> {
   /// Value typedef.
   typedef _K value_type;
 
   /// Default constructor.
-  constexpr vector2d() noexcept : _e1{_K{0}}, _e2{_K{0}} {}
+  constexpr vector2d() noexcept : _Base{_K{0}, _K{0}} {}
 
   /// Construct with two elements @a e1 and @a e2
-  constexpr vector2d(const _K &e1, const _K &e2) noexcept : _e1{e1}, _e2{e2} {}
+  constexpr vector2d(const _K &e1, const _K &e2) noexcept : _Base{e1, e2} {}
 
   // Lets the compiler synthesize the copy constructor
   // vector2d (const vector2d<_K>&);
-  /// Copy constructor
+  /// Copy constructor (also from vec<Up, 2>)
   template <typename _Up>
-  constexpr vector2d(const vector2d<_Up> &w) noexcept
-      : _e1{w.e1()}, _e2{w.e2()} {}
+  constexpr vector2d(const vec<_Up, 2> &w) noexcept : _Base{w} {}
 
   /// Return first element of vector.
-  constexpr _K e1() const noexcept { return _e1; }
+  constexpr _K e1() const noexcept { return (*this)[0]; }
 
   /// Return second element of vector.
-  constexpr _K e2() const noexcept { return _e2; }
+  constexpr _K e2() const noexcept { return (*this)[1]; }
 
   // Lets the compiler synthesize the assignment operator
   // vector2d<_K>& operator= (const vector2d<_K>&);
   /// Assign this vector to vector @a w.
   template <typename _Up> vector2d<_K> &operator=(const vector2d<_Up> &w) {
-    _e1 = w.e1();
-    _e2 = w.e2();
+    _Base::operator=(w);
     return *this;
   }
 
   /// Add @a w to this vector.
   template <typename _Up> vector2d<_K> &operator+=(const vector2d<_Up> &w) {
-    _e1 += w.e1();
-    _e2 += w.e2();
+    _Base::operator+=(w);
     return *this;
   }
 
   /// Subtract @a w from this vector.
   template <typename _Up> vector2d<_K> &operator-=(const vector2d<_Up> &w) {
-    _e1 -= w.e1();
-    _e2 -= w.e2();
+    _Base::operator-=(w);
     return *this;
   }
 
   /// Multiply this vector by @a a.
   template <typename _Up> vector2d<_K> &operator*=(const _Up &a) {
-    _e1 *= a;
-    _e2 *= a;
+    _Base::operator*=(a);
     return *this;
   }
 
   /// Divide this vector by @a a.
   template <typename _Up> vector2d<_K> &operator/=(const _Up &a) {
-    _e1 /= a;
-    _e2 /= a;
+    _Base::operator/=(a);
     return *this;
   }
 
 private:
-  _K _e1;
-  _K _e2;
+  typedef vec<_K, 2> _Base;
 };
 
 // Operators:
@@ -169,14 +163,14 @@ inline constexpr vector2d<_K> operator+(const vector2d<_K> &v) noexcept {
 /// Return negation of @a v/
 template <typename _K>
 inline constexpr vector2d<_K> operator-(const vector2d<_K> &v) noexcept {
-  return vector2d<_K>(-v.e1(), -v.e2());
+  return -static_cast<const vec<_K, 2> &>(v);
 }
 
 /// Return true if @a v is equal to @a w.
 template <typename _K>
 inline constexpr bool operator==(const vector2d<_K> &v,
                                  const vector2d<_K> &w) noexcept {
-  return v.e1() == w.e1() && v.e2() == w.e2();
+  return static_cast<const vec<_K, 2> &>(v) == w;
 }
 
 /// Return false if @a v is equal to @a w.
@@ -189,7 +183,7 @@ inline constexpr bool operator!=(const vector2d<_K> &v,
 ///  Return dot product of  @a v and @a w
 template <typename _K>
 inline constexpr _K dot(const vector2d<_K> &v, const vector2d<_K> &w) noexcept {
-  return v.e1() * w.e1() + v.e2() * w.e2();
+  return dot(static_cast<const vec<_K, 2> &>(v), w);
 }
 
 /// Return determinant of @a v and @a w/
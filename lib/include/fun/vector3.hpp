@@ -9,6 +9,8 @@
 #ifndef FUN_VECTOR3_HPP
 #define FUN_VECTOR3_HPP 1
 
+#include "lin_expr.hpp"
+
 namespace fun {
 /**
  * @defgroup 3d_vector 3d Vector
@@ -22,168 +24,119 @@ namespace fun {
 template <typename _K> struct vector3;
 
 /**
- *  3-dimensional vector.
+ *  3-dimensional vector, a thin wrapper of vec<K, 3>. The arithmetic
+ *  operators are lazy (see lin_expr): a whole expression is evaluated on
+ *  assignment, element by element, without temporaries.
  *
  *  @param  Tp  Type of vector elements
  */
-template <typename _K> struct vector3 {
+template <typename _K> struct vector3 : vec<_K, 3> {
   /// Value typedef.
   typedef _K value_type;
 
+  /// Expression operand typedef (see lin_expr).
+  typedef vector3<_K> leaf_type;
+
   /// Default constructor.
   ///  Unspecified parameters default to 0.
   constexpr vector3(const _K &e1, const _K &e2, const _K &e3) noexcept
-      : _e1{e1}, _e2{e2}, _e3{e3} {}
+      : _Base{e1, e2, e3} {}
 
   // Lets the compiler synthesize the copy constructor
   // vector3 (const vector3<_K>&);
-  /// Copy constructor
+  /// Copy constructor (also from vec<Up, 3>)
   template <typename _Up>
-  constexpr vector3(const vector3<_Up> &w) noexcept
-      : _e1{w.e1()}, _e2{w.e2()}, _e3{w.e3()} {}
+  constexpr vector3(const vec<_Up, 3> &w) noexcept : _Base{w} {}
+
+  /// Construct from the value of the vector expression @a e
+  template <class _Op, class... _Args,
+            detail::if_lin_family<vector3, lin_expr<_Op, _Args...>> * = nullptr>
+  constexpr vector3(const lin_expr<_Op, _Args...> &e)
+      : _Base{detail::lin_eval<_Base>(e)} {}
 
   /// Return first element of vector.
-  constexpr _K e1() const noexcept { return _e1; }
+  constexpr _K e1() const noexcept { return (*this)[0]; }
 
   /// Return second element of vector.
-  constexpr _K e2() const noexcept { return _e2; }
+  constexpr _K e2() const noexcept { return (*this)[1]; }
 
   /// Return third element of vector.
-  constexpr _K e3() const noexcept { return _e3; }
+  constexpr _K e3() const noexcept { return (*this)[2]; }
 
   // Lets the compiler synthesize the assignment operator
   // vector3<_K>& operator= (const vector3<_K>&);
   /// Assign this vector to vector @a w.
-  template <typename _Up> vector3<_K> &operator=(const vector3<_Up> &w) {
-    _e1 = w.e1();
-    _e2 = w.e2();
-    _e3 = w.e3();
+  template <typename _Up>
+  constexpr vector3<_K> &operator=(const vector3<_Up> &w) {
+    _Base::operator=(w);
+    return *this;
+  }
+
+  /// Assign this vector to the value of the expression @a e.
+  template <class _Op, class... _Args,
+            detail::if_lin_family<vector3, lin_expr<_Op, _Args...>> * = nullptr>
+  constexpr vector3<_K> &operator=(const lin_expr<_Op, _Args...> &e) {
+    detail::lin_assign(static_cast<_Base &>(*this), e,
+                       [](_K &a, const auto &b) { a = b; });
     return *this;
   }
 
   /// Add @a w to this vector.
-  template <typename _Up> vector3<_K> &operator+=(const vector3<_Up> &w) {
-    _e1 += w.e1();
-    _e2 += w.e2();
-    _e3 += w.e3();
+  template <typename _Up>
+  constexpr vector3<_K> &operator+=(const vector3<_Up> &w) {
+    _Base::operator+=(w);
+    return *this;
+  }
+
+  /// Add the value of the expression @a e to this vector.
+  template <class _Op, class... _Args,
+            detail::if_lin_family<vector3, lin_expr<_Op, _Args...>> * = nullptr>
+  constexpr vector3<_K> &operator+=(const lin_expr<_Op, _Args...> &e) {
+    detail::lin_assign(static_cast<_Base &>(*this), e,
+                       [](_K &a, const auto &b) { a += b; });
     return *this;
   }
 
   /// Subtract @a w from this vector.
-  template <typename _Up> vector3<_K> &operator-=(const vector3<_Up> &w) {
-    _e1 -= w.e1();
-    _e2 -= w.e2();
-    _e3 -= w.e3();
+  template <typename _Up>
+  constexpr vector3<_K> &operator-=(const vector3<_Up> &w) {
+    _Base::operator-=(w);
+    return *this;
+  }
+
+  /// Subtract the value of the expression @a e from this vector.
+  template <class _Op, class... _Args,
+            detail::if_lin_family<vector3, lin_expr<_Op, _Args...>> * = nullptr>
+  constexpr vector3<_K> &operator-=(const lin_expr<_Op, _Args...> &e) {
+    detail::lin_assign(static_cast<_Base &>(*this), e,
+                       [](_K &a, const auto &b) { a -= b; });
     return *this;
   }
 
   /// Multiply this vector by @a a.
-  vector3<_K> &operator*=(const _K &a) {
-    _e1 *= a;
-    _e2 *= a;
-    _e3 *= a;
+  constexpr vector3<_K> &operator*=(const _K &a) {
+    _Base::operator*=(a);
     return *this;
   }
 
   /// Divide this vector by @a a.
-  vector3<_K> &operator/=(const _K &a) {
-    _e1 /= a;
-    _e2 /= a;
-    _e3 /= a;
+  constexpr vector3<_K> &operator/=(const _K &a) {
+    _Base::operator/=(a);
     return *this;
   }
 
 private:
-  _K _e1;
-  _K _e2;
-  _K _e3;
+  typedef vec<_K, 3> _Base;
 };
 
 // Operators:
-///  Return new vector @a v plus @a w.
-template <typename _K>
-inline vector3<_K> operator+(vector3<_K> v, const vector3<_K> &w) {
-  return v += w;
-}
-
-///  Return new vector @a v plus @a w.
-template <typename _K, typename _L>
-inline constexpr auto operator+(const vector3<_K> &v,
-                                const vector3<_L> &w) noexcept
-    -> vector3<decltype(v.e1() + w.e1())> {
-  return vector3<decltype(v.e1() + w.e1())>{v.e1() + w.e1(), v.e2() + w.e2(),
-                                            v.e3() + w.e3()};
-}
-
-/// Return new vector @a v minus @a w.
-template <typename _K>
-inline vector3<_K> operator-(vector3<_K> v, const vector3<_K> &w) {
-  return v -= w;
-}
-
-///  Return new vector @a v plus @a w.
-template <typename _K, typename _L>
-inline constexpr auto operator-(const vector3<_K> &v,
-                                const vector3<_L> &w) noexcept
-    -> vector3<decltype(v.e1() - w.e1())> {
-  return vector3<decltype(v.e1() - w.e1())>{v.e1() - w.e1(), v.e2() - w.e2(),
-                                            v.e3() - w.e3()};
-}
-
-//@{
-///  Return new vector @a v times @a a.
-template <typename _K>
-inline vector3<_K> operator*(vector3<_K> v, const _K &a) {
-  return v *= a;
-}
-
-template <typename _K>
-inline vector3<_K> operator*(const _K &a, vector3<_K> v) {
-  return v *= a;
-}
-//@}
-
-template <typename _K, typename _Up>
-inline constexpr auto operator*(const vector3<_K> &v, const _Up &a) noexcept
-    -> vector3<decltype(v.e1() * a)> {
-  return vector3<decltype(v.e1() * a)>{v.e1() * a, v.e2() * a, v.e3() * a};
-}
-
-template <typename _K, typename _Up>
-inline constexpr auto operator*(const _Up &a, const vector3<_K> &v) noexcept
-    -> vector3<decltype(a * v.e1())> {
-  return vector3<decltype(a * v.e1())>{a * v.e1(), a * v.e2(), a * v.e3()};
-}
-
-///  Return new vector @a v divided by @a a.
-template <typename _K>
-inline vector3<_K> operator/(vector3<_K> v, const _K &a) {
-  return v /= a;
-}
-
-template <typename _K, typename _Up>
-inline constexpr auto operator/(const vector3<_K> &v, const _Up &a) noexcept
-    -> vector3<decltype(v.e1() / a)> {
-  return vector3<decltype(v.e1() / a)>{v.e1() / a, v.e2() / a, v.e3() / a};
-}
-
-/// Return @a v.
-template <typename _K>
-inline constexpr vector3<_K> operator+(const vector3<_K> &v) noexcept {
-  return v;
-}
-
-/// Return negation of @a v/
-template <typename _K>
-inline constexpr vector3<_K> operator-(const vector3<_K> &v) noexcept {
-  return vector3<_K>(-v.e1(), -v.e2(), -v.e3());
-}
+// The arithmetic operators +, -, * and / are the lazy ones of lin_expr.
 
 /// Return true if @a v is equal to @a w.
 template <typename _K>
 inline constexpr bool operator==(const vector3<_K> &v,
                                  const vector3<_K> &w) noexcept {
-  return v.e1() == w.e1() && v.e2() == w.e2() && v.e3() == w.e3();
+  return static_cast<const vec<_K, 3> &>(v) == w;
 }
 
 /// Return false if @a v is equal to @a w.
@@ -196,7 +149,16 @@ inline constexpr bool operator!=(const vector3<_K> &v,
 ///  Return dot product of  @a v and @a w
 template <typename _K>
 inline constexpr _K dot(const vector3<_K> &v, const vector3<_K> &w) noexcept {
-  return v.e1() * w.e1() + v.e2() * w.e2() + v.e3() * w.e3();
+  return dot(static_cast<const vec<_K, 3> &>(v), w);
+}
+
+///  Return dot product of  @a v and @a w, where either is an expression
+template <class _V, class _W,
+          detail::if_lin_family<vector3, _V, _W> * = nullptr>
+inline constexpr auto dot(const _V &v, const _W &w) {
+  using detail::lin_elem;
+  return lin_elem(v, 0) * lin_elem(w, 0) + lin_elem(v, 1) * lin_elem(w, 1) +
+         lin_elem(v, 2) * lin_elem(w, 2);
 }
 
 ///  Return the quadrance of  @a v
@@ -205,13 +167,29 @@ inline constexpr _K quadrance(const vector3<_K> &v) noexcept {
   return dot(v, v);
 }
 
+///  Return the quadrance of the vector expression @a e
+template <class _Op, class... _Args,
+          detail::if_lin_family<vector3, lin_expr<_Op, _Args...>> * = nullptr>
+inline constexpr auto quadrance(const lin_expr<_Op, _Args...> &e) {
+  return quadrance(e.eval());
+}
+
 ///  Return new vector @a v x @a w (cross product).
 template <typename _K>
 inline constexpr vector3<_K> cross(const vector3<_K> &v,
                                    const vector3<_K> &w) noexcept {
-  return vector3<_K>(v.e2() * w.e3() - v.e3() * w.e2(),
-                     -v.e1() * w.e3() + v.e3() * w.e1(),
-                     v.e1() * w.e2() - v.e2() * w.e1());
+  return cross(static_cast<const vec<_K, 3> &>(v), w);
+}
+
+///  Return new vector @a v x @a w, where either is an expression.
+template <class _V, class _W,
+          detail::if_lin_family<vector3, _V, _W> * = nullptr>
+inline constexpr auto cross(const _V &v, const _W &w) {
+  const auto &a = detail::lin_value(v); // each element is used twice
+  const auto &b = detail::lin_value(w);
+  return vector3<decltype(a[0] * b[0])>(a[1] * b[2] - a[2] * b[1],
+                                        a[2] * b[0] - a[0] * b[2],
+                                        a[0] * b[1] - a[1] * b[0]);
 }
 
 ///  Return determinant of @a p,  @a q and @a r.
@@ -221,6 +199,13 @@ inline constexpr _K det(const vector3<_K> &p, const vector3<_K> &q,
   return dot(p, cross(q, r)); // Pl\{"}ucker's formula
 }
 
+///  Return determinant of @a p,  @a q and @a r, where any is an expression.
+template <class _P, class _Q, class _R,
+          detail::if_lin_family<vector3, _P, _Q, _R> * = nullptr>
+inline constexpr auto det(const _P &p, const _Q &q, const _R &r) {
+  return dot(p, cross(q, r));
+}
+
 ///  Insertion operator for vector values.
 template <typename _K, class _Stream>
 _Stream &operator<<(_Stream &os, const vector3<_K> &v) {
@@ -11,16 +11,19 @@
 
 #include <boost/operators.hpp>   // for boost::addable etc
 
+#include "vec.hpp"
+
 namespace fun 
 {
   
 /** 
- *  3-dimensional vector. 
+ *  3-dimensional vector, a thin wrapper of vec<K, 3>.
  *
  *  @param  Tp  Type of vector elements
  */
 template <typename _K>
 class vector3d :
+  public vec<_K, 3>,
   boost::equality_comparable < vector3d<_K>,
   boost::addable < vector3d<_K>,
   boost::subtractable < vector3d<_K>,
@@ -40,41 +43,43 @@ public:
     const _K& e1, 
     const _K& e2, 
     const _K& e3) noexcept
-    : _e1{e1}, _e2{e2}, _e3{e3} { }
+    : _Base{e1, e2, e3} { }
+
+  /// Construct from the generic vector
+  constexpr vector3d<_K>(const vec<_K, 3>& v) noexcept
+    : _Base{v} { }
 
   /// Return first element of vector.
-  constexpr _K e1() const noexcept { return _e1; }
+  constexpr _K e1() const noexcept { return (*this)[0]; }
   /// Return second element of vector.
-  constexpr _K e2() const noexcept { return _e2; }
+  constexpr _K e2() const noexcept { return (*this)[1]; }
   /// Return third element of vector.
-  constexpr _K e3() const noexcept { return _e3; }
+  constexpr _K e3() const noexcept { return (*this)[2]; }
 
   // Lets the compiler synthesize the assignment operator
   // vector3d<_K>& operator= (const vector3d<_K>&);
   /// Assign this vector to vector @a w.
   /// Add @a w to this vector.
-  vector3d<_K>& operator+=(const vector3d<_K>& w)
-  { _e1 += w.e1(); _e2 += w.e2(); _e3 += w.e3(); return *this; }
+  constexpr vector3d<_K>& operator+=(const vector3d<_K>& w)
+  { _Base::operator+=(w); return *this; }
 
   /// Subtract @a w from this vector.
-  vector3d<_K>& operator-=(const vector3d<_K>& w)
-  { _e1 -= w.e1(); _e2 -= w.e2(); _e3 -= w.e3(); return *this; }
+  constexpr vector3d<_K>& operator-=(const vector3d<_K>& w)
+  { _Base::operator-=(w); return *this; }
 
   /// Multiply this vector by @a a.
-  vector3d<_K>& operator*=(const _K& a) 
-  { _e1 *= a; _e2 *= a; _e3 *= a; return *this; }
+  constexpr vector3d<_K>& operator*=(const _K& a) 
+  { _Base::operator*=(a); return *this; }
 
   /// Divide this vector by @a a.
-  vector3d<_K>& operator/=(const _K& a) 
-  { _e1 /= a; _e2 /= a; _e3 /= a; return *this; }
+  constexpr vector3d<_K>& operator/=(const _K& a) 
+  { _Base::operator/=(a); return *this; }
   
   constexpr bool operator== (const vector3d<_K>& w) const
-  { return e1() == w.e1() && e2() == w.e2() && e3() == w.e3(); }
+  { return static_cast<const _Base&>(*this) == w; }
 
 private:
-  _K _e1;
-  _K _e2;
-  _K _e3;  
+  typedef vec<_K, 3> _Base;
 };
 
 template <typename _K>
@@ -90,24 +95,19 @@ operator+(const vector3d<_K>& v) noexcept
 template<typename _K>
 inline constexpr vector3d<_K>
 operator-(const vector3d<_K>& v) noexcept
-{ return vector3d<_K>(-v.e1(), -v.e2(), -v.e3()); }
+{ return -static_cast<const vec<_K, 3>&>(v); }
 
 ///  Return dot product of  @a v and @a w
 template<typename _K>
 inline constexpr _K
 dot(const vector3d<_K>& v, const vector3d<_K>& w) noexcept
-{ return v.e1()*w.e1() + v.e2()*w.e2() + v.e3()* w.e3(); }
+{ return dot(static_cast<const vec<_K, 3>&>(v), w); }
 
 ///  Return new vector @a v x @a w (cross product).
 template<typename _K>
 inline constexpr vector3d<_K>
 cross(const vector3d<_K>& v, const vector3d<_K>& w) noexcept
-{
-  return vector3d<_K>( 
-     v.e2()*w.e3() - v.e3()*w.e2(),
-    -v.e1()*w.e3() + v.e3()*w.e1(),
-     v.e1()*w.e2() - v.e2()*w.e1()  );
-}
+{ return cross(static_cast<const vec<_K, 3>&>(v), w); }
 
 ///  Return determinant of @a p,  @a q and @a r.
 template<typename _K>
@@ -2,18 +2,29 @@
 // Initially implemented by Wai-Shing Luk <luk036@gmail.com>
 //
 
-/** @file include/valarray.hpp
+/** @file include/vector3d_new.hpp
  *  This is a C++ Library header.
  */
 
-#ifndef FUN_VECTOR3D_HPP
-#define FUN_VECTOR3D_HPP 1
+#ifndef FUN_VECTOR3D_NEW_HPP
+#define FUN_VECTOR3D_NEW_HPP 1
 
 #include <valarray>
+#include "vec.hpp"
 
 namespace fun 
 {
-  
+
+// The points and lines of pg_point_new.hpp and pg_line_new.hpp keep their
+// coordinates inline in a vec<K, 3>, whose dot, cross, det and quadrance
+// (vec.hpp) allocate nothing. The std::valarray overloads below remain
+// for other callers; each valarray result is a heap allocation.
+
+///  Return true if @a v is the zero vector
+template <typename _K>
+inline constexpr bool is_zero(const vec<_K, 3>& v) noexcept
+{ return v[0] == _K(0) && v[1] == _K(0) && v[2] == _K(0); }
+
 template <typename _K>
 bool is_zero(const std::valarray<_K>& v)
 { return v[0] == _K(0) && v[1] == _K(0) && v[2] == _K(0); }
@@ -0,0 +1,72 @@
+#include "GF2_slice_t.hpp"
+#include <GF2_slice.hpp>
+#include <point3.hpp>
+#include <vector>
+
+using namespace fun;
+
+CPPUNIT_TEST_SUITE_REGISTRATION( GF2_slice_TestCase );
+
+void GF2_slice_TestCase::test_kernels()
+{
+  typedef GF<2> F;
+  std::vector<point3<F>> ps, qs;
+  for (unsigned i = 0; i != 64; ++i) {
+    ps.push_back(point3<F>(unpack((i * 5 + 1) % 8)));
+    qs.push_back(point3<F>(unpack((i * 3 + i / 8) % 8)));
+  }
+  const auto p = make_slice(ps.begin(), ps.end());
+  const auto q = make_slice(qs.begin(), qs.end());
+  const auto pq = cross(p, q);
+  const auto d = dot(p, q);
+  const auto e = equal(p, q);
+  for (unsigned i = 0; i != 64; ++i) {
+    CPPUNIT_ASSERT( lane(p, i) == ps[i] );
+    CPPUNIT_ASSERT( lane(pq, i) == cross(ps[i], qs[i]) );
+    CPPUNIT_ASSERT( ((d >> i) & 1U) == dot(ps[i], qs[i]).value() );
+    CPPUNIT_ASSERT( (((e >> i) & 1U) != 0) == (ps[i] == qs[i]) );
+  }
+  CPPUNIT_ASSERT( equal(p + q - q, p) == ~std::uint64_t(0) );
+  CPPUNIT_ASSERT( nonzero(p - p) == 0 );
+}
+
+void GF2_slice_TestCase::test_fano()
+{
+  typedef gf2_slice<3> S;
+  const S pts = S::all_points();
+  const std::uint64_t valid = S::points_mask();
+  CPPUNIT_ASSERT( count(valid) == 7 );
+  CPPUNIT_ASSERT( count(nonzero(pts)) == 7 );
+
+  // Every line has 3 points and every two points span one line
+  for (std::uint32_t l = 1; l != 8; ++l)
+    CPPUNIT_ASSERT( count(incident(pts, S::broadcast(l)) & valid) == 3 );
+  for (std::uint32_t a = 1; a != 8; ++a) {
+    const S pa = S::broadcast(a);
+    const S ln = cross(pa, pts); // lines through a and each point
+    const std::uint64_t other = valid & ~equal(pa, pts);
+    CPPUNIT_ASSERT( (nonzero(ln) & valid) == other );
+    CPPUNIT_ASSERT( (incident(pa, ln) & other) == other );
+    CPPUNIT_ASSERT( (incident(pts, ln) & other) == other );
+  }
+
+  // (1,0,0), (0,1,0), (1,1,0) are collinear; (0,0,1) is not on that line
+  S p, q, r;
+  p.set(0, 1); q.set(0, 2); r.set(0, 3);
+  p.set(1, 1); q.set(1, 2); r.set(1, 4);
+  CPPUNIT_ASSERT( (det(p, q, r) & 3U) == 2U );
+  CPPUNIT_ASSERT( r.get(1) == 4U );
+}
+
+void GF2_slice_TestCase::test_space()
+{
+  typedef gf2_slice<4> S;
+  const S pts = S::all_points();
+  const std::uint64_t valid = S::points_mask();
+  CPPUNIT_ASSERT( count(valid) == 15 );
+  for (std::uint32_t h = 1; h != 16; ++h)
+    CPPUNIT_ASSERT( count(incident(pts, S::broadcast(h)) & valid) == 7 );
+  S t = pts;
+  t &= std::uint64_t(0xff);
+  CPPUNIT_ASSERT( count(nonzero(t)) == 8 );
+}
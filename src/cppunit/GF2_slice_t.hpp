@@ -0,0 +1,32 @@
+#ifndef CPPUNIT_GF2_SLICE_T_HPP
+#define CPPUNIT_GF2_SLICE_T_HPP 1
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <GF2_slice.hpp>
+
+/**
+ * A test case for gf2_slice
+ */
+class GF2_slice_TestCase : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE( GF2_slice_TestCase );
+  CPPUNIT_TEST( test_kernels );
+  CPPUNIT_TEST( test_fano );
+  CPPUNIT_TEST( test_space );
+  CPPUNIT_TEST_SUITE_END();
+
+protected:
+  /** Test the lane-wise kernels against point3<GF<2>> */
+  void test_kernels();
+
+  /** Test the incidence structure of the Fano plane PG(2, 2) */
+  void test_fano();
+
+  /** Test the planes of PG(3, 2) */
+  void test_space();
+};
+
+/** @} */
+
+#endif
@@ -0,0 +1,81 @@
+#include "GF_array_t.hpp"
+#include <GF_array.hpp>
+#include <line3.hpp>
+#include <point3.hpp>
+#include <vector>
+
+using namespace fun;
+
+CPPUNIT_TEST_SUITE_REGISTRATION( GF_array_TestCase );
+
+namespace {
+
+/// Return n elements a, a + b, a + 2b, ... of GF(p)
+template <std::uint64_t _p>
+gf_array<_p> iota(std::size_t n, unsigned a, unsigned b)
+{
+  gf_array<_p> r;
+  for (std::size_t i = 0; i != n; ++i)
+    r.push_back(GF<_p>(unsigned((a + i * b) % _p)));
+  return r;
+}
+
+} // namespace
+
+void GF_array_TestCase::test_elementwise()
+{
+  typedef GF<2147483647> F; // 2^31 - 1
+  const auto x = iota<2147483647>(19, 2147483000, 12345);
+  const auto y = iota<2147483647>(19, 2147480000, 98765);
+  const auto z = iota<2147483647>(19, 3, 5);
+  const auto s = x + y, d = x - y, m = x * y, f = fma(x, y, z);
+  const F a(7U);
+  const auto t = x * a;
+  for (std::size_t i = 0; i != x.size(); ++i) {
+    CPPUNIT_ASSERT( s[i] == x[i] + y[i] );
+    CPPUNIT_ASSERT( d[i] == x[i] - y[i] );
+    CPPUNIT_ASSERT( m[i] == x[i] * y[i] );
+    CPPUNIT_ASSERT( f[i] == x[i] * y[i] + z[i] );
+    CPPUNIT_ASSERT( t[i] == x[i] * a );
+  }
+  CPPUNIT_ASSERT( x + y - y == x );
+
+  gf_array<7> u(5, GF<7>(3U)), v(5, GF<7>(5U));
+  u *= v; // 15 = 1
+  CPPUNIT_ASSERT( u == gf_array<7>(5, GF<7>(1U)) );
+}
+
+void GF_array_TestCase::test_dot()
+{
+  for (std::size_t n : {0, 1, 7, 8, 9, 33}) {
+    const auto x = iota<65521>(n, 65000, 777);
+    const auto y = iota<65521>(n, 123, 65000);
+    GF<65521> s;
+    for (std::size_t i = 0; i != n; ++i)
+      s += x[i] * y[i];
+    CPPUNIT_ASSERT( dot(x, y) == s );
+  }
+}
+
+void GF_array_TestCase::test_incidence()
+{
+  typedef GF<13> F;
+  std::vector<point3<F>> ps, qs;
+  gf_array<13> p[3], q[3];
+  for (unsigned i = 0; i != 20; ++i) {
+    ps.emplace_back(F(i % 13), F((3 * i + 1) % 13), F(1U));
+    qs.emplace_back(F((5 * i + 2) % 13), F(1U), F((i * i) % 13));
+    for (int k = 0; k != 3; ++k) {
+      p[k].push_back(k == 0 ? ps[i].x() : k == 1 ? ps[i].y() : ps[i].z());
+      q[k].push_back(k == 0 ? qs[i].x() : k == 1 ? qs[i].y() : qs[i].z());
+    }
+  }
+  gf_array<13> l[3];
+  cross(p, q, l);
+  const auto dp = dot(p, l), dq = dot(q, l);
+  for (unsigned i = 0; i != 20; ++i) {
+    const line3<F> m(ps[i], qs[i]);
+    CPPUNIT_ASSERT( l[0][i] == m.a() && l[1][i] == m.b() && l[2][i] == m.c() );
+    CPPUNIT_ASSERT( dp[i] == F() && dq[i] == F() );
+  }
+}
@@ -0,0 +1,32 @@
+#ifndef CPPUNIT_GF_ARRAY_T_HPP
+#define CPPUNIT_GF_ARRAY_T_HPP 1
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <GF_array.hpp>
+
+/**
+ * A test case for gf_array
+ */
+class GF_array_TestCase : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE( GF_array_TestCase );
+  CPPUNIT_TEST( test_elementwise );
+  CPPUNIT_TEST( test_dot );
+  CPPUNIT_TEST( test_incidence );
+  CPPUNIT_TEST_SUITE_END();
+
+protected:
+  /** Test add, sub, mul and fma against GF<p> */
+  void test_elementwise();
+
+  /** Test the dot product, with and without a remainder */
+  void test_dot();
+
+  /** Test joins and incidences of point3<GF<p>> stored by coordinates */
+  void test_incidence();
+};
+
+/** @} */
+
+#endif
@@ -0,0 +1,136 @@
+#include "GF_ext_t.hpp"
+#include <GF_ext.hpp>
+#include <line3.hpp>
+#include <point3.hpp>
+
+using namespace fun;
+
+CPPUNIT_TEST_SUITE_REGISTRATION( GF_ext_TestCase );
+
+namespace {
+
+/// Check the field axioms on all elements
+template <class _F> bool check_field()
+{
+  typedef typename _F::value_type _V;
+  for (_V i = 0; i != _F::order; ++i) {
+    const _F a(i);
+    if (a.value() != i || a + (-a) != _F())
+      return false;
+    if (i != 0 && (a * inv(a)).value() != 1)
+      return false;
+    for (_V j = 0; j != _F::order; ++j) {
+      const _F b(j), c(_V((i + 2 * j + 1) % _F::order));
+      if (a * (b + c) != a * b + a * c || (a * b) * c != a * (b * c))
+        return false;
+      if ((a - b) + b != a || (j != 0 && (a / b) * b != a))
+        return false;
+    }
+  }
+  return true;
+}
+
+/// Check the field axioms on a sample of the elements, @a step apart
+template <class _F> bool check_sample(std::uint64_t step)
+{
+  typedef typename _F::value_type _V;
+  const _F one(_V(1));
+  for (std::uint64_t i = 1; i < _F::order; i += step) {
+    const _F a{_V(i)}, b{_V((7 * i + 3) % _F::order)},
+        c{_V((i * i + 1) % _F::order)};
+    if (a.value() != i || a * inv(a) != one || a + (-a) != _F())
+      return false;
+    if (a * (b + c) != a * b + a * c || (a * b) * c != a * (b * c))
+      return false;
+    if (pow(a, _F::order - 1) != one) // the multiplicative group order
+      return false;
+  }
+  return true;
+}
+
+/// Return the number of points of the line @a l in PG(2, q)
+template <class _F> unsigned count_points(const line3<_F> &l)
+{
+  typedef typename _F::value_type _V;
+  const _F zero, one(_V(1));
+  unsigned n = l.incident(point3<_F>(one, zero, zero)) ? 1 : 0;
+  for (_V x = 0; x != _F::order; ++x) {
+    n += l.incident(point3<_F>(_F(x), one, zero)) ? 1 : 0;
+    for (_V y = 0; y != _F::order; ++y)
+      n += l.incident(point3<_F>(_F(x), _F(y), one)) ? 1 : 0;
+  }
+  return n;
+}
+
+} // namespace
+
+void GF_ext_TestCase::test_binary()
+{
+  typedef GF_ext<2, 2> F4; // x^2 + x + 1
+  const F4 x(2), one(1);
+  CPPUNIT_ASSERT( x * x == x + one );
+  CPPUNIT_ASSERT( pow(x, 3) == one );
+  CPPUNIT_ASSERT( -x == x );
+  CPPUNIT_ASSERT( (check_field<F4>()) );
+  CPPUNIT_ASSERT( (check_field<GF_ext<2, 3>>()) );
+  CPPUNIT_ASSERT( (check_field<GF_ext<2, 4, 0x19>>()) ); // x^4 + x^3 + 1
+
+  typedef GF_ext<2, 8, 0x11b> F256; // the AES field
+  CPPUNIT_ASSERT( (F256(0x57) * F256(0x83)).value() == 0xc1 );
+  CPPUNIT_ASSERT( inv(F256(0x53)).value() == 0xca );
+}
+
+void GF_ext_TestCase::test_odd()
+{
+  typedef GF_ext<3, 2> F9; // x^2 + 1, i.e. GF(3)[i]
+  const F9 i(3), one(1), two(2);
+  CPPUNIT_ASSERT( i * i == -one );
+  CPPUNIT_ASSERT( (one + two).value() == 0 );
+  CPPUNIT_ASSERT( (i + one).value() == 4 );
+  CPPUNIT_ASSERT( pow(i + one, 8) == one );
+  CPPUNIT_ASSERT( (check_field<F9>()) );
+  CPPUNIT_ASSERT( (check_field<GF_ext<3, 3>>()) );
+  CPPUNIT_ASSERT( (check_field<GF_ext<5, 2>>()) );
+}
+
+void GF_ext_TestCase::test_large_odd()
+{
+  CPPUNIT_ASSERT( (check_sample<GF_ext<3, 8>>(37)) );   // 6561
+  CPPUNIT_ASSERT( (check_sample<GF_ext<5, 6>>(101)) );  // 15625
+  CPPUNIT_ASSERT( (check_sample<GF_ext<3, 10>>(331)) ); // 59049
+  typedef GF_ext<251, 2> F; // 63001
+  CPPUNIT_ASSERT( (check_sample<F>(331)) );
+  const F x(251);
+  CPPUNIT_ASSERT( pow(x, 63000) == F(1) );
+}
+
+void GF_ext_TestCase::test_clmul()
+{
+  typedef GF_ext<2, 16> F; // x^16 + x^5 + x^3 + x + 1
+  CPPUNIT_ASSERT( !F::table_mode );
+  const F a(0x8000), x(2);
+  CPPUNIT_ASSERT( (a * x).value() == 0x2b );
+  for (unsigned v = 1; v < 65536; v += 251) {
+    const F b(v);
+    CPPUNIT_ASSERT( (b * inv(b)).value() == 1 );
+    CPPUNIT_ASSERT( pow(b, 65535) == F(1) );
+  }
+
+  typedef GF_ext<2, 61> G;
+  const G c(0x123456789abcdefULL), d(0x0fedcba987654321ULL);
+  CPPUNIT_ASSERT( (c * d) * inv(d) == c );
+  CPPUNIT_ASSERT( c * (d + G(1)) == c * d + c );
+}
+
+void GF_ext_TestCase::test_plane()
+{
+  typedef GF_ext<2, 2> F4;
+  const line3<F4> l(F4(1), F4(2), F4(3));
+  CPPUNIT_ASSERT( count_points(l) == 5 );
+  const point3<F4> p(F4(1), F4(3), F4(1)), q(F4(2), F4(0), F4(1));
+  const line3<F4> m(p, q);
+  CPPUNIT_ASSERT( m.incident(p) && m.incident(q) );
+
+  typedef GF_ext<3, 2> F9;
+  CPPUNIT_ASSERT( count_points(line3<F9>(F9(5), F9(1), F9(7))) == 10 );
+}
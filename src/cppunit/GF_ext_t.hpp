@@ -0,0 +1,40 @@
+#ifndef CPPUNIT_GF_EXT_T_HPP
+#define CPPUNIT_GF_EXT_T_HPP 1
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <GF_ext.hpp>
+
+/**
+ * A test case for GF_ext
+ */
+class GF_ext_TestCase : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE( GF_ext_TestCase );
+  CPPUNIT_TEST( test_binary );
+  CPPUNIT_TEST( test_odd );
+  CPPUNIT_TEST( test_large_odd );
+  CPPUNIT_TEST( test_clmul );
+  CPPUNIT_TEST( test_plane );
+  CPPUNIT_TEST_SUITE_END();
+
+protected:
+  /** Test GF(2^k) with tables */
+  void test_binary();
+
+  /** Test GF(p^k) for odd p (Zech logarithms) */
+  void test_odd();
+
+  /** Test odd-characteristic fields near the 2^16 bound */
+  void test_large_odd();
+
+  /** Test GF(2^k) with carry-less multiplication */
+  void test_clmul();
+
+  /** Test the projective planes of order 4 and 9 */
+  void test_plane();
+};
+
+/** @} */
+
+#endif
@@ -0,0 +1,72 @@
+#include "GF_mont_t.hpp"
+#include <GF.hpp>
+#include <GF_mont.hpp>
+#include <line3.hpp>
+#include <point3.hpp>
+
+using namespace fun;
+
+CPPUNIT_TEST_SUITE_REGISTRATION( GF_mont_TestCase );
+
+void GF_mont_TestCase::test_arith()
+{
+  for (unsigned a = 0; a < 13; ++a) {
+    CPPUNIT_ASSERT( GF_mont<13>(a).value() == a );
+    for (unsigned b = 0; b < 13; ++b) {
+      const GF<13> x(a), y(b);
+      const GF_mont<13> u(a), v(b);
+      CPPUNIT_ASSERT( (u + v).value() == (x + y).value() );
+      CPPUNIT_ASSERT( (u - v).value() == (x - y).value() );
+      CPPUNIT_ASSERT( (u * v).value() == (x * y).value() );
+      CPPUNIT_ASSERT( (u == v) == (a == b) );
+    }
+    CPPUNIT_ASSERT( (-GF_mont<13>(a)).value() == (-GF<13>(a)).value() );
+  }
+}
+
+void GF_mont_TestCase::test_large()
+{
+  const unsigned p = 4294967291U; // largest prime below 2^32
+  typedef GF_mont<p> F;
+  const F a(p - 1), b(p - 2);
+  CPPUNIT_ASSERT( (a * a).value() == 1 );
+  CPPUNIT_ASSERT( (a * b).value() == 2 );
+  CPPUNIT_ASSERT( (a + b).value() == p - 3 );
+  CPPUNIT_ASSERT( (F(1) - a).value() == 2 );
+  CPPUNIT_ASSERT( (F(123456789) * F(987654321)).value() ==
+                  unsigned(123456789ULL * 987654321ULL % p) );
+}
+
+void GF_mont_TestCase::test_geometry()
+{
+  typedef GF_mont<7> F;
+  point3<F> p(F(1), F(2), F(3)), q(F(4), F(5), F(6));
+  line3<F> l(p, q);
+  CPPUNIT_ASSERT( l.incident(p) && l.incident(q) );
+  CPPUNIT_ASSERT( !l.incident(point3<F>(F(1), F(0), F(0))) );
+}
+
+void GF_mont_TestCase::test_inverse()
+{
+  typedef GF_mont<1000000007> F;
+  const F x(123456789);
+  CPPUNIT_ASSERT( (x * inv(x)).value() == 1 );
+  CPPUNIT_ASSERT( (F(1) / F(3)).value() == 333333336 );
+  CPPUNIT_ASSERT( pow(F(2), 30).value() == (1U << 30) % 1000000007U );
+  CPPUNIT_ASSERT( pow(x, -5) * pow(x, 5) == F(1) );
+  CPPUNIT_ASSERT( pow(F(0), 0) == F(1) );
+}
+
+void GF_mont_TestCase::test_wide()
+{
+  const std::uint64_t p = 4611686018427387847ULL; // 2^62 - 57
+  typedef GF_mont<p> F;
+  const F a(p - 1), b(3037000499ULL), c(1ULL << 61);
+  CPPUNIT_ASSERT( (a * a).value() == 1 );
+  CPPUNIT_ASSERT( (b * b).value() == 4611686012498861154ULL );
+  CPPUNIT_ASSERT( (c * F(4)).value() == 114 ); // 2^63 mod p
+  CPPUNIT_ASSERT( (c + c + c).value() == 3 * (1ULL << 61) - p );
+  CPPUNIT_ASSERT( (F(5) - a).value() == 6 );
+  CPPUNIT_ASSERT( (b * inv(b)).value() == 1 );
+  CPPUNIT_ASSERT( pow(b, p - 1) == F(1) );
+}
@@ -0,0 +1,40 @@
+#ifndef CPPUNIT_GF_MONT_T_HPP
+#define CPPUNIT_GF_MONT_T_HPP 1
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <GF_mont.hpp>
+
+/**
+ * A test case for GF_mont
+ */
+class GF_mont_TestCase : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE( GF_mont_TestCase );
+  CPPUNIT_TEST( test_arith );
+  CPPUNIT_TEST( test_large );
+  CPPUNIT_TEST( test_geometry );
+  CPPUNIT_TEST( test_inverse );
+  CPPUNIT_TEST( test_wide );
+  CPPUNIT_TEST_SUITE_END();
+
+protected:
+  /** Test the field operations against GF<p> */
+  void test_arith();
+
+  /** Test a modulus close to 2^32 */
+  void test_large();
+
+  /** Test points and lines over GF_mont */
+  void test_geometry();
+
+  /** Test inv, pow and division */
+  void test_inverse();
+
+  /** Test a 62-bit modulus */
+  void test_wide();
+};
+
+/** @} */
+
+#endif
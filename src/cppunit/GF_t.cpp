@@ -0,0 +1,102 @@
+#include "GF_t.hpp"
+#include <GF.hpp>
+#include <GF_traits.hpp>
+#include <cstdint>
+#include <point3.hpp>
+
+using namespace fun;
+
+CPPUNIT_TEST_SUITE_REGISTRATION( GF_TestCase );
+
+void GF_TestCase::test_table()
+{
+  static_assert(GF<101>::table_mode, "small p uses tables");
+  typedef GF<101> F;
+  for (unsigned a = 1; a < 101; ++a) {
+    const F x(a);
+    CPPUNIT_ASSERT( (x * inv(x)).value() == 1 );
+    CPPUNIT_ASSERT( (F(1) / x * x).value() == 1 );
+    CPPUNIT_ASSERT( pow(x, 100).value() == 1 );
+    CPPUNIT_ASSERT( pow(x, 3) == x * x * x );
+    CPPUNIT_ASSERT( pow(x, -2) * x * x == F(1) );
+    for (unsigned b = 0; b < 101; b += 7)
+      CPPUNIT_ASSERT( (x * F(b)).value() == a * b % 101 );
+  }
+  CPPUNIT_ASSERT( pow(F(0), 0) == F(1) && pow(F(0), 3) == F(0) );
+  CPPUNIT_ASSERT( inv(GF<2>(1)) == GF<2>(1) );
+}
+
+void GF_TestCase::test_euclid()
+{
+  const unsigned p = 1000000007U;
+  static_assert(!GF<p>::table_mode, "large p computes");
+  typedef GF<p> F;
+  const F x(123456789);
+  CPPUNIT_ASSERT( (x * inv(x)).value() == 1 );
+  CPPUNIT_ASSERT( inv(F(2)).value() == 500000004 );
+  CPPUNIT_ASSERT( (F(1) / F(3)).value() == 333333336 );
+  CPPUNIT_ASSERT( pow(x, p - 1) == F(1) );
+  CPPUNIT_ASSERT( pow(F(2), 30).value() == (1U << 30) % p );
+  CPPUNIT_ASSERT( pow(F(2), -1) == inv(F(2)) );
+}
+
+void GF_TestCase::test_normalize()
+{
+  typedef GF<7> F;
+  const point3<F> p(F(3), F(5), F(4));
+  const F z = inv(p.z());
+  const point3<F> q(p.x() * z, p.y() * z, F(1));
+  CPPUNIT_ASSERT( q.x() * p.z() == p.x() && q.y() * p.z() == p.y() );
+  CPPUNIT_ASSERT( (p.x() / p.z()).value() == 6 ); // 3 * 2
+}
+
+void GF_TestCase::test_wide()
+{
+  const std::uint64_t p = 4611686018427387847ULL; // 2^62 - 57
+  typedef GF<p> F;
+  const F a(p - 1), b(3037000499ULL), c(1ULL << 61);
+  CPPUNIT_ASSERT( (a * a).value() == 1 );
+  CPPUNIT_ASSERT( (b * b).value() == 4611686012498861154ULL );
+  CPPUNIT_ASSERT( (c * F(4)).value() == 114 ); // 2^63 mod p
+  CPPUNIT_ASSERT( (c + c + c).value() == 3 * (1ULL << 61) - p );
+  CPPUNIT_ASSERT( (F(5) - a).value() == 6 );
+  CPPUNIT_ASSERT( (b * inv(b)).value() == 1 );
+  CPPUNIT_ASSERT( pow(b, p - 1) == F(1) );
+}
+
+void GF_TestCase::test_traits()
+{
+  using detail::is_prime;
+  static_assert(is_prime(2) && is_prime(998244353), "primes");
+  static_assert(is_prime(18446744073709551557ULL), "largest 64-bit prime");
+  static_assert(!is_prime(0) && !is_prime(1) && !is_prime(561), "Carmichael");
+  static_assert(!is_prime(3215031751ULL), "strong pseudoprime to 2, 3, 5, 7");
+  static_assert(!is_prime(4294967297ULL), "641 * 6700417");
+
+  constexpr auto f = detail::factorize(1000000007ULL * 998244353ULL);
+  static_assert(f.size == 2 && f.q[0] * f.q[1] == 1000000007ULL * 998244353ULL,
+                "Pollard-Brent");
+  static_assert(detail::factorize(~0ULL).size == 7, // 2^64 - 1
+                "3 * 5 * 17 * 257 * 641 * 65537 * 6700417");
+
+  typedef gf_traits<998244353> T;
+  static_assert(T::primitive_root == 3 && T::two_adicity == 23, "NTT prime");
+  static_assert(T::order(T::root_of_unity) == 1U << 23, "root of unity");
+  static_assert(gf_traits<1000000007>::primitive_root == 5, "");
+  static_assert(GF<7>::traits::primitive_root == 3 &&
+                    GF<7>::traits::order(2) == 3, "");
+  static_assert(GF<7>::traits::montgomery::r2 == 2, "R^2 = 2^64 mod 7");
+
+  // the smallest primitive root, also for 64-bit p
+  constexpr std::uint64_t p = 4611686018427387847ULL; // 2^62 - 57
+  constexpr std::uint64_t g = gf_traits<p>::primitive_root;
+  CPPUNIT_ASSERT( gf_traits<p>::order(g) == p - 1 );
+  for (std::uint64_t h = 2; h != g; ++h)
+    CPPUNIT_ASSERT( gf_traits<p>::order(h) != p - 1 );
+
+  for (std::uint64_t x : {0ULL, 1ULL, 998244352ULL, 998244353ULL,
+                          0x123456789abcdefULL, ~0ULL})
+    CPPUNIT_ASSERT( T::reduce(x) == x % 998244353 );
+  const std::uint64_t q = 4294967291ULL; // 2^32 - 5
+  CPPUNIT_ASSERT( gf_traits<q>::reduce(~0ULL) == ~0ULL % q );
+}
@@ -0,0 +1,40 @@
+#ifndef CPPUNIT_GF_T_HPP
+#define CPPUNIT_GF_T_HPP 1
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <GF.hpp>
+
+/**
+ * A test case for GF
+ */
+class GF_TestCase : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE( GF_TestCase );
+  CPPUNIT_TEST( test_table );
+  CPPUNIT_TEST( test_euclid );
+  CPPUNIT_TEST( test_normalize );
+  CPPUNIT_TEST( test_wide );
+  CPPUNIT_TEST( test_traits );
+  CPPUNIT_TEST_SUITE_END();
+
+protected:
+  /** Test inv, pow and division with log/antilog tables */
+  void test_table();
+
+  /** Test inv, pow and division for a large prime */
+  void test_euclid();
+
+  /** Test the normalization of projective points */
+  void test_normalize();
+
+  /** Test a 62-bit modulus */
+  void test_wide();
+
+  /** Test the compile-time metadata (primality, roots, constants) */
+  void test_traits();
+};
+
+/** @} */
+
+#endif
@@ -0,0 +1,93 @@
+#include "adaptive_predicates_t.hpp"
+#include <adaptive_predicates.hpp>
+#include <cmath>
+
+using namespace fun;
+
+CPPUNIT_TEST_SUITE_REGISTRATION( adaptive_predicates_TestCase );
+
+namespace {
+
+/// Sign of the orientation det(p, q, r)
+template <typename _K>
+int orient(const point3<_K> &p, const point3<_K> &q, const point3<_K> &r) {
+  return adaptive::sign([](const auto &a, const auto &b, const auto &c) {
+    return dot(a, cross(b, c)); }, p, q, r);
+}
+
+} // namespace
+
+void adaptive_predicates_TestCase::test_filter()
+{
+  const fp_bound a(0.1), b(3);
+  CPPUNIT_ASSERT( (a * b).certain() && (a * b).sign() == 1 );
+  CPPUNIT_ASSERT( (a - a).certain() && (a - a).sign() == 0 );
+  const fp_bound c = a * b - b * a - a;
+  CPPUNIT_ASSERT( c.certain() && c.sign() == -1 );
+  // 2^53 + 1 is not a double
+  const fp_bound d((1LL << 53) + 1), e(1LL << 53);
+  static_assert(fp_bound(-(1LL << 54)).error == 4.0 && fp_bound(-7).error == 0,
+                "integer bounds are constant expressions");
+  CPPUNIT_ASSERT( !(d - e).certain() );
+  CPPUNIT_ASSERT( !(fp_bound(HUGE_VAL) - fp_bound(1.0)).certain() );
+}
+
+void adaptive_predicates_TestCase::test_incident()
+{
+  point3<int> p(1, 2, 1);
+  line3<int> l(1, 1, -3);
+  CPPUNIT_ASSERT( adaptive::incident(p, l) );
+  CPPUNIT_ASSERT( !adaptive::incident(p, line3<int>(1, 1, -2)) );
+
+  // Beyond 2^53 the double dot product cancels to 0 in both cases
+  const long long n = (1LL << 53) + 1;
+  point3<long long> q(n, 1, 1);
+  CPPUNIT_ASSERT( adaptive::incident(q, line3<long long>(1, -n, 0)) );
+  CPPUNIT_ASSERT( !adaptive::incident(q, line3<long long>(1, -(n - 1), 0)) );
+
+  // Points on x == y are collinear, although 0.1 + 0.2 != 0.3
+  point3<double> a(0.1, 0.1, 1), b(0.2, 0.2, 1), c(0.3, 0.3, 1);
+  CPPUNIT_ASSERT( orient(a, b, c) == 0 );
+  point3<double> d(0.3, std::nextafter(0.3, 1.0), 1);
+  CPPUNIT_ASSERT( orient(a, b, d) == 1 );
+  CPPUNIT_ASSERT( orient(a, d, b) == -1 );
+  CPPUNIT_ASSERT( orient(a, b, point3<double>(1, 2, 1)) == 1 );
+}
+
+void adaptive_predicates_TestCase::test_equiv()
+{
+  CPPUNIT_ASSERT( adaptive::equiv(point3<int>(1, 2, 3), point3<int>(2, 4, 6)) );
+  CPPUNIT_ASSERT( adaptive::equiv(point3<int>(1, 2, 0), point3<int>(-3, -6, 0)) );
+  CPPUNIT_ASSERT( !adaptive::equiv(point3<int>(1, 0, 0), point3<int>(0, 1, 0)) );
+  CPPUNIT_ASSERT( adaptive::equiv(line3<double>(0.5, 0.25, 1),
+                                  line3<double>(-2, -1, -4)) );
+  CPPUNIT_ASSERT( !adaptive::equiv(line3<double>(0.1, 0.3, 1),
+                                   line3<double>(1, 3, 10)) );
+}
+
+void adaptive_predicates_TestCase::test_harmonic()
+{
+  // Lines through the origin with slopes 0, inf, 1 and -1
+  point3<int> a(0, 0, 1), b(1, 0, 1), c(0, 1, 1), d(1, 1, 1), e(1, -1, 1);
+  CPPUNIT_ASSERT( adaptive::harmonic(a, b, c, d, e) );
+  CPPUNIT_ASSERT( !adaptive::harmonic(a, b, c, d, point3<int>(2, -1, 1)) );
+
+  point3<double> ad(0, 0, 1), bd(1, 0, 1), cd(0, 1, 1), dd(0.1, 0.1, 1),
+      ed(0.3, -0.3, 1);
+  CPPUNIT_ASSERT( adaptive::harmonic(ad, bd, cd, dd, ed) );
+}
+
+void adaptive_predicates_TestCase::test_conic()
+{
+  // Six points on the unit circle
+  point3<long long> a(1, 0, 1), b(0, 1, 1), c(-1, 0, 1), d(0, -1, 1),
+      e(3, 4, 5), f(4, -3, 5);
+  CPPUNIT_ASSERT( adaptive::on_a_conic(a, b, c, d, e, f) );
+  CPPUNIT_ASSERT( !adaptive::on_a_conic(a, b, c, d, e, point3<long long>(4, 3, 6)) );
+
+  point3<double> ad(1, 0, 1), bd(0, 1, 1), cd(-1, 0, 1), dd(0, -1, 1),
+      ed(3, 4, 5), fd(4, -3, 5);
+  CPPUNIT_ASSERT( adaptive::on_a_conic(ad, bd, cd, dd, ed, fd) );
+  point3<double> gd(4, -3, 5 + std::ldexp(1.0, -40));
+  CPPUNIT_ASSERT( !adaptive::on_a_conic(ad, bd, cd, dd, ed, gd) );
+}
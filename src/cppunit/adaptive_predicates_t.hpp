@@ -0,0 +1,40 @@
+#ifndef CPPUNIT_ADAPTIVE_PREDICATES_T_HPP
+#define CPPUNIT_ADAPTIVE_PREDICATES_T_HPP 1
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <adaptive_predicates.hpp>
+
+/**
+ * A test case for the adaptive predicates
+ */
+class adaptive_predicates_TestCase : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE( adaptive_predicates_TestCase );
+  CPPUNIT_TEST( test_filter );
+  CPPUNIT_TEST( test_incident );
+  CPPUNIT_TEST( test_equiv );
+  CPPUNIT_TEST( test_harmonic );
+  CPPUNIT_TEST( test_conic );
+  CPPUNIT_TEST_SUITE_END();
+
+protected:
+  /** Test the error bound of fp_bound */
+  void test_filter();
+
+  /** Test incidence, including the exact fallback */
+  void test_incident();
+
+  /** Test projective equality of points and lines */
+  void test_equiv();
+
+  /** Test harmonic pencils */
+  void test_harmonic();
+
+  /** Test six points on a conic */
+  void test_conic();
+};
+
+/** @} */
+
+#endif
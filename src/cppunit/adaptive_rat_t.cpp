@@ -0,0 +1,58 @@
+#include "adaptive_rat_t.hpp"
+#include <adaptive_rat.hpp>
+#include <cstdint>
+#include <limits>
+
+using boost::adaptive_rat;
+
+CPPUNIT_TEST_SUITE_REGISTRATION( adaptive_rat_TestCase );
+
+static const std::int64_t M = std::numeric_limits<std::int64_t>::max();
+
+void adaptive_rat_TestCase::test_small()
+{
+  adaptive_rat a(1, 3), b(2, 5);
+  CPPUNIT_ASSERT( a + b == adaptive_rat(11, 15) );
+  CPPUNIT_ASSERT( a - b == adaptive_rat(-1, 15) );
+  CPPUNIT_ASSERT( a * b == adaptive_rat(2, 15) );
+  CPPUNIT_ASSERT( a / b == adaptive_rat(5, 6) );
+  CPPUNIT_ASSERT( (a + b).tier() == adaptive_rat::small_tier );
+}
+
+void adaptive_rat_TestCase::test_promote()
+{
+  adaptive_rat a(M);
+  a += adaptive_rat(1);
+  CPPUNIT_ASSERT( a.tier() == adaptive_rat::wide_tier );
+  CPPUNIT_ASSERT( a.numerator() == adaptive_rat::big_int(M) + 1 );
+
+  adaptive_rat b(M, 3);
+  b *= b;
+  b *= b;
+  CPPUNIT_ASSERT( b.tier() == adaptive_rat::big_tier );
+  CPPUNIT_ASSERT( b.denominator() == 81 );
+
+  adaptive_rat c(std::numeric_limits<std::int64_t>::min());
+  CPPUNIT_ASSERT( -c == a );
+}
+
+void adaptive_rat_TestCase::test_demote()
+{
+  adaptive_rat a(M, 7);
+  adaptive_rat b = a * a * a;
+  CPPUNIT_ASSERT( b.tier() == adaptive_rat::big_tier );
+  b /= a * a;
+  CPPUNIT_ASSERT( b.tier() == adaptive_rat::small_tier );
+  CPPUNIT_ASSERT( b == a );
+  b -= a;
+  CPPUNIT_ASSERT( b == adaptive_rat(0) );
+}
+
+void adaptive_rat_TestCase::test_compare()
+{
+  adaptive_rat a(M, M - 1), b(M - 1, M - 2);
+  CPPUNIT_ASSERT( a < b );
+  CPPUNIT_ASSERT( !(b < a) );
+  CPPUNIT_ASSERT( a != b );
+  CPPUNIT_ASSERT( a > adaptive_rat(1) );
+}
@@ -0,0 +1,36 @@
+#ifndef CPPUNIT_ADAPTIVE_RAT_T_HPP
+#define CPPUNIT_ADAPTIVE_RAT_T_HPP 1
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <adaptive_rat.hpp>
+
+/**
+ * A test case for adaptive_rat
+ */
+class adaptive_rat_TestCase : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE( adaptive_rat_TestCase );
+  CPPUNIT_TEST( test_small );
+  CPPUNIT_TEST( test_promote );
+  CPPUNIT_TEST( test_demote );
+  CPPUNIT_TEST( test_compare );
+  CPPUNIT_TEST_SUITE_END();
+
+protected:
+  /** Test arithmetic in the int64 tier */
+  void test_small();
+
+  /** Test promotion on overflow */
+  void test_promote();
+
+  /** Test demotion after cancellation */
+  void test_demote();
+
+  /** Test comparison of values with overflowing cross products */
+  void test_compare();
+};
+
+/** @} */
+
+#endif
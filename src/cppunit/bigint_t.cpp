@@ -0,0 +1,76 @@
+#include "bigint_t.hpp"
+#include <bigint.hpp>
+#include <rat.hpp>
+#include <rational.hpp>
+#include <vector3.hpp>
+
+using namespace fun;
+
+CPPUNIT_TEST_SUITE_REGISTRATION( bigint_TestCase );
+
+void bigint_TestCase::test_arith()
+{
+  bigint a("123456789012345678901234567890"), b(-987654321);
+  CPPUNIT_ASSERT( (a + b).to_string() == "123456789012345678900246913569" );
+  CPPUNIT_ASSERT( (b - a).to_string() == "-123456789012345678902222222211" );
+  CPPUNIT_ASSERT( (a * b).to_string() ==
+                  "-121932631124828532112482853211126352690" );
+  CPPUNIT_ASSERT( (a * a - a * a) == 0 );
+  CPPUNIT_ASSERT( (bigint(1) << 130) >> 129 == 2 );
+  CPPUNIT_ASSERT( bit_length(bigint(1) << 130) == 131 );
+  CPPUNIT_ASSERT( b < 0 && b < a && -a < b );
+}
+
+void bigint_TestCase::test_divide()
+{
+  bigint a("123456789012345678901234567890123456789");
+  bigint b("98765432109876543210");
+  CPPUNIT_ASSERT( (a / b).to_string() == "1249999988609375000" );
+  CPPUNIT_ASSERT( (a % b).to_string() == "15297067891529706789" );
+  CPPUNIT_ASSERT( (-a / b) == -(a / b) && (-a % b) == -(a % b) );
+  CPPUNIT_ASSERT( (a / b) * b + a % b == a );
+  CPPUNIT_ASSERT( bigint(-7) / 2 == -3 && bigint(-7) % 2 == -1 );
+  CPPUNIT_ASSERT( fast_gcd(a * 6, b * 4) == fast_gcd(a, b) * 2 );
+}
+
+void bigint_TestCase::test_shift()
+{
+  for (long long v = -300; v <= 300; ++v)
+    for (int k = 0; k != 12; ++k)
+      CPPUNIT_ASSERT( (bigint(v) >> k) == (v >> k) );
+  CPPUNIT_ASSERT( (bigint(-3) >> 1) == -2 && (bigint(-1) >> 200) == -1 );
+  const bigint a = -(bigint(1) << 130);
+  CPPUNIT_ASSERT( (a >> 130) == -1 && (a >> 131) == -1 );
+  CPPUNIT_ASSERT( ((a - 1) >> 64) == -(bigint(1) << 66) - 1 );
+  CPPUNIT_ASSERT( ((a + 1) >> 64) == -(bigint(1) << 66) );
+}
+
+void bigint_TestCase::test_inline()
+{
+  bigint a(3000000000LL), b(-5);
+  bigint c = a * a * b + a;
+  CPPUNIT_ASSERT( c.is_inline() && c.size() == 2 );
+  c *= a * a;
+  CPPUNIT_ASSERT( !c.is_inline() && c.size() == 3 );
+  CPPUNIT_ASSERT( c / (a * a) == a * a * b + a );
+}
+
+void bigint_TestCase::test_rational()
+{
+  boost::rat<bigint> a(bigint(6), bigint(-8));
+  CPPUNIT_ASSERT( a.num() == -3 && a.denom() == 4 );
+  rational<bigint> p(bigint(1) << 100, bigint(3)), q(bigint(1), bigint(3));
+  CPPUNIT_ASSERT( (p * q).num() == (bigint(1) << 100) &&
+                  (p * q).denom() == 9 );
+  CPPUNIT_ASSERT( q < p && p - p == 0 );
+}
+
+void bigint_TestCase::test_vector3()
+{
+  const bigint M(1LL << 62);
+  vector3<bigint> u(M, 3, -M), v(-M, M, 5), w(7, M, M);
+  // det(u, u, v) vanishes even though the terms are 2^186
+  CPPUNIT_ASSERT( det(u, u, v) == 0 );
+  CPPUNIT_ASSERT( dot(cross(u, v), u) == 0 && dot(cross(u, v), v) == 0 );
+  CPPUNIT_ASSERT( det(u, v, w) == -det(v, u, w) );
+}
@@ -0,0 +1,44 @@
+#ifndef CPPUNIT_BIGINT_T_HPP
+#define CPPUNIT_BIGINT_T_HPP 1
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <bigint.hpp>
+
+/**
+ * A test case for bigint
+ */
+class bigint_TestCase : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE( bigint_TestCase );
+  CPPUNIT_TEST( test_arith );
+  CPPUNIT_TEST( test_divide );
+  CPPUNIT_TEST( test_shift );
+  CPPUNIT_TEST( test_inline );
+  CPPUNIT_TEST( test_rational );
+  CPPUNIT_TEST( test_vector3 );
+  CPPUNIT_TEST_SUITE_END();
+
+protected:
+  /** Test addition, subtraction, multiplication and shifts */
+  void test_arith();
+
+  /** Test truncating division and remainder */
+  void test_divide();
+
+  /** Test that right shifts round toward negative infinity */
+  void test_shift();
+
+  /** Test that small values stay in the inline buffer */
+  void test_inline();
+
+  /** Test bigint as the integer type of rat and rational */
+  void test_rational();
+
+  /** Test bigint as the element type of vector3 */
+  void test_vector3();
+};
+
+/** @} */
+
+#endif
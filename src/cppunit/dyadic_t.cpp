@@ -0,0 +1,130 @@
+#include "dyadic_t.hpp"
+#include "test_random.hpp"
+#include <bigint.hpp>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <rat.hpp>
+
+using boost::dyadic;
+using boost::rat;
+using fun::bigint;
+
+CPPUNIT_TEST_SUITE_REGISTRATION( dyadic_TestCase );
+
+void dyadic_TestCase::test_normalize()
+{
+  dyadic<long long> a(12), b(-40, -3), c(0, 7);
+  CPPUNIT_ASSERT( a.mantissa() == 3 && a.exponent() == 2 );
+  CPPUNIT_ASSERT( b.mantissa() == -5 && b.exponent() == 0 );
+  CPPUNIT_ASSERT( c.mantissa() == 0 && c.exponent() == 0 );
+  CPPUNIT_ASSERT( dyadic<long long>(3, 2) == 12 );
+}
+
+void dyadic_TestCase::test_double()
+{
+  dyadic<long long> a(0.375), b(-1e-300), c(0.1);
+  CPPUNIT_ASSERT( a.mantissa() == 3 && a.exponent() == -3 );
+  CPPUNIT_ASSERT( double(b) == -1e-300 );
+  CPPUNIT_ASSERT( double(c) == 0.1 );
+  CPPUNIT_ASSERT( double(dyadic<long long>(1e300)) == 1e300 );
+}
+
+void dyadic_TestCase::test_arith()
+{
+  dyadic<long long> a(0.375), b(1.25);
+  CPPUNIT_ASSERT( a + b == dyadic<long long>(1.625) );
+  CPPUNIT_ASSERT( a - b == dyadic<long long>(-0.875) );
+  CPPUNIT_ASSERT( a * b == dyadic<long long>(0.46875) );
+  CPPUNIT_ASSERT( (a + a).mantissa() == 3 && (a + a).exponent() == -2 );
+  CPPUNIT_ASSERT( a - a == 0 );
+  CPPUNIT_ASSERT( ldexp(a, 3) == 3 );
+}
+
+void dyadic_TestCase::test_align()
+{
+  typedef dyadic<long long> D;
+  const D s = D(0.1) + D(1000.0); // exponents 58 apart
+  CPPUNIT_ASSERT( std::abs(double(s) - 1000.1) <= 1e-12 );
+  CPPUNIT_ASSERT( D(1000.0) + D(0.1) == s );
+  CPPUNIT_ASSERT( std::abs(double(D(1000.0) - D(0.1)) - 999.9) <= 1e-12 );
+
+  // more than 63 bits apart: the small operand rounds away
+  CPPUNIT_ASSERT( D(1, 100) + D(1) == D(1, 100) );
+  CPPUNIT_ASSERT( D(3) + D(1, -70) == D(3) );
+  CPPUNIT_ASSERT( D(-5, -200) + D(7, 40) == D(7, 40) );
+  const D t = D(1, 61) + D(3, -2); // one bit short of exact
+  CPPUNIT_ASSERT( double(t) == std::ldexp(1., 61) + 1. );
+
+  // operands that fit but whose aligned sum does not
+  const long long M = std::numeric_limits<long long>::max();
+  const D v = D((1LL << 60) + 1, 1) + D(M, 0);
+  CPPUNIT_ASSERT( std::abs(double(v) / (std::ldexp(1., 61) + 2. + double(M)) -
+                           1.) <= 1e-15 );
+  CPPUNIT_ASSERT( D(M) + D(M) == D(M, 1) && D(-M) - D(M) == D(-M, 1) );
+  CPPUNIT_ASSERT( D(M) - D(M - 1) == 1 );
+  D w(M, 3);
+  w += w; // aliased, and the sum overflows
+  CPPUNIT_ASSERT( w == D(M, 4) );
+
+  // unbounded mantissas stay exact
+  typedef dyadic<bigint> B;
+  const B u = B(bigint(1), 100) + B(bigint(1));
+  CPPUNIT_ASSERT( u.mantissa() == (bigint(1) << 100) + bigint(1) );
+  CPPUNIT_ASSERT( u.exponent() == 0 );
+}
+
+void dyadic_TestCase::test_product()
+{
+  typedef dyadic<long long> D;
+  const long long M = std::numeric_limits<long long>::max();
+  const D a(3037000501LL); // a * a > M
+  CPPUNIT_ASSERT( std::abs(double(a * a) / (double(a) * double(a)) - 1.) <=
+                  1e-15 );
+  CPPUNIT_ASSERT( (a * a) * D(-1) == -(a * a) );
+  CPPUNIT_ASSERT( D(M) * D(M) == D(M - 1, 63) ); // M^2 = (M-1) 2^63 + 1
+  CPPUNIT_ASSERT( D(M, 3) * 4 == D(M, 5) && D(1, -70) * D(1, 70) == 1 );
+
+  // the product is the exact one rounded to nearest
+  std::uint64_t seed = 5;
+  for (int i = 0; i != 1000; ++i) {
+    long long m[2];
+    for (long long &x : m) {
+      const std::uint64_t u = random_word(seed);
+      x = (long long)((u >> (u % 64)) | 1) * (u & 2 ? -1 : 1);
+    }
+    const D a(m[0], -3), b(m[1], 5), p = a * b;
+    const bigint x = bigint(a.mantissa()) * bigint(b.mantissa());
+    const int k = p.exponent() - (a.exponent() + b.exponent());
+    CPPUNIT_ASSERT( k >= 0 );
+    const bigint diff = x - (bigint(p.mantissa()) << k);
+    CPPUNIT_ASSERT( (diff < 0 ? -diff : diff) << 1 <= bigint(1) << k );
+  }
+}
+
+void dyadic_TestCase::test_compare()
+{
+  const long long M = std::numeric_limits<long long>::max();
+  dyadic<long long> a(M, 10), b(M - 2, 10), c(1, 73);
+  CPPUNIT_ASSERT( b < a && !(a < b) );
+  CPPUNIT_ASSERT( a < c && -c < -a && c < dyadic<long long>(1, 74) );
+  CPPUNIT_ASSERT( dyadic<long long>(-3, -1) < dyadic<long long>(-1, 0) );
+  CPPUNIT_ASSERT( dyadic<long long>(0.5) > 0 && dyadic<long long>(0.5) < 1 );
+}
+
+void dyadic_TestCase::test_mixed()
+{
+  dyadic<long long> a(0.75), b(1.5);
+  rat<long long> q = a / b;
+  CPPUNIT_ASSERT( q == rat<long long>(1, 2) );
+  CPPUNIT_ASSERT( b / a == 2 );
+  CPPUNIT_ASSERT( rat<long long>(1, 3) + a == rat<long long>(13, 12) );
+  CPPUNIT_ASSERT( a * rat<long long>(4, 3) == 1 );
+  CPPUNIT_ASSERT( rat<long long>(1, 3) < a && a == rat<long long>(3, 4) );
+
+  // quadrance of (0.5, 0.25, 1) and (1.5, -0.75, 1) stays exact
+  dyadic<long long> dx = dyadic<long long>(0.5) - dyadic<long long>(1.5);
+  dyadic<long long> dy = dyadic<long long>(0.25) - dyadic<long long>(-0.75);
+  CPPUNIT_ASSERT( dx * dx + dy * dy == 2 );
+  CPPUNIT_ASSERT( (dx * dx) / (dy * dy + dy * dy) == rat<long long>(1, 2) );
+}
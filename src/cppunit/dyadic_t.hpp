@@ -0,0 +1,48 @@
+#ifndef CPPUNIT_DYADIC_T_HPP
+#define CPPUNIT_DYADIC_T_HPP 1
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <rat.hpp>
+
+/**
+ * A test case for dyadic
+ */
+class dyadic_TestCase : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE( dyadic_TestCase );
+  CPPUNIT_TEST( test_normalize );
+  CPPUNIT_TEST( test_double );
+  CPPUNIT_TEST( test_arith );
+  CPPUNIT_TEST( test_align );
+  CPPUNIT_TEST( test_product );
+  CPPUNIT_TEST( test_compare );
+  CPPUNIT_TEST( test_mixed );
+  CPPUNIT_TEST_SUITE_END();
+
+protected:
+  /** Test shift-based normalization */
+  void test_normalize();
+
+  /** Test exact conversion from double */
+  void test_double();
+
+  /** Test addition, subtraction and multiplication */
+  void test_arith();
+
+  /** Test additions whose alignment overflows the mantissa */
+  void test_align();
+
+  /** Test products that overflow the mantissa */
+  void test_product();
+
+  /** Test comparison */
+  void test_compare();
+
+  /** Test division and mixed operations with rat */
+  void test_mixed();
+};
+
+/** @} */
+
+#endif
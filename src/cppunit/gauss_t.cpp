@@ -0,0 +1,151 @@
+#include "gauss_t.hpp"
+#include <GF.hpp>
+#include <gauss.hpp>
+#include <line3.hpp>
+#include <point3.hpp>
+#include <rat.hpp>
+#include <vector>
+
+using namespace fun;
+
+CPPUNIT_TEST_SUITE_REGISTRATION( gauss_TestCase );
+
+namespace {
+
+/// Return the incidence matrix of the points and lines of PG(2, p)
+template <std::uint64_t _p> dense_matrix<GF<_p>> incidence_matrix()
+{
+  typedef GF<_p> F;
+  std::vector<point3<F>> pts;
+  pts.emplace_back(F(1U), F(0U), F(0U));
+  for (unsigned x = 0; x != _p; ++x) {
+    pts.emplace_back(F(x), F(1U), F(0U));
+    for (unsigned y = 0; y != _p; ++y)
+      pts.emplace_back(F(x), F(y), F(1U));
+  }
+  dense_matrix<F> A(pts.size(), pts.size());
+  for (std::size_t i = 0; i != pts.size(); ++i) {
+    const line3<F> l(pts[i].x(), pts[i].y(), pts[i].z()); // duality
+    for (std::size_t j = 0; j != pts.size(); ++j)
+      A(i, j) = l.incident(pts[j]) ? F(1U) : F(0U);
+  }
+  return A;
+}
+
+} // namespace
+
+void gauss_TestCase::test_field()
+{
+  typedef GF<7> F;
+  const unsigned a[3][4] = {{1, 2, 3, 4}, {2, 4, 6, 2}, {3, 6, 2, 5}};
+  dense_matrix<F> A(3, 4);
+  for (std::size_t i = 0; i != 3; ++i)
+    for (std::size_t j = 0; j != 4; ++j)
+      A(i, j) = F(a[i][j]);
+  dense_matrix<F> R = A;
+  const std::vector<std::size_t> piv = rref(R);
+  CPPUNIT_ASSERT( piv == std::vector<std::size_t>({0, 3}) );
+  CPPUNIT_ASSERT( R(0, 0) == F(1U) && R(0, 1) == F(2U) && R(0, 2) == F(3U) );
+  CPPUNIT_ASSERT( R(0, 3) == F() && R(1, 3) == F(1U) && R(2, 3) == F() );
+  CPPUNIT_ASSERT( rank(A) == 2 );
+
+  const dense_matrix<F> N = nullspace(A);
+  CPPUNIT_ASSERT( N.rows() == 2 );
+  for (std::size_t f = 0; f != N.rows(); ++f)
+    for (std::size_t i = 0; i != 3; ++i) {
+      F s;
+      for (std::size_t j = 0; j != 4; ++j)
+        s += A(i, j) * N(f, j);
+      CPPUNIT_ASSERT( s == F() );
+    }
+
+  std::vector<F> x;
+  CPPUNIT_ASSERT( solve(A, {F(5U), F(4U), F(1U)}, x) );
+  CPPUNIT_ASSERT( x[0] == F(1U) && x[3] == F(1U) );
+  CPPUNIT_ASSERT( !solve(A, {F(5U), F(4U), F(2U)}, x) );
+}
+
+void gauss_TestCase::test_rat()
+{
+  typedef boost::rat<long long> Q;
+  dense_matrix<Q> A(3, 3);
+  const int a[3][3] = {{2, 1, 1}, {1, 3, 2}, {1, 0, 0}};
+  for (std::size_t i = 0; i != 3; ++i)
+    for (std::size_t j = 0; j != 3; ++j)
+      A(i, j) = Q(a[i][j]);
+  std::vector<Q> x;
+  CPPUNIT_ASSERT( solve(A, {Q(4), Q(5), Q(6)}, x) );
+  CPPUNIT_ASSERT( x[0] == Q(6) && x[1] == Q(15) && x[2] == Q(-23) );
+  CPPUNIT_ASSERT( nullspace(A).rows() == 0 );
+}
+
+void gauss_TestCase::test_bareiss()
+{
+  dense_matrix<long long> A(3, 3);
+  const int a[3][3] = {{2, 3, 1}, {4, 1, -3}, {-2, 5, 7}};
+  for (std::size_t i = 0; i != 3; ++i)
+    for (std::size_t j = 0; j != 3; ++j)
+      A(i, j) = a[i][j];
+  CPPUNIT_ASSERT( rank(A) == 2 ); // 5 row 3 = 11 row 1 - 8 row 2
+
+  dense_matrix<long long> R = A;
+  const std::vector<std::size_t> piv = bareiss(R);
+  CPPUNIT_ASSERT( piv == std::vector<std::size_t>({0, 1}) );
+  CPPUNIT_ASSERT( R(0, 0) == -10 && R(1, 1) == -10 ); // D = det [2 3; 4 1]
+  CPPUNIT_ASSERT( R(0, 2) == 10 && R(1, 2) == -10 && R(2, 2) == 0 );
+
+  const dense_matrix<long long> N = nullspace(A);
+  CPPUNIT_ASSERT( N.rows() == 1 );
+  CPPUNIT_ASSERT( N(0, 0) == -10 && N(0, 1) == 10 && N(0, 2) == -10 );
+
+  std::vector<long long> x;
+  long long d;
+  CPPUNIT_ASSERT( solve(A, {1, 2, -1}, x, d) );
+  for (std::size_t i = 0; i != 3; ++i)
+    CPPUNIT_ASSERT( A(i, 0) * x[0] + A(i, 1) * x[1] + A(i, 2) * x[2] ==
+                    d * std::vector<long long>({1, 2, -1})[i] );
+  CPPUNIT_ASSERT( !solve(A, {1, 2, 0}, x, d) );
+}
+
+void gauss_TestCase::test_gf2()
+{
+  const std::size_t n = 300;
+  gf2_matrix A(n, n + 5);
+  unsigned s = 1;
+  for (std::size_t i = 0; i != n; ++i)
+    for (std::size_t j = 0; j != n + 5; ++j) {
+      s = s * 1103515245U + 12345U;
+      A.set(i, j, i < 200 ? (s >> 16) & 1U : A(i - 200, j) != A(i - 199, j));
+    }
+  gf2_matrix R = A, T = A;
+  const std::vector<std::size_t> p1 = rref(R), p4 = rref(T, 4);
+  CPPUNIT_ASSERT( p1 == p4 && p1.size() == 200 );
+  for (std::size_t i = 0; i != n; ++i)
+    for (std::size_t j = 0; j != n + 5; ++j)
+      CPPUNIT_ASSERT( R(i, j) == T(i, j) );
+  for (std::size_t t = 0; t != p1.size(); ++t)
+    for (std::size_t i = 0; i != n; ++i)
+      CPPUNIT_ASSERT( R(i, p1[t]) == (i == t) );
+
+  const gf2_matrix N = nullspace(A, 2);
+  CPPUNIT_ASSERT( N.rows() == n + 5 - 200 );
+  std::vector<bool> x, b(n);
+  for (std::size_t i = 0; i != n; ++i)
+    b[i] = A(i, 0) != A(i, 7);
+  CPPUNIT_ASSERT( solve(A, b, x) );
+  for (std::size_t i = 0; i != n; ++i) {
+    bool y = false;
+    for (std::size_t j = 0; j != n + 5; ++j)
+      y = y != (A(i, j) && x[j]);
+    CPPUNIT_ASSERT( y == b[i] );
+  }
+}
+
+void gauss_TestCase::test_incidence()
+{
+  // The p-rank of PG(2, p) is p(p + 1) / 2 + 1
+  CPPUNIT_ASSERT( rank(incidence_matrix<2>()) == 4 );
+  CPPUNIT_ASSERT( rank(incidence_matrix<3>()) == 7 );
+  CPPUNIT_ASSERT( rank(incidence_matrix<7>(), 2) == 29 );
+  CPPUNIT_ASSERT( rank(incidence_matrix<11>(), 3) == 67 );
+}
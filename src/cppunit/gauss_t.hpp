@@ -0,0 +1,40 @@
+#ifndef CPPUNIT_GAUSS_T_HPP
+#define CPPUNIT_GAUSS_T_HPP 1
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <gauss.hpp>
+
+/**
+ * A test case for the Gaussian elimination engine
+ */
+class gauss_TestCase : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE( gauss_TestCase );
+  CPPUNIT_TEST( test_field );
+  CPPUNIT_TEST( test_rat );
+  CPPUNIT_TEST( test_bareiss );
+  CPPUNIT_TEST( test_gf2 );
+  CPPUNIT_TEST( test_incidence );
+  CPPUNIT_TEST_SUITE_END();
+
+protected:
+  /** Test rref, rank, nullspace and solve over GF(p) */
+  void test_field();
+
+  /** Test solve over the rationals */
+  void test_rat();
+
+  /** Test the fraction-free elimination over the integers */
+  void test_bareiss();
+
+  /** Test M4RI over GF(2), with threads */
+  void test_gf2();
+
+  /** Test the p-rank of the incidence matrices of PG(2, p) */
+  void test_incidence();
+};
+
+/** @} */
+
+#endif
@@ -0,0 +1,51 @@
+#include "gcd_t.hpp"
+#include <gcd.hpp>
+#include <random>
+
+using namespace fun;
+
+CPPUNIT_TEST_SUITE_REGISTRATION( gcd_TestCase );
+
+template <typename _Z>
+static _Z euclid(_Z a, _Z b)
+{
+  while (b != 0) { _Z r = a % b; a = b; b = r; }
+  return a;
+}
+
+void gcd_TestCase::test_binary()
+{
+  CPPUNIT_ASSERT( binary_gcd(0u, 0u) == 0u );
+  CPPUNIT_ASSERT( binary_gcd(0u, 7u) == 7u );
+  CPPUNIT_ASSERT( binary_gcd(12u, 18u) == 6u );
+  CPPUNIT_ASSERT( binary_gcd(1024u, 96u) == 32u );
+
+  std::mt19937_64 gen(1);
+  for (int k = 0; k != 1000; ++k) {
+    std::uint64_t a = gen() >> (k % 40), b = gen() >> (k % 23);
+    CPPUNIT_ASSERT( binary_gcd(a, b) == euclid(a, b) );
+  }
+}
+
+void gcd_TestCase::test_signed()
+{
+  CPPUNIT_ASSERT( fast_gcd(-12, 18) == 6 );
+  CPPUNIT_ASSERT( fast_gcd(12, -18) == 6 );
+  CPPUNIT_ASSERT( fast_gcd(-12LL, -18LL) == 6LL );
+  CPPUNIT_ASSERT( fast_gcd(0L, -5L) == 5L );
+}
+
+void gcd_TestCase::test_lehmer()
+{
+#ifdef FUN_HAS_INT128
+  std::mt19937_64 gen(2);
+  for (int k = 0; k != 1000; ++k) {
+    uint128_t g = gen() >> (k % 50);
+    uint128_t a = ((uint128_t(gen()) << 32) | gen() % 7) * (g | 1);
+    uint128_t b = (uint128_t(gen() >> (k % 30)) << 20) * (g | 1);
+    CPPUNIT_ASSERT( lehmer_gcd(a, b) == euclid(a, b) );
+  }
+  const int128_t x = int128_t(1) << 100, y = -(int128_t(3) << 90);
+  CPPUNIT_ASSERT( fast_gcd(x, y) == (int128_t(1) << 90) );
+#endif
+}
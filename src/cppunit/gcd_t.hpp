@@ -0,0 +1,32 @@
+#ifndef CPPUNIT_GCD_T_HPP
+#define CPPUNIT_GCD_T_HPP 1
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <gcd.hpp>
+
+/**
+ * A test case for gcd
+ */
+class gcd_TestCase : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE( gcd_TestCase );
+  CPPUNIT_TEST( test_binary );
+  CPPUNIT_TEST( test_signed );
+  CPPUNIT_TEST( test_lehmer );
+  CPPUNIT_TEST_SUITE_END();
+
+protected:
+  /** Test binary gcd against Euclid */
+  void test_binary();
+
+  /** Test sign handling */
+  void test_signed();
+
+  /** Test Lehmer gcd on 128-bit integers */
+  void test_lehmer();
+};
+
+/** @} */
+
+#endif
@@ -0,0 +1,143 @@
+#include "lin_expr_t.hpp"
+#include <bigint.hpp>
+#include <line3.hpp>
+#include <matrix3.hpp>
+#include <matrix3d.hpp>
+#include <point3.hpp>
+#include <rat.hpp>
+#include <type_traits>
+
+using namespace fun;
+
+CPPUNIT_TEST_SUITE_REGISTRATION( lin_expr_TestCase );
+
+namespace {
+
+typedef boost::rat<bigint> Rat;
+
+/// Return true if @a T is a lin_expr
+template <class _T> struct is_lin_expr : std::false_type {};
+
+template <class _Op, class... _Args>
+struct is_lin_expr<lin_expr<_Op, _Args...>> : std::true_type {};
+
+constexpr vector3<int> cv = vector3<int>(1, 2, 3) * 2 - vector3<int>(0, 1, 1);
+
+static_assert(cv == vector3<int>(2, 3, 5), "lazy expressions are constexpr");
+
+} // namespace
+
+void lin_expr_TestCase::test_lazy()
+{
+  const vector3<int> v(1, 2, 3), w(4, 5, 6);
+  auto e = v + w * 2 - -v;
+  CPPUNIT_ASSERT( is_lin_expr<decltype(e)>::value );
+  CPPUNIT_ASSERT( (e.at(0) == 10 && e.at(2) == 18) );
+
+  vector3<int> r = e;
+  CPPUNIT_ASSERT( (r == vector3<int>(10, 14, 18)) );
+  CPPUNIT_ASSERT( (e == vector3<int>(10, 14, 18)) );
+  CPPUNIT_ASSERT( (+v - v / 1 == vector3<int>(0, 0, 0)) );
+
+  // temporaries are held by value, so the expression outlives them
+  auto u = vector3<int>(1, 1, 1) + vector3<int>(2, 2, 2);
+  CPPUNIT_ASSERT( (vector3<int>(u) == vector3<int>(3, 3, 3)) );
+
+  const matrix3<int> A(1, 2, 3, 4, 5, 6, 7, 8, 9);
+  matrix3<int> B = 2 * A - A.transpose();
+  CPPUNIT_ASSERT( (B == matrix3<int>(1, 0, -1, 6, 5, 4, 11, 10, 9)) );
+  B += A;
+  B -= A * 1;
+  CPPUNIT_ASSERT( (B == 2 * A - transpose(A)) );
+
+  const matrix3d<int> D(1, 2, 3, 4, 5, 6, 7, 8, 9);
+  matrix3d<int> E = D + D;
+  CPPUNIT_ASSERT( (E == matrix3d<int>(2, 4, 6, 8, 10, 12, 14, 16, 18)) );
+  CPPUNIT_ASSERT( (E - D == D) );
+}
+
+void lin_expr_TestCase::test_alias()
+{
+  vector3<int> v(1, 2, 3);
+  const vector3<int> w(4, 5, 6);
+  v = w - v * 2;
+  CPPUNIT_ASSERT( (v == vector3<int>(2, 1, 0)) );
+  v += v + w;
+  CPPUNIT_ASSERT( (v == vector3<int>(8, 7, 6)) );
+  v -= v - w;
+  CPPUNIT_ASSERT( v == w );
+
+  matrix3<int> A(1, 2, 3, 4, 5, 6, 7, 8, 9);
+  A = A * 3 - A;
+  CPPUNIT_ASSERT( (A == matrix3<int>(2, 4, 6, 8, 10, 12, 14, 16, 18)) );
+}
+
+void lin_expr_TestCase::test_mixed()
+{
+  const vector3<int> v(1, 2, 3);
+  const vector3<double> w(0.5, 0.25, 0.125);
+  const vector3<double> r = v + w;
+  CPPUNIT_ASSERT( (r == vector3<double>(1.5, 2.25, 3.125)) );
+  CPPUNIT_ASSERT( (v * 0.5 == vector3<double>(0.5, 1.0, 1.5)) );
+  CPPUNIT_ASSERT( (v / 2.0 == vector3<double>(0.5, 1.0, 1.5)) );
+  CPPUNIT_ASSERT( (std::is_same<decltype((v - w).eval()),
+                                vector3<double>>::value) );
+
+  // points and lines are vectors
+  const point3<int> p(1, 2, 1);
+  const line3<int> l(1, -1, 1);
+  const vector3<int> s = p + l;
+  CPPUNIT_ASSERT( (s == vector3<int>(2, 1, 2)) );
+  CPPUNIT_ASSERT( (p == p * 1) );
+}
+
+void lin_expr_TestCase::test_products()
+{
+  const vector3<int> u(1, 0, 2), v(3, -1, 2), w(0, 4, -2);
+  const vector3<int> s = u + v;
+  CPPUNIT_ASSERT( dot(u + v, w) == dot(s, w) );
+  CPPUNIT_ASSERT( dot(w, u + v) == dot(s, w) );
+  CPPUNIT_ASSERT( quadrance(u + v) == quadrance(s) );
+  CPPUNIT_ASSERT( (cross(u + v, w) == cross(s, w)) );
+  CPPUNIT_ASSERT( (cross(w, u + v) == cross(w, s)) );
+  CPPUNIT_ASSERT( det(u + v, v, w) == det(s, v, w) );
+  CPPUNIT_ASSERT( det(u, v, w * 2) == 2 * det(u, v, w) );
+
+  const matrix3<int> A(2, 4, -4, 3, 4, 6, 1, 3, -1);
+  const matrix3<int> B(1, 2, 3, 2, -2, 0, 6, 3, -2);
+  const matrix3<int> C = A + B;
+  CPPUNIT_ASSERT( (A * (A + B) == A * A + A * B) );
+  CPPUNIT_ASSERT( ((A + B) * A == C * A) );
+  CPPUNIT_ASSERT( ((A + B) * v == C * v) );
+  CPPUNIT_ASSERT( (A * (u + v) == A * s) );
+  CPPUNIT_ASSERT( det(A + B) == C.det() );
+  CPPUNIT_ASSERT( (transpose(A + B) == C.transpose()) );
+
+  const matrix3d<int> D(2, 4, -4, 3, 4, 6, 1, 3, -1);
+  const vector3d<int> x(1, 2, 3);
+  CPPUNIT_ASSERT( (D * x + D * x == (D + D) * x) );
+  CPPUNIT_ASSERT( det(D + D) == 8 * D.det() );
+}
+
+void lin_expr_TestCase::test_conic()
+{
+  // the five-point conic of src/proj_geom/conic.cpp, over big rationals
+  const point3<Rat> p1(Rat(1), Rat(0), Rat(1)), p2(Rat(0), Rat(1), Rat(1)),
+      p3(Rat(-1), Rat(0), Rat(1)), p4(Rat(0), Rat(-1), Rat(1)),
+      p5(Rat(3, 5), Rat(4, 5), Rat(1));
+  const line3<Rat> g1 = cross(p1, p3), g2 = cross(p2, p4);
+  const line3<Rat> h1 = cross(p1, p4), h2 = cross(p2, p3);
+  const matrix3<Rat> G(g1, g2), H(h1, h2);
+  const vector3<Rat> q = p5;
+  const matrix3<Rat> M =
+      (dot(q, h1) * dot(h2, q)) * G - (dot(q, g1) * dot(g2, q)) * H;
+  const matrix3<Rat> S = M + M.transpose();
+
+  // the unit circle through the five points
+  const Rat k = S(0, 0);
+  CPPUNIT_ASSERT( k != Rat(0) );
+  CPPUNIT_ASSERT( (S == matrix3<Rat>(k, Rat(0), Rat(0), Rat(0), k, Rat(0),
+                                     Rat(0), Rat(0), -k)) );
+  for (const point3<Rat> &p : {p1, p2, p3, p4, p5})
+    CPPUNIT_ASSERT( dot(p, S * p) == Rat(0) );
+}
@@ -0,0 +1,40 @@
+#ifndef CPPUNIT_LIN_EXPR_T_HPP
+#define CPPUNIT_LIN_EXPR_T_HPP 1
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <lin_expr.hpp>
+
+/**
+ * A test case for the lazy vector and matrix expressions
+ */
+class lin_expr_TestCase : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE( lin_expr_TestCase );
+  CPPUNIT_TEST( test_lazy );
+  CPPUNIT_TEST( test_alias );
+  CPPUNIT_TEST( test_mixed );
+  CPPUNIT_TEST( test_products );
+  CPPUNIT_TEST( test_conic );
+  CPPUNIT_TEST_SUITE_END();
+
+protected:
+  /** Test that expressions are evaluated on assignment only */
+  void test_lazy();
+
+  /** Test assignments whose target also appears on the right */
+  void test_alias();
+
+  /** Test expressions of mixed element types */
+  void test_mixed();
+
+  /** Test dot, cross, det and the matrix products of expressions */
+  void test_products();
+
+  /** Test the five-point conic expression over big rationals */
+  void test_conic();
+};
+
+/** @} */
+
+#endif
@@ -1,5 +1,11 @@
 #include "matrix3_t.hpp"
+#include <GF.hpp>
+#include <bigint.hpp>
+#include <cstdint>
 #include <matrix3.hpp>
+#include <matrix3d.hpp>
+#include <rat.hpp>
+#include <vector>
 
 using namespace fun;
 
@@ -91,3 +97,84 @@ void matrix3_TestCase::test_adjoint()
   CPPUNIT_ASSERT( R.a() == _A0->det());
   CPPUNIT_ASSERT( R.b() ==  0);
 }
+
+void matrix3_TestCase::test_inverse_exact()
+{
+  typedef std::int64_t Z;
+  const matrix3<Z> A(*_A0);
+  const auto r = inverse_exact(A);
+  CPPUNIT_ASSERT( r.first == A.adj() && r.second == A.det() );
+  CPPUNIT_ASSERT( r.first * A == matrix3<Z>(r.second, 0, 0, 0, r.second, 0,
+                                            0, 0, r.second) );
+  const auto s = inverse_exact(matrix3<Z>(1, 2, 3, 4, 5, 6, 7, 8, 9));
+  CPPUNIT_ASSERT( s.second == 0 );
+
+  // exact past 64 bits
+  const bigint M = bigint(1) << 40;
+  const matrix3<bigint> B(M, bigint(1), bigint(2), bigint(3), M, bigint(5),
+                          bigint(7), bigint(11), M);
+  const auto b = inverse_exact(B);
+  CPPUNIT_ASSERT( b.second == B.det() );
+  CPPUNIT_ASSERT( b.first * B == matrix3<bigint>(b.second, bigint(0),
+                      bigint(0), bigint(0), b.second, bigint(0), bigint(0),
+                      bigint(0), b.second) );
+
+  typedef GF<7> F;
+  const matrix3<F> C(F(2), F(4), F(3), F(3), F(4), F(6), F(1), F(3), F(5));
+  const matrix3<F> Ci = inverse_over<F>(C);
+  CPPUNIT_ASSERT( Ci * C == matrix3<F>(F(1), F(0), F(0), F(0), F(1), F(0),
+                                       F(0), F(0), F(1)) );
+
+  typedef boost::rat<Z> Q;
+  const matrix3<Q> Ai = inverse_over<Q>(A);
+  CPPUNIT_ASSERT( Ai * matrix3<Q>(A) == matrix3<Q>(Q(1), Q(0), Q(0), Q(0),
+                                                    Q(1), Q(0), Q(0), Q(0),
+                                                    Q(1)) );
+
+  const matrix3d<Z> D(1, 2, 0, -1, 1, 3, 0, 1, 1);
+  const auto d = inverse_exact(D);
+  CPPUNIT_ASSERT( d.second == D.det() && d.first * D == matrix3d<Z>(d.second,
+                      0, 0, 0, d.second, 0, 0, 0, d.second) );
+}
+
+void matrix3_TestCase::test_solve_exact()
+{
+  typedef std::int64_t Z;
+  const std::vector<matrix3<Z>> A{matrix3<Z>(*_A0), matrix3<Z>(*_A1),
+                                  matrix3<Z>(*_A2)};
+  const std::vector<vector3<Z>> b{vector3<Z>(1, 2, 3), vector3<Z>(-4, 0, 5),
+                                  vector3<Z>(7, 7, -1)};
+  std::vector<vector3<Z>> x;
+  std::vector<Z> d;
+  solve_exact(A, b, x, d);
+  CPPUNIT_ASSERT( x.size() == 3 && d.size() == 3 );
+  for (std::size_t k = 0; k != 3; ++k) {
+    CPPUNIT_ASSERT( d[k] == A[k].det() );
+    CPPUNIT_ASSERT( A[k] * x[k] == vector3<Z>(b[k] * d[k]) );
+  }
+
+  std::vector<matrix3<Z>> adj;
+  inverse_exact(A, adj, d);
+  CPPUNIT_ASSERT( adj.size() == 3 && adj[2] == A[2].adj() );
+
+  typedef boost::rat<Z> Q;
+  const vector3<Q> y = solve_over<Q>(A[1], b[1]);
+  CPPUNIT_ASSERT( matrix3<Q>(A[1]) * y == vector3<Q>(b[1]) );
+
+  const matrix3d<Z> D(1, 2, 0, -1, 1, 3, 0, 1, 1);
+  const vector3d<Z> c(2, -1, 4);
+  const auto e = solve_exact(D, c);
+  CPPUNIT_ASSERT( D * e.first == vector3d<Z>(c.e1() * e.second,
+                      c.e2() * e.second, c.e3() * e.second) );
+  const vector3d<Q> z = solve_over<Q>(D, c);
+  CPPUNIT_ASSERT( z.e1() * Q(e.second) == Q(e.first.e1()) );
+
+  // batched over matrix3d, in place
+  const std::vector<matrix3d<Z>> Ds{D, D.transpose()};
+  std::vector<vector3d<Z>> cs{c, c};
+  solve_exact(Ds, cs, cs, d);
+  CPPUNIT_ASSERT( cs.size() == 2 && d.size() == 2 );
+  CPPUNIT_ASSERT( cs[0] == e.first && d[0] == e.second );
+  CPPUNIT_ASSERT( Ds[1] * cs[1] == vector3d<Z>(c.e1() * d[1], c.e2() * d[1],
+                                               c.e3() * d[1]) );
+}
@@ -20,6 +20,8 @@ class matrix3_TestCase : public CppUnit::TestFixture
   CPPUNIT_TEST( test_divide );
   CPPUNIT_TEST( test_determinant );
   CPPUNIT_TEST( test_adjoint );
+  CPPUNIT_TEST( test_inverse_exact );
+  CPPUNIT_TEST( test_solve_exact );
 
 
   CPPUNIT_TEST_SUITE_END();
@@ -59,6 +61,12 @@ protected:
 
   /** Test adjoint */
   void test_adjoint();
+
+  /** Test exact inverse over int64, bigint, GF(p) and rat */
+  void test_inverse_exact();
+
+  /** Test exact solve, single and batched */
+  void test_solve_exact();
 };
 
 /** @} */
@@ -0,0 +1,136 @@
+#include "ntt_t.hpp"
+#include "test_random.hpp"
+#include <GF.hpp>
+#include <cstdint>
+#include <ntt.hpp>
+#include <vector>
+
+using namespace fun;
+
+CPPUNIT_TEST_SUITE_REGISTRATION( ntt_TestCase );
+
+namespace {
+
+constexpr std::uint64_t P = 998244353; // 119 * 2^23 + 1
+
+/// Return @a n pseudo-random elements of GF(p)
+template <std::uint64_t _p>
+std::vector<GF<_p>> random_poly(std::size_t n, std::uint64_t &seed)
+{
+  std::vector<GF<_p>> f;
+  for (std::size_t i = 0; i != n; ++i) {
+    f.emplace_back(typename GF<_p>::value_type((random_word(seed) >> 33) % _p));
+  }
+  return f;
+}
+
+/// Return the product of @a f and @a g by schoolbook
+template <std::uint64_t _p>
+std::vector<GF<_p>> naive_multiply(const std::vector<GF<_p>> &f,
+                                   const std::vector<GF<_p>> &g)
+{
+  std::vector<GF<_p>> h(f.size() + g.size() - 1);
+  for (std::size_t i = 0; i != f.size(); ++i)
+    for (std::size_t j = 0; j != g.size(); ++j)
+      h[i + j] += f[i] * g[j];
+  return h;
+}
+
+} // namespace
+
+void ntt_TestCase::test_transform()
+{
+  typedef detail::ntt_engine<P> E;
+  std::uint64_t seed = 1;
+  for (std::size_t n : {1U, 2U, 64U, 1U << 14}) { // 2^14 > E::block
+    std::vector<std::uint32_t> a = detail::poly_words(random_poly<P>(n, seed));
+    const std::vector<std::uint32_t> a0 = a;
+    E::forward(a.data(), n, E::twiddles(n, false).data());
+    if (n == 2)
+      CPPUNIT_ASSERT( a[0] == (a0[0] + a0[1]) % P );
+    E::inverse(a.data(), n, E::twiddles(n, true).data());
+    for (std::size_t i = 0; i != n; ++i)
+      CPPUNIT_ASSERT( a[i] == std::uint64_t(a0[i]) * n % P );
+  }
+}
+
+void ntt_TestCase::test_multiply()
+{
+  std::uint64_t seed = 2;
+  for (std::size_t n : {1U, 3U, 127U, 128U, 300U, 1500U}) {
+    const auto f = random_poly<P>(n, seed), g = random_poly<P>(n / 2 + 50, seed);
+    CPPUNIT_ASSERT( poly_multiply(f, g) == naive_multiply(f, g) );
+  }
+  CPPUNIT_ASSERT( poly_multiply(std::vector<GF<P>>(), random_poly<P>(3, seed))
+                      .empty() );
+
+  // 2^2 | 17 - 1 only: too short for a transform, schoolbook instead
+  const auto f = random_poly<17>(100, seed), g = random_poly<17>(120, seed);
+  CPPUNIT_ASSERT( poly_multiply(f, g) == naive_multiply(f, g) );
+  // (1 + x)^2 = 1 + 2x + x^2
+  const std::vector<GF<7>> a{GF<7>(1U), GF<7>(1U)};
+  CPPUNIT_ASSERT( (poly_multiply(a, a) ==
+                   std::vector<GF<7>>{GF<7>(1U), GF<7>(2U), GF<7>(1U)}) );
+}
+
+void ntt_TestCase::test_inverse()
+{
+  // 1 / (1 - x) = 1 + x + x^2 + ...
+  const std::vector<GF<P>> f{GF<P>(1U), -GF<P>(1U)};
+  CPPUNIT_ASSERT( series_inverse(f, 10) == std::vector<GF<P>>(10, GF<P>(1U)) );
+
+  std::uint64_t seed = 3;
+  for (std::size_t n : {1U, 2U, 77U, 1000U}) {
+    auto g = random_poly<P>(n + 5, seed);
+    g[0] = GF<P>(5U);
+    auto h = poly_multiply(g, series_inverse(g, n));
+    h.resize(n);
+    std::vector<GF<P>> one(n);
+    one[0] = GF<P>(1U);
+    CPPUNIT_ASSERT( h == one );
+  }
+}
+
+void ntt_TestCase::test_divmod()
+{
+  std::uint64_t seed = 4;
+  for (auto nm : {std::pair<std::size_t, std::size_t>{10, 20},
+                  {30, 5}, {500, 100}, {1200, 600}, {300, 299}}) {
+    const auto f = random_poly<P>(nm.first, seed);
+    auto g = random_poly<P>(nm.second, seed);
+    g.back() = GF<P>(3U);
+    std::vector<GF<P>> q, r;
+    poly_divmod(f, g, q, r);
+    CPPUNIT_ASSERT( r.size() < g.size() );
+    auto h = q.empty() ? std::vector<GF<P>>() : poly_multiply(q, g);
+    h.resize(std::max(h.size(), f.size()));
+    for (std::size_t i = 0; i != r.size(); ++i)
+      h[i] += r[i];
+    detail::poly_trim(h);
+    auto f0 = f;
+    detail::poly_trim(f0);
+    CPPUNIT_ASSERT( h == f0 );
+  }
+}
+
+void ntt_TestCase::test_multipoint()
+{
+  std::uint64_t seed = 5;
+  for (std::size_t n : {1U, 31U, 200U, 1000U}) {
+    const auto f = random_poly<P>(n + 7, seed), x = random_poly<P>(n, seed);
+    const auto y = multipoint_eval(f, x);
+    CPPUNIT_ASSERT( y.size() == n );
+    for (std::size_t i = 0; i != n; ++i) {
+      GF<P> s;
+      for (std::size_t j = f.size(); j-- != 0;)
+        s = s * x[i] + f[j];
+      CPPUNIT_ASSERT( y[i] == s );
+    }
+  }
+  // x^2 - 1 at 0, 1, 2, 3 over GF(7)
+  const std::vector<GF<7>> f{-GF<7>(1U), GF<7>(0U), GF<7>(1U)};
+  const std::vector<GF<7>> x{GF<7>(0U), GF<7>(1U), GF<7>(2U), GF<7>(3U)};
+  CPPUNIT_ASSERT( (multipoint_eval(f, x) ==
+                   std::vector<GF<7>>{GF<7>(6U), GF<7>(0U), GF<7>(3U),
+                                      GF<7>(1U)}) );
+}
@@ -0,0 +1,40 @@
+#ifndef CPPUNIT_NTT_T_HPP
+#define CPPUNIT_NTT_T_HPP 1
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <ntt.hpp>
+
+/**
+ * A test case for the number-theoretic transform
+ */
+class ntt_TestCase : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE( ntt_TestCase );
+  CPPUNIT_TEST( test_transform );
+  CPPUNIT_TEST( test_multiply );
+  CPPUNIT_TEST( test_inverse );
+  CPPUNIT_TEST( test_divmod );
+  CPPUNIT_TEST( test_multipoint );
+  CPPUNIT_TEST_SUITE_END();
+
+protected:
+  /** Test the round trip of the cache-blocked transform */
+  void test_transform();
+
+  /** Test the products against schoolbook, and the fallback */
+  void test_multiply();
+
+  /** Test the power-series inverse */
+  void test_inverse();
+
+  /** Test the division with remainder */
+  void test_divmod();
+
+  /** Test the multipoint evaluation against Horner's rule */
+  void test_multipoint();
+};
+
+/** @} */
+
+#endif
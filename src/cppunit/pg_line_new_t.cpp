@@ -0,0 +1,19 @@
+#include <vector3d.hpp> // first: the _new headers must not share its guard
+#include "pg_line_new_t.hpp"
+#include <pg_line_new.hpp>
+
+using namespace fun;
+
+CPPUNIT_TEST_SUITE_REGISTRATION( pg_line_new_TestCase );
+
+void pg_line_new_TestCase::test_line()
+{
+  const pg_point<int> p(1, 2, 3), q(4, 5, 6), r(-1, 7, 2);
+  const pg_line<int> l(p, q), m(p, r), n(q, r);
+  CPPUNIT_ASSERT( I(l, p) && I(l, q) && !I(l, r) );
+  CPPUNIT_ASSERT( meet(l, m) == p && meet(l, n) == q && meet(m, n) == r );
+  CPPUNIT_ASSERT( pg_line<int>(meet(l, m), meet(l, n)) == l );
+  CPPUNIT_ASSERT( l == pg_line<int>(q, p) );
+  CPPUNIT_ASSERT( !(l == m) );
+  CPPUNIT_ASSERT( l.a() == l[0] && l.b() == l[1] && l.c() == l[2] );
+}
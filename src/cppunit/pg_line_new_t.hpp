@@ -0,0 +1,24 @@
+#ifndef CPPUNIT_PG_LINE_NEW_T_HPP
+#define CPPUNIT_PG_LINE_NEW_T_HPP 1
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <pg_line_new.hpp>
+
+/**
+ * A test case for the lines of pg_line_new.hpp (line header first)
+ */
+class pg_line_new_TestCase : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE( pg_line_new_TestCase );
+  CPPUNIT_TEST( test_line );
+  CPPUNIT_TEST_SUITE_END();
+
+protected:
+  /** Test join, meet, incidence and equality through the line header */
+  void test_line();
+};
+
+/** @} */
+
+#endif
@@ -0,0 +1,71 @@
+#include "pg_point_new_t.hpp"
+#include "test_random.hpp"
+#include <cstdint>
+#include <pg_point_new.hpp>
+
+using namespace fun;
+
+CPPUNIT_TEST_SUITE_REGISTRATION( pg_point_new_TestCase );
+
+namespace {
+
+/// Return a pseudo-random point with small integral coordinates
+pg_point<long> random_point(std::uint64_t &seed)
+{
+  const long a = random_small(seed), b = random_small(seed), c = random_small(seed);
+  return pg_point<long>(a, b, c);
+}
+
+} // namespace
+
+void pg_point_new_TestCase::test_join_meet()
+{
+  std::uint64_t seed = 1;
+  for (int i = 0; i != 100; ++i) {
+    const pg_point<long> p = random_point(seed), q = random_point(seed);
+    const pg_point<long> r = random_point(seed), s = random_point(seed);
+    const pg_line<long> l(p, q), m(r, s); // join
+    CPPUNIT_ASSERT( l.incident(p) && l.incident(q) );
+    const pg_point<long> x(l, m);
+    CPPUNIT_ASSERT( x == meet(l, m) );
+    CPPUNIT_ASSERT( incident(x, l) && incident(x, m) );
+  }
+
+  // The meet of two lines through a point is that point.
+  const pg_point<int> p(1, 2, 3), q(4, 5, 6), r(-1, 7, 2);
+  CPPUNIT_ASSERT( meet(pg_line<int>(p, q), pg_line<int>(p, r)) == p );
+}
+
+void pg_point_new_TestCase::test_incident()
+{
+  const pg_point<int> p(1, 2, 3), q(4, 5, 6);
+  const pg_line<int> l(p, q);
+  CPPUNIT_ASSERT( incident(p, l) && I(l, q) );
+  CPPUNIT_ASSERT( incident(aux1(p, q), l) );  // p + q lies on l
+  CPPUNIT_ASSERT( !incident(pg_point<int>(1, 0, 0), l) );
+  CPPUNIT_ASSERT( !I(l, aux2(l)) );           // a.a + b.b + c.c != 0
+  CPPUNIT_ASSERT( incident(pg_point<int>(0, 0, 1), pg_line<int>(1, 0, 0)) );
+}
+
+void pg_point_new_TestCase::test_equal()
+{
+  const pg_point<int> p(1, 2, 3);
+  CPPUNIT_ASSERT( p == pg_point<int>(2, 4, 6) );
+  CPPUNIT_ASSERT( p == pg_point<int>(-3, -6, -9) );
+  CPPUNIT_ASSERT( !(p == pg_point<int>(1, 2, 4)) );
+  CPPUNIT_ASSERT( pg_point<double>(0.5, 1., 1.5) == pg_point<double>(1, 2, 3) );
+
+  const pg_line<int> l(1, -1, 2);
+  CPPUNIT_ASSERT( l == pg_line<int>(-2, 2, -4) );
+  CPPUNIT_ASSERT( !(l == pg_line<int>(1, 1, 2)) );
+}
+
+void pg_point_new_TestCase::test_constexpr()
+{
+  constexpr pg_point<int> p(1, 2, 3), q(4, 5, 6), r(-1, 7, 2);
+  constexpr pg_line<int> l(p, q);
+  static_assert(incident(p, l), "p lies on the join of p and q");
+  static_assert(pg_point<int>(l, pg_line<int>(p, r)) == p, "meet");
+  static_assert(p == pg_point<int>(2, 4, 6), "projective equality");
+  CPPUNIT_ASSERT( l.incident(q) );
+}
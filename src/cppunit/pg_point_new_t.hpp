@@ -0,0 +1,36 @@
+#ifndef CPPUNIT_PG_POINT_NEW_T_HPP
+#define CPPUNIT_PG_POINT_NEW_T_HPP 1
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <pg_point_new.hpp>
+
+/**
+ * A test case for the points of pg_point_new.hpp (point header first)
+ */
+class pg_point_new_TestCase : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE( pg_point_new_TestCase );
+  CPPUNIT_TEST( test_join_meet );
+  CPPUNIT_TEST( test_incident );
+  CPPUNIT_TEST( test_equal );
+  CPPUNIT_TEST( test_constexpr );
+  CPPUNIT_TEST_SUITE_END();
+
+protected:
+  /** Test that join and meet are dual to each other */
+  void test_join_meet();
+
+  /** Test incidence of points and lines */
+  void test_incident();
+
+  /** Test equality up to a non-zero scale factor */
+  void test_equal();
+
+  /** Test that join, meet and incident stay constant expressions */
+  void test_constexpr();
+};
+
+/** @} */
+
+#endif
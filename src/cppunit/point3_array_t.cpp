@@ -0,0 +1,120 @@
+#include "point3_array_t.hpp"
+#include "test_random.hpp"
+#include <GF.hpp>
+#include <bigint.hpp>
+#include <cstdint>
+#include <point3_array.hpp>
+
+using namespace fun;
+
+CPPUNIT_TEST_SUITE_REGISTRATION( point3_array_TestCase );
+
+namespace {
+
+/// Return @a n pseudo-random points (or lines), made by @a make
+template <typename _K, template <typename> class _P, class _Make>
+coord3_array<_K, _P> random_array(std::size_t n, std::uint64_t seed,
+                                  _Make make)
+{
+  coord3_array<_K, _P> a;
+  for (std::size_t i = 0; i != n; ++i)
+    a.push_back(vector3<_K>(make(random_small(seed)), make(random_small(seed)),
+                            make(random_small(seed))));
+  return a;
+}
+
+/// Return true if the batched kernels agree with point3 and line3
+template <typename _K, class _Make> bool check_kernels(_Make make)
+{
+  const std::size_t n = 1037; // not a multiple of the lanes nor the block
+  const auto p = random_array<_K, point3>(n, 1, make);
+  const auto q = random_array<_K, point3>(n, 2, make);
+  const auto r = random_array<_K, point3>(n, 3, make);
+  const auto m = random_array<_K, line3>(n, 4, make);
+
+  const line3_array<_K> l = join(p, q);
+  const point3_array<_K> s = meet(l, m);
+  const auto d = dot(p, m);
+  const auto e = det(p, q, r);
+  if (l.size() != n || s.size() != n || d.size() != n || e.size() != n)
+    return false;
+  for (std::size_t i = 0; i != n; ++i) {
+    const line3<_K> li = join(p[i], q[i]);
+    if (!(l[i] == li && s[i] == point3<_K>(cross(li, m[i]))))
+      return false;
+    if (!(d[i] == dot(p[i], m[i]) && e[i] == det(p[i], q[i], r[i])))
+      return false;
+  }
+  return true;
+}
+
+/// Return an element of GF(7) from an integer in [-50, 50]
+GF<7> gf7(int a) { return GF<7>(unsigned(a + 56) % 7); }
+
+} // namespace
+
+void point3_array_TestCase::test_container()
+{
+  point3_array<int> a(3);
+  CPPUNIT_ASSERT( a.size() == 3 && !a.empty() );
+  CPPUNIT_ASSERT( a[2] == point3<int>(0, 0, 1) );
+  a.set(1, point3<int>(1, 2, 3));
+  a.push_back(point3<int>(4, 5, 6));
+  CPPUNIT_ASSERT( a.size() == 4 );
+  CPPUNIT_ASSERT( a[1] == point3<int>(1, 2, 3) );
+  CPPUNIT_ASSERT( a.data(2)[3] == 6 );
+  CPPUNIT_ASSERT( reinterpret_cast<std::uintptr_t>(a.data(0)) % 64 == 0 );
+
+  // the iterators yield point3<int> views
+  int sum = 0;
+  for (const point3<int> &p : a)
+    sum += p.x() + p.y() + p.z();
+  CPPUNIT_ASSERT( sum == 23 );
+  CPPUNIT_ASSERT( a.end() - a.begin() == 4 );
+  CPPUNIT_ASSERT( *(a.begin() + 3) == point3<int>(4, 5, 6) );
+
+  const point3_array<int> b(a.begin(), a.end());
+  CPPUNIT_ASSERT( b == a );
+  a.clear();
+  CPPUNIT_ASSERT( a.empty() && b != a );
+}
+
+void point3_array_TestCase::test_kernels()
+{
+  CPPUNIT_ASSERT( check_kernels<int>([](int a) { return a; }) );
+  CPPUNIT_ASSERT( check_kernels<std::int64_t>([](int a) {
+    return std::int64_t(a) * 16384; // products beyond 32 bits
+  }) );
+  CPPUNIT_ASSERT( check_kernels<double>([](int a) { return double(a); }) );
+  CPPUNIT_ASSERT( check_kernels<float>([](int a) { return float(a); }) );
+}
+
+void point3_array_TestCase::test_GF()
+{
+  CPPUNIT_ASSERT( check_kernels<GF<7>>(gf7) );
+  CPPUNIT_ASSERT( check_kernels<GF<2147483647>>([](int a) {
+    return GF<2147483647>(unsigned(a + 100));
+  }) );
+  CPPUNIT_ASSERT( check_kernels<bigint>([](int a) { return bigint(a); }) );
+}
+
+void point3_array_TestCase::test_incident()
+{
+  // the lines through p[i] and q[i] are incident with both
+  const std::size_t n = 600;
+  const auto p = random_array<GF<7>, point3>(n, 5, gf7);
+  const auto q = random_array<GF<7>, point3>(n, 6, gf7);
+  const auto m = random_array<GF<7>, line3>(n, 7, gf7);
+  const line3_array<GF<7>> l = join(p, q);
+  const std::vector<bool> f = incident(p, l), g = incident(q, l);
+  const std::vector<bool> h = incident(p, m);
+  const auto e = det(p, q, meet(l, m));
+  std::size_t count = 0;
+  for (std::size_t i = 0; i != n; ++i) {
+    CPPUNIT_ASSERT( f[i] && g[i] );
+    CPPUNIT_ASSERT( h[i] == p[i].incident(m[i]) );
+    CPPUNIT_ASSERT( e[i] == GF<7>(0) ); // p, q and l.m are collinear
+    count += h[i];
+  }
+  CPPUNIT_ASSERT( count > 0 && count < n );
+}
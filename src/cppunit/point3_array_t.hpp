@@ -0,0 +1,36 @@
+#ifndef CPPUNIT_POINT3_ARRAY_T_HPP
+#define CPPUNIT_POINT3_ARRAY_T_HPP 1
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <point3_array.hpp>
+
+/**
+ * A test case for the arrays of 3d points and lines
+ */
+class point3_array_TestCase : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE( point3_array_TestCase );
+  CPPUNIT_TEST( test_container );
+  CPPUNIT_TEST( test_kernels );
+  CPPUNIT_TEST( test_GF );
+  CPPUNIT_TEST( test_incident );
+  CPPUNIT_TEST_SUITE_END();
+
+protected:
+  /** Test the storage and the point3 views */
+  void test_container();
+
+  /** Test the SIMD kernels against point3 and line3 */
+  void test_kernels();
+
+  /** Test the kernels of GF(p) and of exact coordinates */
+  void test_GF();
+
+  /** Test the incidence and collinearity flags */
+  void test_incident();
+};
+
+/** @} */
+
+#endif
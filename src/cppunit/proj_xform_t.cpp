@@ -0,0 +1,107 @@
+#include "proj_xform_t.hpp"
+#include "test_random.hpp"
+#include <cmath>
+#include <cstdint>
+#include <proj_xform.hpp>
+
+using namespace fun;
+
+CPPUNIT_TEST_SUITE_REGISTRATION( proj_xform_TestCase );
+
+namespace {
+
+/// Return the homogeneous image of the affine point @a p under @a H
+template <typename _K>
+vector3d<_K> image(const matrix3d<_K> &H, const point2d<_K> &p)
+{
+  return H * vector3d<_K>(p.x(), p.y(), _K(1));
+}
+
+/// Return true if @a p and @a q are equal within @a eps
+bool near(const point2d<double> &p, const point2d<double> &q,
+          double eps = 1e-9)
+{
+  return std::abs(p.x() - q.x()) <= eps && std::abs(p.y() - q.y()) <= eps;
+}
+
+/// A homography with a projective part, finite on [-50, 50]^2
+const matrix3d<double> H(2., 1., -3., 0.5, 3., 1., 0.001, -0.002, 1.);
+
+} // namespace
+
+void proj_xform_TestCase::test_correct_persp()
+{
+  const point2d<int> A(1, 1), B(5, 2), C(6, 7), D(0, 5);
+  const matrix3d<int> M = correct_persp(A, B, C, D);
+  const vector3d<int> a = image(M, A), b = image(M, B), c = image(M, C),
+                      d = image(M, D);
+  CPPUNIT_ASSERT( a.e3() != 0 && b.e3() != 0 && c.e3() != 0 && d.e3() != 0 );
+  CPPUNIT_ASSERT( a.e1() == 0 && a.e2() == 0 );
+  CPPUNIT_ASSERT( b.e1() == b.e3() && b.e2() == 0 );
+  CPPUNIT_ASSERT( c.e1() == c.e3() && c.e2() == c.e3() );
+  CPPUNIT_ASSERT( d.e1() == 0 && d.e2() == d.e3() );
+
+  const matrix3d<double> N = correct_persp(
+      point2d<double>(1., 1.), point2d<double>(5., 2.),
+      point2d<double>(6., 7.), point2d<double>(0., 5.));
+  CPPUNIT_ASSERT( near(transform(N, point2d<double>(1., 1.)), {0., 0.}) );
+  CPPUNIT_ASSERT( near(transform(N, point2d<double>(5., 2.)), {1., 0.}) );
+  CPPUNIT_ASSERT( near(transform(N, point2d<double>(6., 7.)), {1., 1.}) );
+  CPPUNIT_ASSERT( near(transform(N, point2d<double>(0., 5.)), {0., 1.}) );
+
+  // general four-point solve, and three collinear points give det 0
+  const point2d<int> A1(-2, 0), B1(3, -1), C1(4, 4), D1(-1, 3);
+  const matrix3d<int> P = persp_xform(A, B, C, D, A1, B1, C1, D1);
+  const vector3d<int> a1 = image(P, A);
+  CPPUNIT_ASSERT( a1.e1() == A1.x() * a1.e3() && a1.e2() == A1.y() * a1.e3() );
+  const vector3d<int> c1 = image(P, C);
+  CPPUNIT_ASSERT( c1.e1() == C1.x() * c1.e3() && c1.e2() == C1.y() * c1.e3() );
+  CPPUNIT_ASSERT( correct_persp(A, B, point2d<int>(9, 3), D).det() == 0 );
+}
+
+void proj_xform_TestCase::test_compose()
+{
+  const matrix3d<std::int64_t> H1(1, 2, 0, -1, 1, 3, 0, 1, 1),
+      H2(2, 0, 1, 1, 1, -1, 1, 0, 1), H3(0, 1, 1, 1, 0, 2, 3, -1, 1);
+  CPPUNIT_ASSERT( compose(H1) == H1 );
+  CPPUNIT_ASSERT( compose(H1, H2, H3) == H3 * (H2 * H1) );
+
+  std::uint64_t seed = 7;
+  point3_array<std::int64_t> p;
+  for (std::size_t i = 0; i != 103; ++i)
+    p.push_back(vector3<std::int64_t>(random_small(seed), random_small(seed), random_small(seed)));
+  point3_array<std::int64_t> q, r;
+  transform(compose(H1, H2, H3), p, q);
+  transform(H1, p, r);
+  transform(H2, r, r); // in place
+  transform(H3, r, r);
+  CPPUNIT_ASSERT( q == r );
+}
+
+void proj_xform_TestCase::test_transform()
+{
+  const std::size_t n = 1037; // not a multiple of the lanes
+  std::uint64_t seed = 3;
+  point2d_array<double> p;
+  point3_array<double> s;
+  for (std::size_t i = 0; i != n; ++i) {
+    const double x = random_small(seed), y = random_small(seed), z = random_small(seed) + 100.;
+    p.push_back(point2d<double>(x, y));
+    s.push_back(vector3<double>(x, y, z));
+  }
+
+  const point2d_array<double> q = transform(H, p);
+  point2d_array<double> t;
+  transform(H, s, t);
+  CPPUNIT_ASSERT( q.size() == n && t.size() == n );
+  bool ok = true;
+  for (std::size_t i = 0; i != n; ++i) {
+    const point2d<double> si(s[i].x() / s[i].z(), s[i].y() / s[i].z());
+    ok = ok && near(q[i], transform(H, p[i]));
+    ok = ok && near(t[i], transform(H, si));
+  }
+  CPPUNIT_ASSERT( ok );
+
+  transform(H, p, p); // in place
+  CPPUNIT_ASSERT( p == q );
+}
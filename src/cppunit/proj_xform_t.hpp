@@ -0,0 +1,32 @@
+#ifndef CPPUNIT_PROJ_XFORM_T_HPP
+#define CPPUNIT_PROJ_XFORM_T_HPP 1
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <proj_xform.hpp>
+
+/**
+ * A test case for the projective transforms
+ */
+class proj_xform_TestCase : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE( proj_xform_TestCase );
+  CPPUNIT_TEST( test_correct_persp );
+  CPPUNIT_TEST( test_compose );
+  CPPUNIT_TEST( test_transform );
+  CPPUNIT_TEST_SUITE_END();
+
+protected:
+  /** Test the four-point solve, exact and in floating point */
+  void test_correct_persp();
+
+  /** Test that a composed chain equals the transforms in turn */
+  void test_compose();
+
+  /** Test the batched transforms against the one-point transform */
+  void test_transform();
+};
+
+/** @} */
+
+#endif
@@ -0,0 +1,71 @@
+#include "rat_accumulator_t.hpp"
+#include <bigint.hpp>
+#include <rat.hpp>
+#include <rat_accumulator.hpp>
+#include <vector>
+
+using namespace fun;
+
+CPPUNIT_TEST_SUITE_REGISTRATION( rat_accumulator_TestCase );
+
+typedef boost::rat<bigint> Rat;
+
+void rat_accumulator_TestCase::test_sum()
+{
+  rat_accumulator<bigint> acc(16);
+  Rat h(0);
+  for (int k = 1; k <= 200; ++k) {
+    acc += Rat(bigint(1), bigint(k));
+    h += Rat(bigint(1), bigint(k));
+  }
+  h.normalize();
+  const Rat s = acc.sum();
+  CPPUNIT_ASSERT( acc.size() == 200 );
+  CPPUNIT_ASSERT( s.num() == h.num() && s.denom() == h.denom() );
+}
+
+void rat_accumulator_TestCase::test_group()
+{
+  rat_accumulator<long long> acc;
+  for (int k = 0; k < 1000; ++k) {
+    acc += boost::rat<long long>(k % 7, 8);
+    acc -= boost::rat<long long>(1, 3);
+  }
+  // 142 full cycles of 0..6 (sum 21) plus 0..5
+  CPPUNIT_ASSERT( acc.sum() == boost::rat<long long>(142 * 21 + 15, 8) -
+                                   boost::rat<long long>(1000, 3) );
+  acc += boost::rat<long long>(1, 0);
+  CPPUNIT_ASSERT( acc.sum().denom() == 0 && acc.sum().num() > 0 );
+  acc += boost::rat<long long>(-1, 0);
+  CPPUNIT_ASSERT( is_NaN(acc.sum()) );
+}
+
+void rat_accumulator_TestCase::test_merge()
+{
+  rat_accumulator<long long> a(4), b(4);
+  for (int k = 1; k <= 10; ++k) {
+    a += boost::rat<long long>(1, k * (k + 1));
+    b += boost::rat<long long>(1, (k + 10) * (k + 11));
+  }
+  a.merge(b);
+  CPPUNIT_ASSERT( a.size() == 20 );
+  CPPUNIT_ASSERT( a.sum() == boost::rat<long long>(20, 21) );
+  a += boost::rat<long long>(1, 21);
+  a.merge(a); // doubles the terms
+  CPPUNIT_ASSERT( a.size() == 42 );
+  CPPUNIT_ASSERT( a.sum() == boost::rat<long long>(2) );
+}
+
+void rat_accumulator_TestCase::test_parallel()
+{
+  std::vector<boost::rat<long long>> v;
+  for (int k = 1; k <= 100000; ++k)
+    v.emplace_back(k % 5 == 0 ? -3 : 1, 1 << (k % 11));
+  rat_accumulator<long long> acc;
+  acc.add(v.begin(), v.end());
+  const auto s1 = acc.sum();
+  const auto s4 = rat_accumulator<long long>::parallel_sum(v.begin(), v.end(), 4);
+  CPPUNIT_ASSERT( s1 == s4 );
+  CPPUNIT_ASSERT( s1 == rat_accumulator<long long>::parallel_sum(
+                            v.begin(), v.end()) );
+}
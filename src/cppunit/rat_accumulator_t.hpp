@@ -0,0 +1,36 @@
+#ifndef CPPUNIT_RAT_ACCUMULATOR_T_HPP
+#define CPPUNIT_RAT_ACCUMULATOR_T_HPP 1
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <rat_accumulator.hpp>
+
+/**
+ * A test case for rat_accumulator
+ */
+class rat_accumulator_TestCase : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE( rat_accumulator_TestCase );
+  CPPUNIT_TEST( test_sum );
+  CPPUNIT_TEST( test_group );
+  CPPUNIT_TEST( test_merge );
+  CPPUNIT_TEST( test_parallel );
+  CPPUNIT_TEST_SUITE_END();
+
+protected:
+  /** Test the sum against operator+= */
+  void test_sum();
+
+  /** Test equal denominators and extended values */
+  void test_group();
+
+  /** Test merging two accumulators */
+  void test_merge();
+
+  /** Test the threaded reduction */
+  void test_parallel();
+};
+
+/** @} */
+
+#endif
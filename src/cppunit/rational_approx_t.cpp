@@ -0,0 +1,98 @@
+#include "rational_approx_t.hpp"
+#include <bigint.hpp>
+#include <cmath>
+#include <rat.hpp>
+#include <vector>
+
+using namespace fun;
+
+CPPUNIT_TEST_SUITE_REGISTRATION( rational_approx_TestCase );
+
+typedef boost::rat<long long> Rat;
+
+namespace {
+
+bool same(const Rat &r, long long n, long long d) {
+  return r.num() == n && r.denom() == d;
+}
+
+} // namespace
+
+void rational_approx_TestCase::test_double()
+{
+  const double pi = 3.14159265358979323846;
+  CPPUNIT_ASSERT( same(best_approximation(pi, 7LL), 22, 7) );
+  CPPUNIT_ASSERT( same(best_approximation(pi, 100LL), 311, 99) );
+  CPPUNIT_ASSERT( same(best_approximation(pi, 1000LL), 355, 113) );
+  CPPUNIT_ASSERT( same(best_approximation(-pi, 1000LL), -355, 113) );
+  CPPUNIT_ASSERT( same(best_approximation(0.1, 1000000LL), 1, 10) );
+  CPPUNIT_ASSERT( same(best_approximation(0.75, 3LL), 2, 3) );
+  // The tie between 0/1 and 1/2 goes to the smaller denominator
+  CPPUNIT_ASSERT( same(best_approximation(0.25, 2LL), 0, 1) );
+  CPPUNIT_ASSERT( same(best_approximation(1e-300, 1LL << 62), 0, 1) );
+  CPPUNIT_ASSERT( same(best_approximation(1e300, 10LL),
+                       std::numeric_limits<long long>::max(), 1) );
+  CPPUNIT_ASSERT( is_NaN(best_approximation(std::nan(""), 10LL)) );
+  CPPUNIT_ASSERT( best_approximation(-HUGE_VAL, 10LL).denom() == 0 );
+
+  // Exact: 0.1 is 3602879701896397 / 2^55
+  auto r = best_approximation(0.1, bigint(1) << 60);
+  CPPUNIT_ASSERT( r.num() == bigint(3602879701896397LL) &&
+                  r.denom() == bigint(1) << 55 );
+}
+
+void rational_approx_TestCase::test_rational()
+{
+  Rat x(314159265, 100000000);
+  CPPUNIT_ASSERT( same(best_approximation(x, 1000LL), 355, 113) );
+  CPPUNIT_ASSERT( best_approximation(x, 100000000LL) == x );
+  CPPUNIT_ASSERT( same(best_approximation(Rat(-7, 3), 2LL), -5, 2) );
+  CPPUNIT_ASSERT( best_approximation(Rat(1, 0), 2LL).denom() == 0 );
+}
+
+void rational_approx_TestCase::test_batch()
+{
+  const std::vector<double> xs{0.5, 1.0 / 3.0, 0.1, 2.71828182845904523536};
+  std::vector<Rat> rs(xs.size());
+  best_approximation(xs.begin(), xs.end(), rs.begin(), 1000LL);
+  CPPUNIT_ASSERT( same(rs[0], 1, 2) );
+  CPPUNIT_ASSERT( same(rs[1], 1, 3) );
+  CPPUNIT_ASSERT( same(rs[2], 1, 10) );
+  CPPUNIT_ASSERT( same(rs[3], 1457, 536) );
+
+  std::vector<Rat> qs{Rat(333, 1000), Rat(-667, 1000)};
+  best_approximation(qs.begin(), qs.end(), qs.begin(), 10LL);
+  CPPUNIT_ASSERT( same(qs[0], 1, 3) && same(qs[1], -2, 3) );
+}
+
+void rational_approx_TestCase::test_simplest()
+{
+  CPPUNIT_ASSERT( same(simplest_rational(Rat(3, 10), Rat(4, 10)), 1, 3) );
+  CPPUNIT_ASSERT( same(simplest_rational(Rat(31, 10), Rat(33, 10)), 13, 4) );
+  CPPUNIT_ASSERT( same(simplest_rational(Rat(-33, 10), Rat(-31, 10)), -13, 4) );
+  CPPUNIT_ASSERT( same(simplest_rational(Rat(-1, 2), Rat(5, 2)), 0, 1) );
+  CPPUNIT_ASSERT( same(simplest_rational(Rat(3, 2), Rat(7, 2)), 2, 1) );
+  CPPUNIT_ASSERT( same(simplest_rational(Rat(2, 6), Rat(2, 6)), 1, 3) );
+  CPPUNIT_ASSERT( same(simplest_rational(Rat(7, 2), Rat(1, 0)), 4, 1) );
+}
+
+void rational_approx_TestCase::test_stern_brocot()
+{
+  // sqrt(2)
+  auto r = stern_brocot_search(
+      [](long long p, long long q) { return p * p <= 2 * q * q; }, 1000LL);
+  CPPUNIT_ASSERT( same(r.first, 1393, 985) && same(r.second, 577, 408) );
+
+  // 7/2 itself is the lower neighbour
+  auto s = stern_brocot_search(
+      [](long long p, long long q) { return 2 * p <= 7 * q; }, 10LL);
+  CPPUNIT_ASSERT( same(s.first, 7, 2) && same(s.second, 32, 9) );
+
+  auto t = stern_brocot_search(
+      [](const bigint &p, const bigint &q) { return p * p <= 2 * q * q; },
+      bigint(1) << 80);
+  CPPUNIT_ASSERT( t.first < t.second );
+  CPPUNIT_ASSERT( t.first.num() * t.first.num() < 2 * t.first.denom() * t.first.denom() );
+  CPPUNIT_ASSERT( t.second.num() * t.second.num() > 2 * t.second.denom() * t.second.denom() );
+  CPPUNIT_ASSERT( t.second.num() * t.first.denom() - t.first.num() * t.second.denom() == 1 );
+}
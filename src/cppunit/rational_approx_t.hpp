@@ -0,0 +1,40 @@
+#ifndef CPPUNIT_RATIONAL_APPROX_T_HPP
+#define CPPUNIT_RATIONAL_APPROX_T_HPP 1
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <rational_approx.hpp>
+
+/**
+ * A test case for the best rational approximations
+ */
+class rational_approx_TestCase : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE( rational_approx_TestCase );
+  CPPUNIT_TEST( test_double );
+  CPPUNIT_TEST( test_rational );
+  CPPUNIT_TEST( test_batch );
+  CPPUNIT_TEST( test_simplest );
+  CPPUNIT_TEST( test_stern_brocot );
+  CPPUNIT_TEST_SUITE_END();
+
+protected:
+  /** Test the approximation of doubles */
+  void test_double();
+
+  /** Test the approximation of rational numbers */
+  void test_rational();
+
+  /** Test the batched version */
+  void test_batch();
+
+  /** Test the simplest rational of an interval */
+  void test_simplest();
+
+  /** Test the mediant search */
+  void test_stern_brocot();
+};
+
+/** @} */
+
+#endif
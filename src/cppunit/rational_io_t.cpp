@@ -0,0 +1,88 @@
+#include "rational_io_t.hpp"
+#include <bigint.hpp>
+#include <cstring>
+#include <rat.hpp>
+#include <rational.hpp>
+#include <rational_io.hpp>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace fun;
+
+CPPUNIT_TEST_SUITE_REGISTRATION( rational_io_TestCase );
+
+template <class _R> static std::string str(const _R &r)
+{
+  char buf[128];
+  auto res = to_chars(buf, buf + sizeof(buf), r);
+  return res.ec == std::errc() ? std::string(buf, res.ptr) : "error";
+}
+
+template <class _R> static std::string stream(const _R &r)
+{
+  std::ostringstream os;
+  os << r;
+  return os.str();
+}
+
+void rational_io_TestCase::test_to_chars()
+{
+  boost::rat<int> a(6, -8, unnormalized), b(5), n(0, 0), i(-3, 0);
+  rational<long long> c(1234567890123LL, 7);
+  CPPUNIT_ASSERT( str(a) == "-3/4" && str(a) == stream(a) );
+  CPPUNIT_ASSERT( str(b) == "5/1" && str(n) == "0/0" && str(i) == "-3/0" );
+  CPPUNIT_ASSERT( str(c) == stream(c) );
+  rational<int> e(6, -8), f(5), m(0, 0), j(-3, 0);
+  CPPUNIT_ASSERT( str(e) == "(-3/4)" && str(e) == stream(e) );
+  CPPUNIT_ASSERT( str(f) == "5" && str(m) == "NaN" && str(j) == "-Inf" );
+  rational<bigint> d(bigint(1) << 100, bigint(3));
+  CPPUNIT_ASSERT( str(d) == "(1267650600228229401496703205376/3)" );
+  char small[4];
+  CPPUNIT_ASSERT( to_chars(small, small + 4, e).ec ==
+                  std::errc::value_too_large );
+  CPPUNIT_ASSERT( to_chars(small, small + 3, a).ec ==
+                  std::errc::value_too_large );
+}
+
+void rational_io_TestCase::test_from_chars()
+{
+  const char *s = "(-6/8)";
+  rational<int> r;
+  auto res = from_chars(s, s + std::strlen(s), r);
+  CPPUNIT_ASSERT( res.ec == std::errc() && *res.ptr == '\0' );
+  CPPUNIT_ASSERT( r == rational<int>(-3, 4) );
+  s = "-Inf";
+  from_chars(s, s + 4, r);
+  CPPUNIT_ASSERT( r.num() == -1 && r.denom() == 0 );
+  s = "NaN";
+  from_chars(s, s + 3, r);
+  CPPUNIT_ASSERT( is_NaN(r) );
+  s = "7/x";
+  r = 2;
+  res = from_chars(s, s + 3, r);
+  CPPUNIT_ASSERT( res.ec == std::errc::invalid_argument && r == 2 );
+  s = "170141183460469231731687303715884105727/2";
+  rational<int128_t> w;
+  res = from_chars(s, s + std::strlen(s), w);
+  CPPUNIT_ASSERT( res.ec == std::errc() && w.denom() == 2 );
+  CPPUNIT_ASSERT( str(w) == "(170141183460469231731687303715884105727/2)" );
+}
+
+void rational_io_TestCase::test_column()
+{
+  std::vector<boost::rat<long long>> v = {
+      {1, 3}, {-4, 2}, {0, 0}, {5, 0}, {7}};
+  std::string text;
+  write_column(text, v.data(), v.data() + v.size());
+  CPPUNIT_ASSERT( text == "1/3\n-2/1\n0/0\n5/0\n7/1\n" );
+  std::vector<boost::rat<long long>> w;
+  auto res = read_column(text.data(), text.data() + text.size(), w);
+  CPPUNIT_ASSERT( res.ec == std::errc() && w.size() == v.size() );
+  CPPUNIT_ASSERT( w[0] == v[0] && w[1] == v[1] && is_NaN(w[2]) );
+  CPPUNIT_ASSERT( w[3].denom() == 0 && w[4] == 7 );
+  w.clear();
+  text = "1/2, 3/4,x";
+  res = read_column(text.data(), text.data() + text.size(), w);
+  CPPUNIT_ASSERT( res.ec != std::errc() && *res.ptr == 'x' && w.size() == 2 );
+}
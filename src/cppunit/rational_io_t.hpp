@@ -0,0 +1,32 @@
+#ifndef CPPUNIT_RATIONAL_IO_T_HPP
+#define CPPUNIT_RATIONAL_IO_T_HPP 1
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <rational_io.hpp>
+
+/**
+ * A test case for the text conversion of rational numbers
+ */
+class rational_io_TestCase : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE( rational_io_TestCase );
+  CPPUNIT_TEST( test_to_chars );
+  CPPUNIT_TEST( test_from_chars );
+  CPPUNIT_TEST( test_column );
+  CPPUNIT_TEST_SUITE_END();
+
+protected:
+  /** Test to_chars against operator<< */
+  void test_to_chars();
+
+  /** Test from_chars, including NaN and infinities */
+  void test_from_chars();
+
+  /** Test the bulk column reader and writer */
+  void test_column();
+};
+
+/** @} */
+
+#endif
@@ -0,0 +1,123 @@
+#include "rational_t.hpp"
+#include <rat.hpp>
+#include <rational.hpp>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+
+using namespace fun;
+
+CPPUNIT_TEST_SUITE_REGISTRATION( rational_TestCase );
+
+void rational_TestCase::test_eager()
+{
+  rational<int> a(6, -8), b(5, 12);
+  CPPUNIT_ASSERT( a.num() == -3 && a.denom() == 4 );
+  rational<int> c = a + b;
+  CPPUNIT_ASSERT( c.num() == -1 && c.denom() == 3 );
+  c *= rational<int>(9, 2);
+  CPPUNIT_ASSERT( c.num() == -3 && c.denom() == 2 );
+  c /= 3;
+  CPPUNIT_ASSERT( c.num() == -1 && c.denom() == 2 );
+  CPPUNIT_ASSERT( 1 - c == rational<int>(3, 2) );
+}
+
+void rational_TestCase::test_lazy()
+{
+  boost::rat<long long> a(1, 4), b(1, 6);
+  boost::rat<long long> c = a + b;
+  CPPUNIT_ASSERT( c.denominator() == 24 ); // not reduced
+  CPPUNIT_ASSERT( c == boost::rat<long long>(5, 12) );
+
+  // The magnitude threshold keeps the components bounded
+  boost::rat<long long> x(1, 3);
+  for (int k = 0; k != 100; ++k)
+    x = x * boost::rat<long long>(7, 5) / boost::rat<long long>(7, 5);
+  CPPUNIT_ASSERT( x.denominator() < (1LL << 32) );
+  CPPUNIT_ASSERT( x == boost::rat<long long>(1, 3) );
+}
+
+void rational_TestCase::test_never()
+{
+  typedef rational<int, never_normalize> fixed;
+  fixed a(2, 8), b(6, 8);
+  fixed c = a + b;
+  CPPUNIT_ASSERT( c.num() == 8 && c.denom() == 8 );
+  CPPUNIT_ASSERT( c == 1 );
+  CPPUNIT_ASSERT( fixed(3, -8).denom() == 8 );
+}
+
+void rational_TestCase::test_compare()
+{
+  rational<int> a(1, 3);
+  boost::rat<int> b(2, 6, unnormalized);
+  CPPUNIT_ASSERT( a == b );
+  CPPUNIT_ASSERT( a < rational<int>(1, 2) );
+  CPPUNIT_ASSERT( rational<int>(-1, 2) < a );
+  CPPUNIT_ASSERT( a > 0 && a < 1 );
+}
+
+void rational_TestCase::test_extended()
+{
+  CPPUNIT_ASSERT( is_NaN(rational<int>(0, 0)) );
+  CPPUNIT_ASSERT( !is_NaN(rational<int>(1, 0)) );
+  CPPUNIT_ASSERT( rational<int>(5) < rational<int>(1, 0) );
+  CPPUNIT_ASSERT( rational<int>(-1, 0) < rational<int>(-5) );
+}
+
+void rational_TestCase::test_overflow()
+{
+  typedef long long ll;
+  const ll M = std::numeric_limits<ll>::max();
+  rational<ll> a(M - 1, M - 2), b(M - 2, M - 3);
+  CPPUNIT_ASSERT( a < b && !(b < a) && !(a == b) );
+  CPPUNIT_ASSERT( -b < -a );
+  CPPUNIT_ASSERT( a > 1 && a < 2 && !(a == 1) );
+
+#ifdef FUN_HAS_INT128
+  // Beyond the double-width path: continued fractions
+  CPPUNIT_ASSERT( fun::compare_fractions<fun::int128_t>(
+                      fun::int128_t(M) * M - 1, fun::int128_t(M) * M - 2,
+                      fun::int128_t(M) * M - 2, fun::int128_t(M) * M - 3) < 0 );
+  CPPUNIT_ASSERT( fun::compare_fractions<fun::int128_t>(
+                      fun::int128_t(M) * 6, fun::int128_t(M) * 4, 3, 2) == 0 );
+#endif
+  CPPUNIT_ASSERT( fun::compare_fractions<int>(-1, 0, 1, 0) < 0 );
+}
+
+void rational_TestCase::test_io()
+{
+  typedef boost::rat<long long> R;
+  std::ostringstream os;
+  os << R(1, 3) << ' ' << R(-4, 2) << ' ' << R(7) << ' ' << R(0, 0) << ' '
+     << R(5, 0);
+  CPPUNIT_ASSERT( os.str() == "1/3 -2/1 7/1 0/0 5/0" );
+  std::istringstream is(os.str());
+  R a, b, c, d, e;
+  CPPUNIT_ASSERT( is >> a >> b >> c >> d >> e );
+  CPPUNIT_ASSERT( a == R(1, 3) && b == -2 && c == 7 );
+  CPPUNIT_ASSERT( is_NaN(d) && e.num() == 5 && e.denom() == 0 );
+
+  os.str("");
+  os << std::showpos << std::setw(6) << R(1, 3) << '|' << std::noshowpos
+     << std::setw(6) << std::left << R(-1, 3) << '|';
+  CPPUNIT_ASSERT( os.str() == "  +1/3|-1/3  |" );
+
+  // fun::rational keeps the parenthesized format, which also reads back
+  typedef rational<long long> Q;
+  os.str("");
+  os << Q(1, 3) << ' ' << Q(3) << ' ' << Q(-6, 4);
+  CPPUNIT_ASSERT( os.str() == "(1/3) 3 (-3/2)" );
+  std::istringstream iq(os.str());
+  Q x, y, z;
+  CPPUNIT_ASSERT( iq >> x >> y >> z );
+  CPPUNIT_ASSERT( x == Q(1, 3) && y == 3 && z == Q(-3, 2) );
+
+  // a bare integer reads as n/1; malformed text leaves the value alone
+  std::istringstream ib("12 (1/2 x");
+  R f(9), g(9), h(9);
+  CPPUNIT_ASSERT( ib >> f && f == 12 );
+  CPPUNIT_ASSERT( !(ib >> g) && g == 9 );
+  ib.clear();
+  CPPUNIT_ASSERT( !(ib >> h) && h == 9 );
+}
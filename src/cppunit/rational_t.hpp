@@ -0,0 +1,48 @@
+#ifndef CPPUNIT_RATIONAL_T_HPP
+#define CPPUNIT_RATIONAL_T_HPP 1
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <rational.hpp>
+
+/**
+ * A test case for rational (and its normalization policies)
+ */
+class rational_TestCase : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE( rational_TestCase );
+  CPPUNIT_TEST( test_eager );
+  CPPUNIT_TEST( test_lazy );
+  CPPUNIT_TEST( test_never );
+  CPPUNIT_TEST( test_compare );
+  CPPUNIT_TEST( test_extended );
+  CPPUNIT_TEST( test_overflow );
+  CPPUNIT_TEST( test_io );
+  CPPUNIT_TEST_SUITE_END();
+
+protected:
+  /** Test eager normalization */
+  void test_eager();
+
+  /** Test lazy normalization */
+  void test_lazy();
+
+  /** Test no normalization */
+  void test_never();
+
+  /** Test comparison across policies */
+  void test_compare();
+
+  /** Test NaN and infinities */
+  void test_extended();
+
+  /** Test comparison of fractions whose cross products overflow */
+  void test_overflow();
+
+  /** Test that the printed text reads back, in both formats */
+  void test_io();
+};
+
+/** @} */
+
+#endif
@@ -0,0 +1,23 @@
+#ifndef CPPUNIT_TEST_RANDOM_HPP
+#define CPPUNIT_TEST_RANDOM_HPP 1
+
+#include <cstdint>
+
+/**
+ * Reproducible pseudo-random numbers shared by the test cases
+ * (a 64-bit linear congruential generator, Knuth's MMIX constants).
+ */
+
+/// Advance @a seed and return its new value
+inline std::uint64_t random_word(std::uint64_t &seed)
+{
+  return seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+}
+
+/// Return a pseudo-random small integer in [-50, 50]
+inline int random_small(std::uint64_t &seed)
+{
+  return int((random_word(seed) >> 33) % 101) - 50;
+}
+
+#endif
@@ -0,0 +1,200 @@
+#include "vec_t.hpp"
+#include "test_random.hpp"
+#include <cstdint>
+#include <mat.hpp>
+#include <matrix2.hpp>
+#include <matrix3.hpp>
+#include <point4.hpp>
+#include <vector3d.hpp>
+
+using namespace fun;
+
+CPPUNIT_TEST_SUITE_REGISTRATION( vec_TestCase );
+
+namespace {
+
+/// Return a pseudo-random vector with small integral elements
+template <typename _K, std::size_t _N> vec<_K, _N> random_vec(std::uint64_t &seed)
+{
+  vec<_K, _N> v;
+  for (std::size_t i = 0; i != _N; ++i)
+    v[i] = _K(random_small(seed));
+  return v;
+}
+
+/// Check the in-place kernels of vec<K, N> against element-wise arithmetic
+template <typename _K, std::size_t _N> bool check_kernels(std::uint64_t &seed)
+{
+  const vec<_K, _N> v = random_vec<_K, _N>(seed), w = random_vec<_K, _N>(seed);
+  const _K a = _K(random_small(seed) | 1);
+  vec<_K, _N> s = v, d = v, m = v, q = v * a, f = v;
+  s += w;
+  d -= w;
+  m *= a;
+  q /= a;
+  f.add_scaled(a, w);
+  for (std::size_t i = 0; i != _N; ++i) {
+    if (s[i] != _K(v[i] + w[i]) || d[i] != _K(v[i] - w[i]) ||
+        m[i] != _K(v[i] * a) || q[i] != _K(_K(v[i] * a) / a) ||
+        f[i] != _K(v[i] + a * w[i]))
+      return false;
+  }
+  _K r = _K(0);
+  for (std::size_t i = 0; i != _N; ++i)
+    r += v[i] * w[i];
+  return dot(v, w) == r && -(-v) == v && (v + w) - w == v;
+}
+
+template <typename _K> bool check_all(std::uint64_t &seed)
+{
+  return check_kernels<_K, 1>(seed) && check_kernels<_K, 2>(seed) &&
+         check_kernels<_K, 3>(seed) && check_kernels<_K, 4>(seed) &&
+         check_kernels<_K, 5>(seed) && check_kernels<_K, 8>(seed) &&
+         check_kernels<_K, 9>(seed);
+}
+
+/// Return @a A times @a B by the textbook triple loop
+template <typename _K, std::size_t _R, std::size_t _M, std::size_t _C>
+mat<_K, _R, _C> naive_product(const mat<_K, _R, _M> &A,
+                              const mat<_K, _M, _C> &B)
+{
+  mat<_K, _R, _C> P;
+  for (std::size_t i = 0; i != _R; ++i)
+    for (std::size_t j = 0; j != _C; ++j)
+      for (std::size_t k = 0; k != _M; ++k)
+        P(i, j) += A(i, k) * B(k, j);
+  return P;
+}
+
+/// Return the determinant of @a A by cofactor expansion along row 0
+template <typename _K> _K naive_det4(const mat<_K, 4, 4> &A)
+{
+  _K d = _K(0);
+  for (std::size_t j = 0; j != 4; ++j) {
+    mat<_K, 3, 3> M;
+    for (std::size_t r = 1; r != 4; ++r)
+      for (std::size_t c = 0, k = 0; c != 4; ++c)
+        if (c != j)
+          M(r - 1, k++) = A(r, c);
+    d += (j % 2 == 0 ? A(0, j) : -A(0, j)) * M.det();
+  }
+  return d;
+}
+
+} // namespace
+
+void vec_TestCase::test_constexpr()
+{
+  constexpr vec<int, 3> u(1, 2, 3), v(4, 5, 6);
+  static_assert(u + v == vec<int, 3>(5, 7, 9), "");
+  static_assert(v - u == vec<int, 3>(3, 3, 3) && 2 * u == u + u, "");
+  static_assert(dot(u, v) == 32 && quadrance(u) == 14, "");
+  static_assert(cross(u, v) == vec<int, 3>(-3, 6, -3), "");
+  static_assert(det(u, v, cross(u, v)) == quadrance(cross(u, v)), "");
+
+  constexpr vec<double, 3> x = vec<double, 3>(u) / 2.0;
+  static_assert(x[0] == 0.5 && x[2] == 1.5, "SIMD is skipped at compile time");
+
+  constexpr mat<int, 3, 3> A(2, 0, 1, 1, 3, 0, 0, 1, 4);
+  static_assert(A.det() == 25 && (A * A.adj()).det() == 25 * 25 * 25, "");
+  static_assert(A * u == vec<int, 3>(5, 7, 14), "");
+  static_assert(transpose(A)(0, 1) == 1 && transpose(A)(1, 0) == 0, "");
+  constexpr mat<long, 4, 4> B(1, 2, 0, 1, 0, 1, 3, 2, 4, 0, 1, 1, 2, 1, 0, 3);
+  static_assert(B.det() == 58, "Laplace by 2x2 minors");
+  CPPUNIT_ASSERT( naive_det4(B) == 58 );
+}
+
+void vec_TestCase::test_simd()
+{
+  std::uint64_t seed = 1;
+  for (int k = 0; k != 100; ++k) {
+    CPPUNIT_ASSERT( check_all<float>(seed) );
+    CPPUNIT_ASSERT( check_all<double>(seed) );
+    CPPUNIT_ASSERT( check_all<std::int32_t>(seed) );
+    CPPUNIT_ASSERT( check_all<std::uint32_t>(seed) );
+    CPPUNIT_ASSERT( check_all<std::int64_t>(seed) );
+    CPPUNIT_ASSERT( check_all<long double>(seed) );
+  }
+  // the padding lanes stay zero through division
+  vec<double, 3> v(1.0, 2.0, 3.0);
+  v /= 2.0;
+  CPPUNIT_ASSERT( dot(v, v) == 3.5 && (v == vec<double, 3>(0.5, 1.0, 1.5)) );
+  CPPUNIT_ASSERT( reinterpret_cast<std::uintptr_t>(v.data()) %
+                  alignof(vec<double, 3>) == 0 );
+}
+
+void vec_TestCase::test_mat()
+{
+  std::uint64_t seed = 7;
+  for (int k = 0; k != 100; ++k) {
+    mat<double, 3, 3> A, B;
+    mat<std::int64_t, 4, 4> C, D;
+    mat<float, 2, 5> E;
+    mat<float, 5, 3> F;
+    for (std::size_t i = 0; i != 3; ++i)
+      A.row(i) = random_vec<double, 3>(seed), B.row(i) = random_vec<double, 3>(seed);
+    for (std::size_t i = 0; i != 4; ++i)
+      C.row(i) = random_vec<std::int64_t, 4>(seed), D.row(i) = random_vec<std::int64_t, 4>(seed);
+    for (std::size_t i = 0; i != 2; ++i)
+      E.row(i) = random_vec<float, 5>(seed);
+    for (std::size_t i = 0; i != 5; ++i)
+      F.row(i) = random_vec<float, 3>(seed);
+    CPPUNIT_ASSERT( A * B == naive_product(A, B) );
+    CPPUNIT_ASSERT( C * D == naive_product(C, D) );
+    CPPUNIT_ASSERT( E * F == naive_product(E, F) );
+    CPPUNIT_ASSERT( C.det() == naive_det4(C) );
+    CPPUNIT_ASSERT( (C * D).det() == C.det() * D.det() );
+    const mat<double, 3, 3> I(1, 0, 0, 0, 1, 0, 0, 0, 1);
+    CPPUNIT_ASSERT( A * A.adj() == I * A.det() );
+    CPPUNIT_ASSERT( transpose(A * B) == transpose(B) * transpose(A) );
+    CPPUNIT_ASSERT( (A + B) - B == A && -(-A) == A );
+  }
+}
+
+void vec_TestCase::test_wrappers()
+{
+  static_assert(alignof(vector3<double>) >= 16 && alignof(matrix3<float>) >= 16,
+                "aligned storage");
+  constexpr vector3<int> u(1, 2, 3), v(4, 5, 6);
+  constexpr matrix3<int> A(2, 0, 1, 1, 3, 0, 0, 1, 4);
+  static_assert(A * u == vector3<int>(5, 7, 14) && A.adj() * A == A.det() * matrix3<int>(1, 0, 0, 0, 1, 0, 0, 0, 1), "");
+  static_assert(cross(u, v) == vector3<int>(-3, 6, -3) && det(u, v, u) == 0, "");
+  const vector3<double> w = u + vector3<double>(0.5, 0.5, 0.5);
+  CPPUNIT_ASSERT( w == vector3<double>(1.5, 2.5, 3.5) );
+
+  vector3d<double> p(1.0, 2.0, 3.0), q(4.0, 5.0, 6.0);
+  CPPUNIT_ASSERT( p + q == vector3d<double>(5.0, 7.0, 9.0) );
+  CPPUNIT_ASSERT( (p + q) * 2.0 - q == vector3d<double>(6.0, 9.0, 12.0) );
+  CPPUNIT_ASSERT( cross(p, q) == vector3d<double>(-3.0, 6.0, -3.0) );
+
+  const matrix2<int> M(1, 2, 3, 4);
+  const vector2<int> x(1, 0), y(0, 1);
+  CPPUNIT_ASSERT( M.det() == -2 && matrix2<int>(x, y).det() == 1 );
+  CPPUNIT_ASSERT( M + M == M * 2 && -M == M * -1 );
+}
+
+void vec_TestCase::test_point4()
+{
+  const point4<int> o, p(1, 0, 0), q(0, 1, 0), r(0, 0, 1);
+  CPPUNIT_ASSERT( o == point4<int>(0, 0, 0, 1) );
+  const auto h = join(o, p, q); // the plane z = 0
+  CPPUNIT_ASSERT( o.incident(h) && p.incident(h) && q.incident(h) );
+  CPPUNIT_ASSERT( !r.incident(h) );
+  CPPUNIT_ASSERT( coplanar(o, p, q, point4<int>(2, 3, 0)) );
+  CPPUNIT_ASSERT( !coplanar(o, p, q, r) );
+  CPPUNIT_ASSERT( equiv(p, point4<int>(-2, 0, 0, -2)) && !equiv(p, q) );
+
+  // dot(s, join(a, b, c)) is det(s; a; b; c)
+  std::uint64_t seed = 3;
+  for (int k = 0; k != 100; ++k) {
+    const point4<std::int64_t> a = random_vec<std::int64_t, 4>(seed),
+                               b = random_vec<std::int64_t, 4>(seed),
+                               c = random_vec<std::int64_t, 4>(seed),
+                               s = random_vec<std::int64_t, 4>(seed);
+    const mat<std::int64_t, 4, 4> M(s[0], s[1], s[2], s[3], a[0], a[1], a[2],
+                                    a[3], b[0], b[1], b[2], b[3], c[0], c[1],
+                                    c[2], c[3]);
+    CPPUNIT_ASSERT( dot(s.base(), join(a, b, c)) == M.det() );
+    CPPUNIT_ASSERT( coplanar(a, b, c, point4<std::int64_t>(a + b - c)) );
+  }
+}
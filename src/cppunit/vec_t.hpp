@@ -0,0 +1,40 @@
+#ifndef CPPUNIT_VEC_T_HPP
+#define CPPUNIT_VEC_T_HPP 1
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <mat.hpp>
+
+/**
+ * A test case for the generic fixed-size vector and matrix
+ */
+class vec_TestCase : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE( vec_TestCase );
+  CPPUNIT_TEST( test_constexpr );
+  CPPUNIT_TEST( test_simd );
+  CPPUNIT_TEST( test_mat );
+  CPPUNIT_TEST( test_wrappers );
+  CPPUNIT_TEST( test_point4 );
+  CPPUNIT_TEST_SUITE_END();
+
+protected:
+  /** Test that the kernels stay constant expressions */
+  void test_constexpr();
+
+  /** Test the SIMD kernels against the scalar ones */
+  void test_simd();
+
+  /** Test the matrix product, determinant and adjoint */
+  void test_mat();
+
+  /** Test the vector and matrix classes built on vec and mat */
+  void test_wrappers();
+
+  /** Test the points of projective 3-space */
+  void test_point4();
+};
+
+/** @} */
+
+#endif
@@ -19,5 +19,5 @@ conic3<_K>::conic3(const point3<_K>& p1, const point3<_K>& p2,
   matrix3<_K> H { h1, h2 };
   vector3<_K> q = p5;
   matrix3<_K> M = (dot(q,h1)*dot(h2,q)) * G - (dot(q,g1)*dot(g2,q)) * H;
-  A() = M + M.transpose();
+  _Base::operator=(M + M.transpose());
 }